@@ -4,6 +4,10 @@
 #ifndef _POSIX_C_SOURCE
 #define _POSIX_C_SOURCE 200809L
 #endif
+// POSIX alone hides MAP_ANONYMOUS, MAP_HUGETLB, MADV_HUGEPAGE and mincore
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
 #if (__STDC_VERSION__ >= 202311L)
 #define HAS_C23 1
 #define HAS_C17 1
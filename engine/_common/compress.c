@@ -0,0 +1,217 @@
+#include "compress.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_LZ_HASH_BITS 12
+// Matches must start this far before the end (last literals + one match)
+#define DE100_LZ_MATCH_START_LIMIT (DE100_LZ_LAST_LITERALS + 8)
+// Every 2^N misses in a row, stride one byte further (skips incompressible
+// data fast)
+#define DE100_LZ_SKIP_TRIGGER 6
+
+de100_file_scoped_fn inline u32 lz_read32(const u8 *p) {
+  u32 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+de100_file_scoped_fn inline u32 lz_hash(u32 sequence) {
+  return (sequence * 2654435761u) >> (32 - DE100_LZ_HASH_BITS);
+}
+
+/** Write a length extension (the part past 15). false if out of room. */
+de100_file_scoped_fn inline bool lz_write_length(u8 **op, const u8 *op_end,
+                                                 size_t length) {
+  while (length >= 255) {
+    if (*op >= op_end) {
+      return false;
+    }
+    *(*op)++ = 255;
+    length -= 255;
+  }
+  if (*op >= op_end) {
+    return false;
+  }
+  *(*op)++ = (u8)length;
+  return true;
+}
+
+/** Read a length extension. false if the input ends inside it. */
+de100_file_scoped_fn inline bool lz_read_length(const u8 **ip,
+                                                const u8 *ip_end,
+                                                size_t *length) {
+  u8 b;
+  do {
+    if (*ip >= ip_end) {
+      return false;
+    }
+    b = *(*ip)++;
+    *length += b;
+  } while (b == 255);
+  return true;
+}
+
+/** Emit one sequence. match_length == 0 means "final literals only". */
+de100_file_scoped_fn bool lz_emit(u8 **op, const u8 *op_end, const u8 *literals,
+                                  size_t literal_length, size_t offset,
+                                  size_t match_length) {
+  u8 *token = (*op)++;
+  if (*op > op_end) {
+    return false;
+  }
+
+  size_t match_code = match_length ? match_length - DE100_LZ_MIN_MATCH : 0;
+  *token = (u8)(((literal_length < 15 ? literal_length : 15) << 4) |
+                (match_code < 15 ? match_code : 15));
+
+  if (literal_length >= 15 &&
+      !lz_write_length(op, op_end, literal_length - 15)) {
+    return false;
+  }
+  if ((size_t)(op_end - *op) < literal_length) {
+    return false;
+  }
+  memcpy(*op, literals, literal_length);
+  *op += literal_length;
+
+  if (!match_length) {
+    return true;
+  }
+
+  if (op_end - *op < 2) {
+    return false;
+  }
+  (*op)[0] = (u8)(offset & 0xFF);
+  (*op)[1] = (u8)(offset >> 8);
+  *op += 2;
+
+  if (match_code >= 15 && !lz_write_length(op, op_end, match_code - 15)) {
+    return false;
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COMPRESS
+// ═══════════════════════════════════════════════════════════════════════════
+
+size_t de100_lz_compress(const void *src, size_t src_size, void *dst,
+                         size_t dst_capacity) {
+  const u8 *in = (const u8 *)src;
+  u8 *op = (u8 *)dst;
+  const u8 *op_end = op + dst_capacity;
+
+  size_t anchor = 0;
+
+  if (src_size >= DE100_LZ_MATCH_START_LIMIT) {
+    u32 table[1 << DE100_LZ_HASH_BITS];
+    memset(table, 0, sizeof(table));
+
+    size_t match_start_limit = src_size - DE100_LZ_MATCH_START_LIMIT;
+    size_t match_end_limit = src_size - DE100_LZ_LAST_LITERALS;
+    size_t ip = 0;
+    u32 misses = 0;
+
+    while (ip < match_start_limit) {
+      u32 sequence = lz_read32(in + ip);
+      u32 hash = lz_hash(sequence);
+      size_t candidate = table[hash];
+      table[hash] = (u32)ip;
+
+      if (candidate >= ip || ip - candidate > DE100_LZ_MAX_OFFSET ||
+          lz_read32(in + candidate) != sequence) {
+        ip += 1 + (misses++ >> DE100_LZ_SKIP_TRIGGER);
+        continue;
+      }
+      misses = 0;
+
+      size_t length = DE100_LZ_MIN_MATCH;
+      while (ip + length < match_end_limit &&
+             in[candidate + length] == in[ip + length]) {
+        ++length;
+      }
+
+      if (!lz_emit(&op, op_end, in + anchor, ip - anchor, ip - candidate,
+                   length)) {
+        return 0;
+      }
+
+      ip += length;
+      anchor = ip;
+      if (ip < match_start_limit) {
+        // Keep the table warm across the match
+        table[lz_hash(lz_read32(in + ip - 2))] = (u32)(ip - 2);
+      }
+    }
+  }
+
+  if (!lz_emit(&op, op_end, in + anchor, src_size - anchor, 0, 0)) {
+    return 0;
+  }
+  return (size_t)(op - (u8 *)dst);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DECOMPRESS
+// ═══════════════════════════════════════════════════════════════════════════
+
+size_t de100_lz_decompress(const void *src, size_t src_size, void *dst,
+                           size_t dst_capacity) {
+  const u8 *ip = (const u8 *)src;
+  const u8 *ip_end = ip + src_size;
+  u8 *out = (u8 *)dst;
+  size_t op = 0;
+
+  while (ip < ip_end) {
+    u8 token = *ip++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !lz_read_length(&ip, ip_end, &literal_length)) {
+      return 0;
+    }
+    if ((size_t)(ip_end - ip) < literal_length ||
+        dst_capacity - op < literal_length) {
+      return 0;
+    }
+    memcpy(out + op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip == ip_end) {
+      break; // Final sequence
+    }
+
+    if (ip_end - ip < 2) {
+      return 0;
+    }
+    size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+
+    size_t match_length = token & 0x0F;
+    if (match_length == 15 && !lz_read_length(&ip, ip_end, &match_length)) {
+      return 0;
+    }
+    match_length += DE100_LZ_MIN_MATCH;
+
+    if (offset == 0 || offset > op || dst_capacity - op < match_length) {
+      return 0;
+    }
+
+    const u8 *match = out + op - offset;
+    if (offset >= match_length) {
+      memcpy(out + op, match, match_length);
+    } else {
+      // Overlapping copy (runs): must go byte by byte
+      for (size_t i = 0; i < match_length; ++i) {
+        out[op + i] = match[i];
+      }
+    }
+    op += match_length;
+  }
+
+  return op;
+}
@@ -0,0 +1,54 @@
+#ifndef DE100_COMMON_COMPRESS_H
+#define DE100_COMMON_COMPRESS_H
+
+#include "base.h"
+#include <stddef.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🗜️ LZ BLOCK COMPRESSION
+// ═══════════════════════════════════════════════════════════════════════════
+// Small LZ77 byte codec in the LZ4 block layout: speed over ratio, no
+// entropy coding, no dictionary between blocks. Meant for snapshot data
+// (game memory pages), which is mostly zero runs and repeated structs.
+//
+// SEQUENCE:
+//   [token][literal length ext...][literals][offset u16 LE][match length ext...]
+//
+//   token high nibble = literal count (15 = more bytes follow, each added,
+//                       until one is < 255)
+//   token low nibble  = match length - 4 (same extension rule)
+//
+// The last sequence has literals only and ends the block. Matches never
+// reach into the last DE100_LZ_LAST_LITERALS bytes, so the decoder can stop
+// on "input exhausted after literals".
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_LZ_MIN_MATCH 4
+#define DE100_LZ_LAST_LITERALS 5
+#define DE100_LZ_MAX_OFFSET 65535
+
+/** Worst-case compressed size (incompressible input). */
+static inline size_t de100_lz_compress_bound(size_t src_size) {
+  return src_size + src_size / 255 + 16;
+}
+
+/**
+ * Compress `src` into `dst`.
+ *
+ * @return Compressed size, or 0 if it doesn't fit in dst_capacity (callers
+ *         then store the block raw).
+ */
+size_t de100_lz_compress(const void *src, size_t src_size, void *dst,
+                         size_t dst_capacity);
+
+/**
+ * Decompress a whole block.
+ *
+ * @return Bytes written to dst, or 0 if the input is malformed or would
+ *         overflow dst_capacity.
+ */
+size_t de100_lz_decompress(const void *src, size_t src_size, void *dst,
+                           size_t dst_capacity);
+
+#endif // DE100_COMMON_COMPRESS_H
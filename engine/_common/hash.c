@@ -0,0 +1,95 @@
+#include "hash.h"
+
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_HASH_PRIME64_1 0x9E3779B185EBCA87ull
+#define DE100_HASH_PRIME64_2 0xC2B2AE3D27D4EB4Full
+#define DE100_HASH_PRIME64_3 0x165667B19E3779F9ull
+#define DE100_HASH_PRIME64_4 0x85EBCA77C2B2AE63ull
+#define DE100_HASH_PRIME64_5 0x27D4EB2F165667C5ull
+
+de100_file_scoped_fn inline u64 hash_rotl(u64 x, u32 r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+de100_file_scoped_fn inline u64 hash_read64(const u8 *p) {
+  u64 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+de100_file_scoped_fn inline u32 hash_read32(const u8 *p) {
+  u32 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+de100_file_scoped_fn inline u64 hash_round(u64 acc, u64 input) {
+  acc += input * DE100_HASH_PRIME64_2;
+  acc = hash_rotl(acc, 31);
+  return acc * DE100_HASH_PRIME64_1;
+}
+
+de100_file_scoped_fn inline u64 hash_merge_round(u64 acc, u64 lane) {
+  acc ^= hash_round(0, lane);
+  return acc * DE100_HASH_PRIME64_1 + DE100_HASH_PRIME64_4;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HASH
+// ═══════════════════════════════════════════════════════════════════════════
+
+u64 de100_hash64(const void *data, size_t size, u64 seed) {
+  const u8 *p = (const u8 *)data;
+  const u8 *end = p + size;
+  u64 h;
+
+  if (size >= 32) {
+    u64 v1 = seed + DE100_HASH_PRIME64_1 + DE100_HASH_PRIME64_2;
+    u64 v2 = seed + DE100_HASH_PRIME64_2;
+    u64 v3 = seed;
+    u64 v4 = seed - DE100_HASH_PRIME64_1;
+
+    const u8 *stripe_end = end - 32;
+    do {
+      v1 = hash_round(v1, hash_read64(p));
+      v2 = hash_round(v2, hash_read64(p + 8));
+      v3 = hash_round(v3, hash_read64(p + 16));
+      v4 = hash_round(v4, hash_read64(p + 24));
+      p += 32;
+    } while (p <= stripe_end);
+
+    h = hash_rotl(v1, 1) + hash_rotl(v2, 7) + hash_rotl(v3, 12) +
+        hash_rotl(v4, 18);
+    h = hash_merge_round(h, v1);
+    h = hash_merge_round(h, v2);
+    h = hash_merge_round(h, v3);
+    h = hash_merge_round(h, v4);
+  } else {
+    h = seed + DE100_HASH_PRIME64_5;
+  }
+
+  h += (u64)size;
+
+  while (end - p >= 8) {
+    h ^= hash_round(0, hash_read64(p));
+    h = hash_rotl(h, 27) * DE100_HASH_PRIME64_1 + DE100_HASH_PRIME64_4;
+    p += 8;
+  }
+  if (end - p >= 4) {
+    h ^= (u64)hash_read32(p) * DE100_HASH_PRIME64_1;
+    h = hash_rotl(h, 23) * DE100_HASH_PRIME64_2 + DE100_HASH_PRIME64_3;
+    p += 4;
+  }
+  while (p < end) {
+    h ^= (u64)(*p) * DE100_HASH_PRIME64_5;
+    h = hash_rotl(h, 11) * DE100_HASH_PRIME64_1;
+    ++p;
+  }
+
+  return de100_hash64_mix(h);
+}
@@ -0,0 +1,29 @@
+#ifndef DE100_COMMON_HASH_H
+#define DE100_COMMON_HASH_H
+
+#include "base.h"
+#include <stddef.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// #️⃣ FAST NON-CRYPTOGRAPHIC HASH
+// ═══════════════════════════════════════════════════════════════════════════
+// XXH64 (same output as the reference xxHash64): four independent 64-bit
+// lanes over 32-byte stripes, so it runs at memory speed on large blocks.
+// For change detection and fingerprints (determinism checks, layout IDs),
+// never for anything an attacker controls.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+u64 de100_hash64(const void *data, size_t size, u64 seed);
+
+/** Scramble a 64-bit value (XXH64's avalanche step). */
+static inline u64 de100_hash64_mix(u64 h) {
+  h ^= h >> 33;
+  h *= 0xC2B2AE3D27D4EB4Full;
+  h ^= h >> 29;
+  h *= 0x165667B19E3779F9ull;
+  h ^= h >> 32;
+  return h;
+}
+
+#endif // DE100_COMMON_HASH_H
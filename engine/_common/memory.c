@@ -48,6 +48,29 @@ size_t de100_memory_page_size(void) {
   return g_page_size;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// PROCESS-WIDE STATS
+// ═══════════════════════════════════════════════════════════════════════════
+// Only touched from the thread that allocates (the main thread today).
+
+de100_file_scoped_global_var De100MemoryStats g_memory_stats = {0};
+
+de100_file_scoped_fn inline void memory_stats_on_commit(size_t bytes) {
+  g_memory_stats.committed_bytes += bytes;
+  if (g_memory_stats.committed_bytes > g_memory_stats.peak_committed_bytes) {
+    g_memory_stats.peak_committed_bytes = g_memory_stats.committed_bytes;
+  }
+}
+
+de100_file_scoped_fn inline void memory_stats_on_release(size_t reserved,
+                                                         size_t committed) {
+  g_memory_stats.reserved_bytes -= reserved;
+  g_memory_stats.committed_bytes -= committed;
+  g_memory_stats.block_count--;
+}
+
+De100MemoryStats de100_memory_get_stats(void) { return g_memory_stats; }
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ERROR MESSAGES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -77,6 +100,18 @@ const char *de100_memory_error_str(De100MemoryError error) {
   return "Unknown error";
 }
 
+const char *de100_memory_page_mode_str(De100MemoryPageMode mode) {
+  switch (mode) {
+  case De100_MEMORY_PAGE_MODE_NORMAL:
+    return "normal";
+  case De100_MEMORY_PAGE_MODE_HUGETLB:
+    return "hugetlb";
+  case De100_MEMORY_PAGE_MODE_TRANSPARENT:
+    return "thp";
+  }
+  return "unknown";
+}
+
 // #if DE100_INTERNAL && DE100_SLOW
 de100_file_scoped_global_var const char *g_de100_memory_error_details[] = {
     [De100_MEMORY_OK] = "Operation completed successfully.",
@@ -306,6 +341,24 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
     return result;
   }
 
+#if defined(__linux__)
+  // Huge pages need the usable region sized and aligned to the huge page.
+  // BASE_FIXED can't be moved to honour the alignment, so it only gets the
+  // THP hint (the kernel still backs any aligned 2MB run inside it).
+  bool want_large_pages = (flags & De100_MEMORY_FLAG_LARGE_PAGES) &&
+                          !(flags & De100_MEMORY_FLAG_BASE_FIXED);
+  size_t large_page_size = DE100_MEMORY_LARGE_PAGE_SIZE;
+  if (want_large_pages) {
+    aligned_size = (size + large_page_size - 1) & ~(large_page_size - 1);
+    total_size = aligned_size + (2 * page_size);
+    if (aligned_size < size || total_size < aligned_size ||
+        total_size + large_page_size < total_size) {
+      result.error_code = De100_MEMORY_ERR_SIZE_OVERFLOW;
+      return result;
+    }
+  }
+#endif
+
 #if defined(_WIN32)
   // ═════════════════════════════════════════════════════════════════════
   // WINDOWS
@@ -332,21 +385,28 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
 
   // Commit usable region (skip first guard page)
   void *usable = (u8 *)reserved + page_size;
-  DWORD protect = win32_protection_flags(flags);
 
-  void *committed = VirtualAlloc(usable, aligned_size, MEM_COMMIT, protect);
-  if (!committed) {
-    result.error_code = win32_error_to_de100_memory_error(GetLastError());
-    VirtualFree(reserved, 0, MEM_RELEASE);
-    return result;
-  }
+  if (flags & De100_MEMORY_FLAG_RESERVE_ONLY) {
+    // Pages get committed later by de100_memory_commit()
+    result.base = usable;
+  } else {
+    DWORD protect = win32_protection_flags(flags);
 
-  // Zero if requested (VirtualAlloc already zeros, but be explicit)
-  if (flags & De100_MEMORY_FLAG_ZEROED) {
-    ZeroMemory(committed, aligned_size);
-  }
+    void *committed = VirtualAlloc(usable, aligned_size, MEM_COMMIT, protect);
+    if (!committed) {
+      result.error_code = win32_error_to_de100_memory_error(GetLastError());
+      VirtualFree(reserved, 0, MEM_RELEASE);
+      return result;
+    }
+
+    // Zero if requested (VirtualAlloc already zeros, but be explicit)
+    if (flags & De100_MEMORY_FLAG_ZEROED) {
+      ZeroMemory(committed, aligned_size);
+    }
 
-  result.base = committed;
+    result.base = committed;
+    result.committed_size = aligned_size;
+  }
 
 #elif defined(DE100_IS_GENERIC_POSIX)
   // ═════════════════════════════════════════════════════════════════════
@@ -358,30 +418,121 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
     mmap_flags |= MAP_FIXED;
   }
 
-  // Reserve entire range with no access (guard pages)
-  void *reserved = mmap(base_hint, total_size, PROT_NONE, mmap_flags, -1, 0);
+  void *reserved = NULL;
+
+#if defined(__linux__)
+  if (want_large_pages) {
+    // ─────────────────────────────────────────────────────────────────
+    // Over-reserve by one huge page, then trim so that `usable` lands on
+    // a huge page boundary while keeping the one-guard-page layout that
+    // free()/realloc() rely on:
+    //
+    //   raw ─┬─ head slack ─┬ guard ┬ usable (2MB aligned) ┬ guard ┬ tail ┐
+    //        └──── munmap ──┘                                      └munmap┘
+    // ─────────────────────────────────────────────────────────────────
+    void *hint = base_hint;
+    if (hint) {
+      uintptr_t wanted_usable =
+          ((uintptr_t)hint + page_size + large_page_size - 1) &
+          ~((uintptr_t)large_page_size - 1);
+      hint = (void *)(wanted_usable - page_size);
+    }
 
-  if (reserved == MAP_FAILED) {
-    result.error_code = posix_error_to_de100_memory_error(errno);
-    return result;
+    size_t raw_size = total_size + large_page_size;
+    u8 *raw = (u8 *)mmap(hint, raw_size, PROT_NONE, mmap_flags, -1, 0);
+    if (raw == MAP_FAILED) {
+      result.error_code = posix_error_to_de100_memory_error(errno);
+      return result;
+    }
+
+    u8 *aligned_usable =
+        (u8 *)(((uintptr_t)raw + page_size + large_page_size - 1) &
+               ~((uintptr_t)large_page_size - 1));
+    u8 *aligned_reserved = aligned_usable - page_size;
+    size_t head = (size_t)(aligned_reserved - raw);
+    size_t tail = raw_size - head - total_size;
+    if (head) {
+      munmap(raw, head);
+    }
+    if (tail) {
+      munmap(aligned_reserved + total_size, tail);
+    }
+    reserved = aligned_reserved;
+  }
+#endif
+
+  if (!reserved) {
+    // Reserve entire range with no access (guard pages)
+    reserved = mmap(base_hint, total_size, PROT_NONE, mmap_flags, -1, 0);
+
+    if (reserved == MAP_FAILED) {
+      result.error_code = posix_error_to_de100_memory_error(errno);
+      return result;
+    }
   }
 
   // Set protection on usable region (skip first guard page)
   void *usable = (u8 *)reserved + page_size;
-  int prot = posix_protection_flags(flags);
 
-  if (mprotect(usable, aligned_size, prot) != 0) {
-    result.error_code = posix_error_to_de100_memory_error(errno);
-    munmap(reserved, total_size);
-    return result;
+  // RESERVE_ONLY: leave everything PROT_NONE, de100_memory_commit() opens
+  // the prefix up as it's needed.
+  size_t committed_size = 0;
+  De100MemoryPageMode page_mode = De100_MEMORY_PAGE_MODE_NORMAL;
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+  // MAP_HUGETLB commits the whole range out of the hugetlbfs pool up front,
+  // which defeats RESERVE_ONLY, so those blocks go straight to THP.
+  if (want_large_pages && !(flags & De100_MEMORY_FLAG_RESERVE_ONLY)) {
+    void *huge = mmap(usable, aligned_size, posix_protection_flags(flags),
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB,
+                      -1, 0);
+    if (huge != MAP_FAILED) {
+      committed_size = aligned_size;
+      page_mode = De100_MEMORY_PAGE_MODE_HUGETLB;
+    } else {
+      // Pool empty/disabled (the common case). MAP_FIXED may have dropped
+      // the PROT_NONE reservation; put it back before falling through.
+      if (mmap(usable, aligned_size, PROT_NONE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1,
+               0) == MAP_FAILED) {
+        result.error_code = posix_error_to_de100_memory_error(errno);
+        munmap(reserved, total_size);
+        return result;
+      }
+    }
+  }
+#endif
+
+  if (!(flags & De100_MEMORY_FLAG_RESERVE_ONLY) &&
+      page_mode == De100_MEMORY_PAGE_MODE_NORMAL) {
+    int prot = posix_protection_flags(flags);
+
+    if (mprotect(usable, aligned_size, prot) != 0) {
+      result.error_code = posix_error_to_de100_memory_error(errno);
+      munmap(reserved, total_size);
+      return result;
+    }
+    committed_size = aligned_size;
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Transparent huge pages: best-effort, kernel decides per 2MB run. The
+  // advice sticks to the VMA, so later de100_memory_commit() calls on a
+  // RESERVE_ONLY block inherit it.
+  if ((flags & De100_MEMORY_FLAG_LARGE_PAGES) &&
+      page_mode == De100_MEMORY_PAGE_MODE_NORMAL) {
+    if (madvise(usable, aligned_size, MADV_HUGEPAGE) == 0) {
+      page_mode = De100_MEMORY_PAGE_MODE_TRANSPARENT;
+    }
   }
+#endif
 
   // Note: mmap with MAP_ANONYMOUS guarantees zero-initialized pages
   // No explicit zeroing needed
 
 #if DE100_INTERNAL && DE100_SLOW
   // Verify zero-initialization in dev builds
-  if (flags & De100_MEMORY_FLAG_ZEROED) {
+  if ((flags & De100_MEMORY_FLAG_ZEROED) && committed_size) {
     u8 *p = (u8 *)usable;
     size_t check_offsets[] = {0, aligned_size / 4, aligned_size / 2,
                               3 * aligned_size / 4, aligned_size - 1};
@@ -394,6 +545,8 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
 #endif
 
   result.base = usable;
+  result.committed_size = committed_size;
+  result.page_mode = page_mode;
 
 #endif
 
@@ -407,9 +560,64 @@ De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
   result.error_code = De100_MEMORY_OK;
   result.is_valid = true;
 
+  g_memory_stats.reserved_bytes += aligned_size;
+  g_memory_stats.block_count++;
+  memory_stats_on_commit(result.committed_size);
+
   return result;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// COMMIT (Grow the accessible prefix of a RESERVE_ONLY block)
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100MemoryError de100_memory_commit(De100MemoryBlock *block,
+                                     size_t min_committed) {
+  if (!block) {
+    return De100_MEMORY_ERR_NULL_BLOCK;
+  }
+
+  if (!block->base || !block->is_valid) {
+    return De100_MEMORY_ERR_INVALID_BLOCK;
+  }
+
+  if (min_committed > block->size) {
+    return De100_MEMORY_ERR_INVALID_SIZE;
+  }
+
+  if (min_committed <= block->committed_size) {
+    return De100_MEMORY_OK;
+  }
+
+  // Round up to the commit chunk, clamp to the reservation
+  size_t chunk = DE100_MEMORY_COMMIT_CHUNK_SIZE;
+  size_t target = ((min_committed + chunk - 1) / chunk) * chunk;
+  if (target > block->size || target < min_committed) {
+    target = block->size;
+  }
+
+  u8 *start = (u8 *)block->base + block->committed_size;
+  size_t grow = target - block->committed_size;
+
+#if defined(_WIN32)
+  DWORD protect = win32_protection_flags(block->flags);
+  if (!VirtualAlloc(start, grow, MEM_COMMIT, protect)) {
+    return win32_error_to_de100_memory_error(GetLastError());
+  }
+#elif defined(DE100_IS_GENERIC_POSIX)
+  // Fresh anonymous pages read as zero, so ZEROED needs no extra work.
+  if (mprotect(start, grow, posix_protection_flags(block->flags)) != 0) {
+    return posix_error_to_de100_memory_error(errno);
+  }
+#endif
+
+  block->committed_size = target;
+  g_memory_stats.commit_calls++;
+  memory_stats_on_commit(grow);
+
+  return De100_MEMORY_OK;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // RESET (Zero existing block without reallocating)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -423,7 +631,7 @@ De100MemoryError de100_memory_reset(De100MemoryBlock *block) {
     return De100_MEMORY_ERR_INVALID_BLOCK;
   }
 
-  de100_mem_set(block->base, 0, block->size);
+  de100_mem_set(block->base, 0, block->committed_size);
 
   return De100_MEMORY_OK;
 }
@@ -458,6 +666,8 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
     block->base = new_block.base;
     block->size = new_block.size;
     block->total_size = new_block.total_size;
+    block->committed_size = new_block.committed_size;
+    block->page_mode = new_block.page_mode;
     block->flags = new_block.flags;
     block->error_code = new_block.error_code;
     block->is_valid = new_block.is_valid;
@@ -483,7 +693,7 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
   // ─────────────────────────────────────────────────────────────────────
   if (new_aligned == old_aligned) {
     if (!preserve_data) {
-      de100_mem_set(block->base, 0, block->size);
+      de100_mem_set(block->base, 0, block->committed_size);
     }
     block->error_code = De100_MEMORY_OK;
     return De100_MEMORY_OK;
@@ -497,7 +707,9 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
   void *old_base = block->base;
   size_t old_size = block->size;
   size_t old_total_size = block->total_size;
-  size_t copy_size = (old_size < new_aligned) ? old_size : new_aligned;
+  size_t old_committed_size = block->committed_size;
+  size_t copy_size =
+      (old_committed_size < new_aligned) ? old_committed_size : new_aligned;
 
   // Allocate new memory
   De100MemoryBlock new_block = de100_memory_alloc(NULL, new_size, block->flags);
@@ -509,12 +721,19 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
 
   // Copy old data if requested
   if (preserve_data && old_base) {
+    // RESERVE_ONLY blocks keep their committed prefix across the move
+    if (de100_memory_commit(&new_block, copy_size) != De100_MEMORY_OK) {
+      block->error_code = De100_MEMORY_ERR_OUT_OF_MEMORY;
+      de100_memory_free(&new_block);
+      return De100_MEMORY_ERR_OUT_OF_MEMORY;
+    }
+
     de100_mem_copy(new_block.base, old_base, copy_size);
 
     // Zero extra space if we grew
-    if (new_block.size > old_size) {
+    if (new_block.committed_size > old_size) {
       de100_mem_set((u8 *)new_block.base + old_size, 0,
-                    new_block.size - old_size);
+                    new_block.committed_size - old_size);
     }
   }
 
@@ -527,11 +746,14 @@ De100MemoryError de100_memory_realloc(De100MemoryBlock *block, size_t new_size,
 #elif defined(DE100_IS_GENERIC_POSIX)
   munmap(old_reserved_base, old_total_size);
 #endif
+  memory_stats_on_release(old_size, old_committed_size);
 
   // Update struct fields in place (pointer to block stays valid!)
   block->base = new_block.base;
   block->size = new_block.size;
   block->total_size = new_block.total_size;
+  block->committed_size = new_block.committed_size;
+  block->page_mode = new_block.page_mode;
   // block->flags stays the same
   block->error_code = De100_MEMORY_OK;
   block->is_valid = true;
@@ -588,6 +810,8 @@ De100MemoryError de100_memory_free(De100MemoryBlock *block) {
   }
 #endif
 
+  memory_stats_on_release(block->size, block->committed_size);
+
   // ─────────────────────────────────────────────────────────────────────
   // Clear block
   // ─────────────────────────────────────────────────────────────────────
@@ -595,6 +819,7 @@ De100MemoryError de100_memory_free(De100MemoryBlock *block) {
   block->base = NULL;
   block->size = 0;
   block->total_size = 0;
+  block->committed_size = 0;
   block->is_valid = false;
   block->error_code = De100_MEMORY_OK;
 
@@ -610,6 +835,51 @@ bool de100_memory_is_valid(De100MemoryBlock block) {
          block.error_code == De100_MEMORY_OK;
 }
 
+bool de100_memory_query_resident(const void *base, size_t size,
+                                 size_t *out_resident) {
+  *out_resident = 0;
+  if (!base || size == 0) {
+    return true;
+  }
+
+#if defined(_WIN32)
+  return false;
+#else
+  size_t page_size = de100_memory_page_size();
+  uintptr_t start = (uintptr_t)base & ~(uintptr_t)(page_size - 1);
+  uintptr_t end = ((uintptr_t)base + size + page_size - 1) &
+                  ~(uintptr_t)(page_size - 1);
+
+  // One byte per page; walk in batches so a 4 GB reservation doesn't need
+  // a megabyte of vector
+#if defined(__linux__)
+  unsigned char vec[4096];
+#else
+  char vec[4096];
+#endif
+  size_t resident_pages = 0;
+
+  for (uintptr_t cursor = start; cursor < end;) {
+    size_t pages = (end - cursor) / page_size;
+    if (pages > sizeof(vec)) {
+      pages = sizeof(vec);
+    }
+
+    if (mincore((void *)cursor, pages * page_size, vec) != 0) {
+      // ENOMEM: part of the range isn't mapped (e.g. guard pages)
+      return false;
+    }
+    for (size_t i = 0; i < pages; ++i) {
+      resident_pages += vec[i] & 1;
+    }
+    cursor += pages * page_size;
+  }
+
+  *out_resident = resident_pages * page_size;
+  return true;
+#endif
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // MEMORY OPERATIONS
 // ═══════════════════════════════════════════════════════════════════════════
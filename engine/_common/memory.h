@@ -58,8 +58,15 @@ typedef enum {
   De100_MEMORY_FLAG_BASE_FIXED = 1 << 5, // Must use exact base address
 
   // Optimization hints (best-effort)
+  // Linux: MAP_HUGETLB, falling back to madvise(MADV_HUGEPAGE).
+  // Check block.page_mode for what was actually obtained.
   De100_MEMORY_FLAG_LARGE_PAGES = 1 << 6,
   De100_MEMORY_FLAG_TRANSIENT = 1 << 7,
+
+  // Commit strategy
+  // Reserve address space only (PROT_NONE / MEM_RESERVE). Nothing is
+  // accessible until de100_memory_commit() grows the committed prefix.
+  De100_MEMORY_FLAG_RESERVE_ONLY = 1 << 8,
 } De100MemoryFlags;
 
 // Common flag combinations
@@ -69,6 +76,28 @@ typedef enum {
 #define De100_MEMORY_FLAG_RW_ZEROED                                            \
   (De100_MEMORY_FLAG_RW | De100_MEMORY_FLAG_ZEROED)
 
+// Huge page size assumed for De100_MEMORY_FLAG_LARGE_PAGES (x86-64/arm64
+// default). LARGE_PAGES blocks are rounded up to a multiple of it.
+#ifndef DE100_MEMORY_LARGE_PAGE_SIZE
+#define DE100_MEMORY_LARGE_PAGE_SIZE MEGABYTES(2)
+#endif
+
+// Granularity of de100_memory_commit() for RESERVE_ONLY blocks. Committing in
+// chunks keeps the mprotect/VirtualAlloc calls rare while an arena grows.
+#ifndef DE100_MEMORY_COMMIT_CHUNK_SIZE
+#define DE100_MEMORY_COMMIT_CHUNK_SIZE MEGABYTES(2)
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PAGE MODE (What De100_MEMORY_FLAG_LARGE_PAGES actually got)
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  De100_MEMORY_PAGE_MODE_NORMAL = 0, // Base pages (hint not given or refused)
+  De100_MEMORY_PAGE_MODE_HUGETLB,    // MAP_HUGETLB (pre-reserved huge pages)
+  De100_MEMORY_PAGE_MODE_TRANSPARENT, // madvise(MADV_HUGEPAGE), kernel THP
+} De100MemoryPageMode;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // MEMORY BLOCK
 // ═══════════════════════════════════════════════════════════════════════════
@@ -77,7 +106,9 @@ typedef struct {
   void *base;                  // Pointer to usable memory (after guard page)
   size_t size;                 // Usable size (page-aligned)
   size_t total_size;           // Total size including guard pages
+  size_t committed_size;       // Accessible prefix of [base, base + size)
   De100MemoryFlags flags;      // Flags used for allocation
+  De100MemoryPageMode page_mode; // Page backing actually obtained
   De100MemoryError error_code; // Error code (De100_MEMORY_OK if valid)
   u32 generation; // Incremented on each realloc to detect stale refs
   bool is_valid;  // Quick validity check
@@ -102,6 +133,22 @@ typedef struct {
 De100MemoryBlock de100_memory_alloc(void *base_hint, size_t size,
                                     De100MemoryFlags flags);
 
+/**
+ * Grow the committed (accessible) prefix of a block.
+ *
+ * @param block          Block allocated with De100_MEMORY_FLAG_RESERVE_ONLY
+ * @param min_committed  Bytes from block->base that must be accessible
+ * @return               De100_MEMORY_OK on success, error code otherwise
+ *
+ * Rounds up to DE100_MEMORY_COMMIT_CHUNK_SIZE (clamped to block->size).
+ * Never shrinks. No-op for fully committed (non RESERVE_ONLY) blocks.
+ *
+ *   [Guard][committed ......|reserved (PROT_NONE) ..........][Guard]
+ *          └ base           └ base + committed_size         └ base + size
+ */
+De100MemoryError de100_memory_commit(De100MemoryBlock *block,
+                                     size_t min_committed);
+
 /**
  * @brief Zero an existing memory block without reallocating.
  *
@@ -145,9 +192,40 @@ size_t de100_memory_page_size(void);
 /** Check if block is valid and usable. */
 bool de100_memory_is_valid(De100MemoryBlock block);
 
+/**
+ * Bytes of [base, base + size) currently backed by physical memory (or, for
+ * file mappings, in the page cache), via mincore(). Untouched committed pages
+ * don't count, so this is what the game actually uses.
+ *
+ * @return false when unsupported (Windows) or the range isn't fully mapped
+ */
+bool de100_memory_query_resident(const void *base, size_t size,
+                                 size_t *out_resident);
+
 /** Get human-readable error message. */
 const char *de100_memory_error_str(De100MemoryError error);
 
+/** "normal", "hugetlb" or "thp". */
+const char *de100_memory_page_mode_str(De100MemoryPageMode mode);
+
+/**
+ * Process-wide counters for blocks created by de100_memory_alloc().
+ *
+ * reserved_bytes counts usable address space (guard pages excluded);
+ * committed_bytes counts the part of it that is accessible. With
+ * RESERVE_ONLY blocks the gap between the two is address space the game has
+ * not grown into yet.
+ */
+typedef struct {
+  u64 reserved_bytes;
+  u64 committed_bytes;
+  u64 peak_committed_bytes;
+  u32 block_count;
+  u32 commit_calls; // de100_memory_commit() calls that actually committed
+} De100MemoryStats;
+
+De100MemoryStats de100_memory_get_stats(void);
+
 // #if DE100_INTERNAL && DE100_SLOW
 /** Get detailed error message with context (dev builds only). */
 const char *de100_memory_error_str_detailed(De100MemoryError error);
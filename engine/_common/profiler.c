@@ -0,0 +1,484 @@
+#include "profiler.h"
+
+#if DE100_INTERNAL
+
+#include "time.h"
+
+#include <stdio.h>
+#include <string.h>
+
+De100Profiler *g_de100_profiler = NULL;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIFECYCLE
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool de100_profiler_init(De100Profiler *profiler) {
+  *profiler = (De100Profiler){0};
+
+  u64 events_size = (u64)DE100_PROFILER_MAX_THREADS *
+                    DE100_PROFILER_THREAD_EVENTS * sizeof(De100ProfileEvent);
+  u64 frames_size =
+      (u64)DE100_PROFILER_FRAME_COUNT * sizeof(De100ProfileFrame);
+
+  // Untouched rings (threads that never time anything) stay unbacked
+  profiler->storage = de100_memory_alloc(NULL, (size_t)(events_size + frames_size),
+                                         De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(profiler->storage)) {
+    return false;
+  }
+
+  u8 *base = (u8 *)profiler->storage.base;
+  for (u32 i = 0; i < DE100_PROFILER_MAX_THREADS; ++i) {
+    profiler->threads[i].events =
+        (De100ProfileEvent *)(base + (u64)i * DE100_PROFILER_THREAD_EVENTS *
+                                         sizeof(De100ProfileEvent));
+  }
+  profiler->frames = (De100ProfileFrame *)(base + events_size);
+  profiler->frame_begin_tsc = de100_profiler_tsc();
+
+  profiler->is_initialized = true;
+  g_de100_profiler = profiler;
+  return true;
+}
+
+void de100_profiler_shutdown(De100Profiler *profiler) {
+  if (!profiler->is_initialized) {
+    return;
+  }
+  de100_profiler_trace_end(profiler);
+  if (g_de100_profiler == profiler) {
+    g_de100_profiler = NULL;
+  }
+  profiler->is_initialized = false;
+  de100_memory_free(&profiler->storage);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CALL TREE
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * The node for `site` under `parent` (NO_NODE = a root of `thread_index`),
+ * added on first use. NO_NODE when the frame is out of nodes.
+ */
+de100_file_scoped_fn u32 find_or_add_node(De100ProfileFrame *frame,
+                                          u32 thread_index, u32 parent,
+                                          const De100ProfileSite *site,
+                                          u32 depth) {
+  if (depth > 0 && parent == DE100_PROFILER_NO_NODE) {
+    return DE100_PROFILER_NO_NODE; // Parent didn't fit
+  }
+
+  u32 *link = parent == DE100_PROFILER_NO_NODE
+                  ? &frame->first_root
+                  : &frame->nodes[parent].first_child;
+  while (*link != DE100_PROFILER_NO_NODE) {
+    De100ProfileNode *node = &frame->nodes[*link];
+    if (node->site == site && node->thread_index == thread_index) {
+      return *link;
+    }
+    link = &node->next_sibling;
+  }
+
+  if (frame->node_count == DE100_PROFILER_MAX_NODES) {
+    return DE100_PROFILER_NO_NODE;
+  }
+
+  u32 index = frame->node_count++;
+  De100ProfileNode *node = &frame->nodes[index];
+  *node = (De100ProfileNode){0};
+  strncpy(node->name, site->name, sizeof(node->name) - 1);
+  node->line = site->line;
+  node->thread_index = thread_index;
+  node->depth = depth;
+  node->parent = parent;
+  node->first_child = DE100_PROFILER_NO_NODE;
+  node->next_sibling = DE100_PROFILER_NO_NODE;
+  node->site = site;
+  *link = index;
+  return index;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TRACE CAPTURE
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Index of `site` in the capture's name table, added on first use. */
+de100_file_scoped_fn u16 trace_name(De100ProfileTrace *trace,
+                                    const De100ProfileSite *site) {
+  u32 slot = (u32)(((uintptr_t)site >> 3) & (DE100_PROFILER_TRACE_NAMES - 1));
+  for (;;) {
+    De100ProfileTraceName *name = &trace->names[slot];
+    if (name->site == site) {
+      return (u16)slot;
+    }
+    if (!name->site) {
+      // Keep one slot empty so lookups of known sites still terminate
+      if (trace->name_count == DE100_PROFILER_TRACE_NAMES - 1) {
+        return DE100_PROFILER_TRACE_OTHER_NAME;
+      }
+      name->site = site;
+      strncpy(name->name, site->name, sizeof(name->name) - 1);
+      trace->name_count++;
+      return (u16)slot;
+    }
+    slot = (slot + 1) & (DE100_PROFILER_TRACE_NAMES - 1);
+  }
+}
+
+de100_file_scoped_fn void trace_push(De100ProfileTrace *trace, u64 tsc,
+                                     const De100ProfileSite *site,
+                                     u32 thread_index) {
+  // Room is checked per frame before draining (see trace_frame_fits)
+  De100ProfileTraceEvent *event = &trace->events[trace->event_count++];
+  event->tsc = tsc;
+  event->thread_index = (u8)thread_index;
+  event->is_end = site ? 0 : 1;
+  event->name = site ? trace_name(trace, site) : 0;
+}
+
+/**
+ * Whether this frame's events fit: `pending` new ones, plus the begins
+ * and ends of blocks left open on either side of the capture.
+ */
+de100_file_scoped_fn bool trace_frame_fits(const De100ProfileTrace *trace,
+                                           u64 pending) {
+  u64 reserve = 2ull * DE100_PROFILER_MAX_THREADS * DE100_PROFILER_MAX_DEPTH;
+  return trace->event_count + pending + reserve <=
+             DE100_PROFILER_TRACE_EVENTS &&
+         trace->frame_count < DE100_PROFILER_TRACE_MAX_FRAMES;
+}
+
+de100_file_scoped_fn void trace_write_name(FILE *file, const char *name) {
+  fputc('"', file);
+  for (; *name; ++name) {
+    if (*name == '"' || *name == '\\') {
+      fputc('\\', file);
+    }
+    if ((u8)*name >= 0x20) {
+      fputc(*name, file);
+    }
+  }
+  fputc('"', file);
+}
+
+de100_file_scoped_fn bool trace_write(const De100Profiler *profiler,
+                                      u64 end_tsc, f64 end_seconds) {
+  const De100ProfileTrace *trace = &profiler->trace;
+  FILE *file = fopen(trace->path, "wb");
+  if (!file) {
+    return false;
+  }
+
+  f64 seconds = end_seconds - trace->calibration_seconds;
+  f64 us_per_tick =
+      end_tsc > trace->calibration_tsc && seconds > 0.0
+          ? seconds * 1e6 / (f64)(end_tsc - trace->calibration_tsc)
+          : 0.0;
+  // Ticks before the capture began (open blocks) land at negative times
+#define TRACE_US(tsc) (((f64)(i64)((tsc) - trace->begin_tsc)) * us_per_tick)
+
+  const u32 frames_tid = DE100_PROFILER_MAX_THREADS;
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(file,
+          "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+          "\"args\":{\"name\":\"frames\"}}",
+          frames_tid);
+  for (u32 i = 0; i < DE100_PROFILER_MAX_THREADS; ++i) {
+    if (__atomic_load_n(&profiler->threads[i].owner, __ATOMIC_ACQUIRE) != 0) {
+      fprintf(file,
+              ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":"
+              "\"thread_name\",\"args\":{\"name\":\"thread %u\"}}",
+              i, i);
+    }
+  }
+
+  for (u32 i = 0; i < trace->frame_count; ++i) {
+    const De100ProfileTraceFrame *frame = &trace->frames[i];
+    fprintf(file,
+            ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"name\":\"frame %u\","
+            "\"ts\":%.3f,\"dur\":%.3f}",
+            frames_tid, frame->frame_index, TRACE_US(frame->begin_tsc),
+            (f64)(frame->end_tsc - frame->begin_tsc) * us_per_tick);
+  }
+
+  for (u32 i = 0; i < trace->event_count; ++i) {
+    const De100ProfileTraceEvent *event = &trace->events[i];
+    if (event->is_end) {
+      fprintf(file, ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+              event->thread_index, TRACE_US(event->tsc));
+    } else {
+      fprintf(file, ",\n{\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                    "\"name\":",
+              event->thread_index, TRACE_US(event->tsc));
+      trace_write_name(file, event->name == DE100_PROFILER_TRACE_OTHER_NAME
+                                 ? "(other)"
+                                 : trace->names[event->name].name);
+      fputc('}', file);
+    }
+  }
+#undef TRACE_US
+
+  fprintf(file, "\n]}\n");
+  bool ok = !ferror(file);
+  return fclose(file) == 0 && ok;
+}
+
+bool de100_profiler_trace_begin(De100Profiler *profiler, u32 frame_count,
+                                const char *path) {
+  De100ProfileTrace *trace = &profiler->trace;
+  if (!profiler->is_initialized || trace->is_capturing || frame_count == 0) {
+    return false;
+  }
+
+  u64 events_size =
+      (u64)DE100_PROFILER_TRACE_EVENTS * sizeof(De100ProfileTraceEvent);
+  u64 names_size =
+      (u64)DE100_PROFILER_TRACE_NAMES * sizeof(De100ProfileTraceName);
+  u64 frames_size =
+      (u64)DE100_PROFILER_TRACE_MAX_FRAMES * sizeof(De100ProfileTraceFrame);
+  trace->storage =
+      de100_memory_alloc(NULL, (size_t)(events_size + names_size + frames_size),
+                         De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(trace->storage)) {
+    return false;
+  }
+
+  u8 *base = (u8 *)trace->storage.base;
+  trace->events = (De100ProfileTraceEvent *)base;
+  trace->names = (De100ProfileTraceName *)(base + events_size);
+  trace->frames = (De100ProfileTraceFrame *)(base + events_size + names_size);
+  trace->event_count = 0;
+  trace->name_count = 0;
+  trace->frame_count = 0;
+  trace->is_full = false;
+  trace->frames_left = frame_count < DE100_PROFILER_TRACE_MAX_FRAMES
+                           ? frame_count
+                           : DE100_PROFILER_TRACE_MAX_FRAMES;
+  snprintf(trace->path, sizeof(trace->path), "%s",
+           path ? path : "de100-trace.json");
+
+  // The frame in progress is the first one captured
+  trace->begin_tsc = profiler->frame_begin_tsc;
+  trace->calibration_tsc = de100_profiler_tsc();
+  trace->calibration_seconds = de100_get_wall_clock();
+  trace->is_capturing = true;
+
+  printf("[PROFILE] Tracing %u frames to %s\n", trace->frames_left,
+         trace->path);
+  return true;
+}
+
+void de100_profiler_trace_end(De100Profiler *profiler) {
+  De100ProfileTrace *trace = &profiler->trace;
+  if (!trace->is_capturing) {
+    return;
+  }
+  trace->is_capturing = false;
+
+  // Close what's still open so every begin has its end
+  u64 end_tsc = de100_profiler_tsc();
+  f64 end_seconds = de100_get_wall_clock();
+  for (u32 i = 0; i < DE100_PROFILER_MAX_THREADS; ++i) {
+    const De100ProfileThread *thread = &profiler->threads[i];
+    for (u32 depth = 0; depth < thread->open_count; ++depth) {
+      trace_push(trace, end_tsc, NULL, i);
+    }
+  }
+
+  if (trace_write(profiler, end_tsc, end_seconds)) {
+    printf("[PROFILE] Trace written: %s (%u frames, %u events%s)\n",
+           trace->path, trace->frame_count, trace->event_count,
+           trace->is_full ? ", ended early: buffer full" : "");
+  } else {
+    fprintf(stderr, "❌ [PROFILE] Failed to write trace %s\n", trace->path);
+  }
+
+  de100_memory_free(&trace->storage);
+  trace->events = NULL;
+  trace->names = NULL;
+  trace->frames = NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DRAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void drain_thread(De100ProfileFrame *frame,
+                                       De100ProfileThread *thread,
+                                       u32 thread_index, u64 head,
+                                       De100ProfileTrace *trace) {
+  // Events were lost: nesting can't be trusted, start the stack over
+  u64 dropped = __atomic_load_n(&thread->dropped, __ATOMIC_RELAXED);
+  if (dropped != thread->dropped_seen) {
+    frame->dropped_events += dropped - thread->dropped_seen;
+    thread->dropped_seen = dropped;
+    thread->open_count = 0;
+    thread->open_overflow = 0;
+  }
+
+  // Blocks still open from earlier frames get their path in this one (and
+  // their begin in a trace that starts with it)
+  bool is_first_trace_frame = trace && trace->frame_count == 0;
+  u32 parent = DE100_PROFILER_NO_NODE;
+  for (u32 depth = 0; depth < thread->open_count; ++depth) {
+    De100ProfileOpenBlock *open = &thread->open[depth];
+    open->node =
+        find_or_add_node(frame, thread_index, parent, open->site, depth);
+    parent = open->node;
+    if (is_first_trace_frame) {
+      trace_push(trace, open->begin_tsc, open->site, thread_index);
+    }
+  }
+
+  u64 tail = thread->tail;
+
+  for (; tail < head; ++tail) {
+    const De100ProfileEvent *event =
+        &thread->events[tail & (DE100_PROFILER_THREAD_EVENTS - 1)];
+    if (trace) {
+      trace_push(trace, event->tsc, event->site, thread_index);
+    }
+
+    if (event->site) {
+      if (thread->open_count == DE100_PROFILER_MAX_DEPTH ||
+          thread->open_overflow > 0) {
+        thread->open_overflow++;
+        continue;
+      }
+      u32 parent_node = thread->open_count > 0
+                            ? thread->open[thread->open_count - 1].node
+                            : DE100_PROFILER_NO_NODE;
+      De100ProfileOpenBlock *open = &thread->open[thread->open_count++];
+      open->site = event->site;
+      open->begin_tsc = event->tsc;
+      open->node = find_or_add_node(frame, thread_index, parent_node,
+                                    event->site, thread->open_count - 1);
+      continue;
+    }
+
+    if (thread->open_overflow > 0) {
+      thread->open_overflow--;
+      continue;
+    }
+    if (thread->open_count == 0) {
+      continue; // Its begin was before a drop
+    }
+
+    De100ProfileOpenBlock *open = &thread->open[--thread->open_count];
+    u64 cycles = event->tsc - open->begin_tsc;
+    if (open->node != DE100_PROFILER_NO_NODE) {
+      De100ProfileNode *node = &frame->nodes[open->node];
+      node->hit_count++;
+      node->total_cycles += cycles;
+      if (node->parent != DE100_PROFILER_NO_NODE) {
+        frame->nodes[node->parent].child_cycles += cycles;
+      }
+    }
+  }
+
+  __atomic_store_n(&thread->tail, head, __ATOMIC_RELEASE);
+}
+
+void de100_profiler_end_frame(De100Profiler *profiler, u32 frame_index) {
+  if (!profiler->is_initialized) {
+    return;
+  }
+
+  u64 now = de100_profiler_tsc();
+  De100ProfileFrame *frame =
+      &profiler->frames[profiler->frames_captured % DE100_PROFILER_FRAME_COUNT];
+  frame->frame_index = frame_index;
+  frame->begin_tsc = profiler->frame_begin_tsc;
+  frame->end_tsc = now;
+  frame->dropped_events = 0;
+  frame->first_root = DE100_PROFILER_NO_NODE;
+  frame->node_count = 0;
+
+  // Snapshot the heads first so a trace knows up front if the frame fits
+  u64 heads[DE100_PROFILER_MAX_THREADS] = {0};
+  u64 pending = 0;
+  for (u32 i = 0; i < DE100_PROFILER_MAX_THREADS; ++i) {
+    De100ProfileThread *thread = &profiler->threads[i];
+    if (__atomic_load_n(&thread->owner, __ATOMIC_ACQUIRE) != 0) {
+      heads[i] = __atomic_load_n(&thread->head, __ATOMIC_ACQUIRE);
+      pending += heads[i] - thread->tail;
+    }
+  }
+
+  De100ProfileTrace *trace = &profiler->trace;
+  if (trace->is_capturing && !trace_frame_fits(trace, pending)) {
+    trace->is_full = true;
+    de100_profiler_trace_end(profiler);
+  }
+  De100ProfileTrace *capture = trace->is_capturing ? trace : NULL;
+
+  for (u32 i = 0; i < DE100_PROFILER_MAX_THREADS; ++i) {
+    De100ProfileThread *thread = &profiler->threads[i];
+    if (__atomic_load_n(&thread->owner, __ATOMIC_ACQUIRE) != 0) {
+      drain_thread(frame, thread, i, heads[i], capture);
+    }
+  }
+
+  profiler->frames_captured++;
+  profiler->frame_begin_tsc = now;
+
+  if (capture) {
+    capture->frames[capture->frame_count++] = (De100ProfileTraceFrame){
+        .frame_index = frame_index,
+        .begin_tsc = frame->begin_tsc,
+        .end_tsc = now,
+    };
+    if (--capture->frames_left == 0) {
+      de100_profiler_trace_end(profiler);
+    }
+  }
+}
+
+const De100ProfileFrame *
+de100_profiler_get_frame(const De100Profiler *profiler, u32 frames_back) {
+  if (!profiler->is_initialized || frames_back >= DE100_PROFILER_FRAME_COUNT ||
+      frames_back >= profiler->frames_captured) {
+    return NULL;
+  }
+  u64 index = profiler->frames_captured - 1 - frames_back;
+  return &profiler->frames[index % DE100_PROFILER_FRAME_COUNT];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void print_node(const De100ProfileFrame *frame, u32 index,
+                                     f64 frame_cycles) {
+  for (; index != DE100_PROFILER_NO_NODE;
+       index = frame->nodes[index].next_sibling) {
+    const De100ProfileNode *node = &frame->nodes[index];
+    u64 self_cycles = node->total_cycles - node->child_cycles;
+    printf("[PROFILE] t%-2u %6u %10.3f %10.3f %5.1f%%  %*s%s:%u\n",
+           node->thread_index, node->hit_count,
+           (f64)node->total_cycles / 1e6, (f64)self_cycles / 1e6,
+           frame_cycles > 0.0 ? (f64)node->total_cycles * 100.0 / frame_cycles
+                              : 0.0,
+           (int)node->depth * 2, "", node->name, node->line);
+    print_node(frame, node->first_child, frame_cycles);
+  }
+}
+
+void de100_profiler_print_frame(const De100ProfileFrame *frame) {
+  if (!frame) {
+    return;
+  }
+  f64 frame_cycles = (f64)(frame->end_tsc - frame->begin_tsc);
+  printf("[PROFILE] frame %u: %.3f Mcycles, %u paths", frame->frame_index,
+         frame_cycles / 1e6, frame->node_count);
+  if (frame->dropped_events > 0) {
+    printf(", %llu events dropped", (unsigned long long)frame->dropped_events);
+  }
+  printf("\n[PROFILE] %-3s %6s %10s %10s %6s  %s\n", "thr", "hits",
+         "total Mc", "self Mc", "frame", "block");
+  print_node(frame, frame->first_root, frame_cycles);
+}
+
+#endif // DE100_INTERNAL
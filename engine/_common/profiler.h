@@ -0,0 +1,319 @@
+#ifndef DE100_COMMON_PROFILER_H
+#define DE100_COMMON_PROFILER_H
+
+#include "base.h"
+#include "memory.h"
+
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⏱️ TIMED BLOCK PROFILER (DE100_INTERNAL builds only)
+// ═══════════════════════════════════════════════════════════════════════════
+// Casey's Day 176+ debug system, cut down:
+//
+//   void rewind_capture(...) {
+//     TIMED_FUNCTION();
+//     ...
+//     { TIMED_BLOCK("encode"); ... }
+//   }
+//
+// Every block records an rdtsc-stamped begin and end event into its
+// thread's ring (single producer: that thread; single consumer: the
+// engine). Once per frame (engine_begin_frame) the engine drains every
+// ring and folds the events into a call tree per thread: hit count, total
+// and self cycles per call path. The last DE100_PROFILER_FRAME_COUNT frames
+// are kept.
+//
+// TRACE CAPTURE: de100_profiler_trace_begin() additionally keeps every raw
+// event of the next N frames and then writes them as a Chrome trace-event
+// JSON file (chrome://tracing, https://ui.perfetto.dev), one track per
+// thread plus a "frames" track. F9 starts and stops one at any point of a
+// run (engine_toggle_profiler_trace); DE100_TRACE_FRAMES=N traces the first
+// N frames of a run instead (startup hitches), to DE100_TRACE_PATH.
+//
+// Without DE100_INTERNAL the macros compile to nothing.
+//
+// GAME CODE: the game library has its own globals, so it needs its own
+// g_de100_profiler. Define it once (DE100_PROFILER_DEFINE_GLOBAL at file
+// scope) and point it at GameMemory.profiler at the top of every update
+// (hot reload resets it).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_PROFILER_MAX_THREADS 16
+#define DE100_PROFILER_THREAD_EVENTS 16384 // Per thread per frame, power of 2
+#define DE100_PROFILER_MAX_DEPTH 32
+#define DE100_PROFILER_MAX_NODES 512 // Distinct call paths per frame
+#define DE100_PROFILER_FRAME_COUNT 8
+#define DE100_PROFILER_NAME_MAX 40
+#define DE100_PROFILER_NO_NODE 0xFFFFFFFFu
+#define DE100_PROFILER_TRACE_EVENTS (1u << 20) // Per capture
+#define DE100_PROFILER_TRACE_NAMES 512         // Distinct sites, power of 2
+#define DE100_PROFILER_TRACE_OTHER_NAME 0xFFFF // Sites past the table
+#define DE100_PROFILER_TRACE_MAX_FRAMES 3600
+#define DE100_PROFILER_TRACE_PATH_MAX 256
+
+typedef struct {
+  const char *name;
+  const char *file;
+  u32 line;
+} De100ProfileSite;
+
+typedef struct {
+  u64 tsc;
+  const De100ProfileSite *site; // NULL = end of the innermost open block
+} De100ProfileEvent;
+
+typedef struct {
+  const De100ProfileSite *site;
+  u64 begin_tsc;
+  u32 node; // In the frame being built (re-resolved each frame)
+} De100ProfileOpenBlock;
+
+typedef struct {
+  u64 owner; // Thread id, 0 = free slot
+  u64 head;  // Written by the owner
+  u64 tail;  // Written by the engine while draining
+  u64 dropped;
+  De100ProfileEvent *events;
+
+  // Engine side: blocks still open at the last drain
+  De100ProfileOpenBlock open[DE100_PROFILER_MAX_DEPTH];
+  u32 open_count;
+  u32 open_overflow; // Begins past MAX_DEPTH still waiting for their end
+  u64 dropped_seen;
+} De100ProfileThread;
+
+typedef struct {
+  char name[DE100_PROFILER_NAME_MAX];
+  u32 line;
+  u32 thread_index;
+  u32 depth;
+  u32 parent;
+  u32 first_child;
+  u32 next_sibling;
+  u32 hit_count;
+  u64 total_cycles;
+  u64 child_cycles; // self = total - child
+  const De100ProfileSite *site; // Match key while the frame is built only
+} De100ProfileNode;
+
+typedef struct {
+  u32 frame_index;
+  u64 begin_tsc;
+  u64 end_tsc;
+  u64 dropped_events;
+  u32 first_root; // Roots of all threads, chained by next_sibling
+  u32 node_count;
+  De100ProfileNode nodes[DE100_PROFILER_MAX_NODES];
+} De100ProfileFrame;
+
+typedef struct {
+  u64 tsc;
+  u16 name; // Index into De100ProfileTrace.names (begins only)
+  u8 thread_index;
+  u8 is_end;
+} De100ProfileTraceEvent;
+
+typedef struct {
+  // Names are copied: the game library (and its sites) may be reloaded
+  // before the trace is written
+  const De100ProfileSite *site;
+  char name[DE100_PROFILER_NAME_MAX];
+} De100ProfileTraceName;
+
+typedef struct {
+  u32 frame_index;
+  u64 begin_tsc;
+  u64 end_tsc;
+} De100ProfileTraceFrame;
+
+typedef struct {
+  bool is_capturing;
+  u32 frames_left;
+  char path[DE100_PROFILER_TRACE_PATH_MAX];
+
+  De100ProfileTraceEvent *events;
+  u32 event_count;
+  bool is_full; // Ended early: the next frame wouldn't have fit
+  De100ProfileTraceName *names;
+  u32 name_count;
+  De100ProfileTraceFrame *frames;
+  u32 frame_count;
+
+  u64 begin_tsc; // Time zero: start of the first captured frame
+  // tsc -> microseconds, measured over the capture
+  u64 calibration_tsc;
+  f64 calibration_seconds;
+
+  De100MemoryBlock storage;
+} De100ProfileTrace;
+
+typedef struct {
+  bool is_initialized;
+  De100ProfileThread threads[DE100_PROFILER_MAX_THREADS];
+  u32 thread_count; // High-water slot count
+
+  De100ProfileFrame *frames; // Ring of DE100_PROFILER_FRAME_COUNT
+  u64 frames_captured;
+  u64 frame_begin_tsc;
+
+  De100ProfileTrace trace;
+
+  De100MemoryBlock storage;
+} De100Profiler;
+
+extern De100Profiler *g_de100_profiler;
+
+#define DE100_PROFILER_DEFINE_GLOBAL De100Profiler *g_de100_profiler = NULL
+
+#if DE100_INTERNAL
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define de100_profiler_tsc() ((u64)__rdtsc())
+#else
+#include "time.h"
+de100_file_scoped_fn inline u64 de100_profiler_tsc(void) {
+  De100TimeSpec now;
+  de100_get_timespec(&now);
+  return (u64)now.seconds * 1000000000ull + (u64)now.nanoseconds;
+}
+#endif
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#define de100_profiler_thread_id() ((u64)GetCurrentThreadId())
+#else
+#include <pthread.h>
+#define de100_profiler_thread_id() ((u64)pthread_self())
+#endif
+
+/**
+ * This thread's ring. Found once per thread per translation unit: the slot
+ * is looked up by thread id, so the engine and the game library share it.
+ */
+de100_file_scoped_fn inline De100ProfileThread *
+de100_profiler_thread(De100Profiler *profiler) {
+  local_persist_var _Thread_local De100ProfileThread *thread = NULL;
+  local_persist_var _Thread_local De100Profiler *thread_profiler = NULL;
+  if (thread && thread_profiler == profiler) {
+    return thread;
+  }
+
+  u64 id = de100_profiler_thread_id();
+  for (u32 i = 0; i < DE100_PROFILER_MAX_THREADS; ++i) {
+    De100ProfileThread *slot = &profiler->threads[i];
+    u64 owner = __atomic_load_n(&slot->owner, __ATOMIC_ACQUIRE);
+    if (owner == id) {
+      thread = slot;
+      thread_profiler = profiler;
+      return thread;
+    }
+    u64 expected = 0;
+    if (owner == 0 &&
+        __atomic_compare_exchange_n(&slot->owner, &expected, id, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      __atomic_fetch_add(&profiler->thread_count, 1, __ATOMIC_RELEASE);
+      thread = slot;
+      thread_profiler = profiler;
+      return thread;
+    }
+  }
+  return NULL; // Out of slots: this thread isn't profiled
+}
+
+de100_file_scoped_fn inline void
+de100_profiler_record(const De100ProfileSite *site) {
+  De100Profiler *profiler = g_de100_profiler;
+  if (!profiler || !profiler->is_initialized) {
+    return;
+  }
+  De100ProfileThread *thread = de100_profiler_thread(profiler);
+  if (!thread) {
+    return;
+  }
+
+  u64 head = thread->head;
+  u64 tail = __atomic_load_n(&thread->tail, __ATOMIC_ACQUIRE);
+  if (head - tail >= DE100_PROFILER_THREAD_EVENTS) {
+    __atomic_fetch_add(&thread->dropped, 1, __ATOMIC_RELAXED);
+    return;
+  }
+
+  De100ProfileEvent *event =
+      &thread->events[head & (DE100_PROFILER_THREAD_EVENTS - 1)];
+  event->site = site;
+  event->tsc = de100_profiler_tsc();
+  __atomic_store_n(&thread->head, head + 1, __ATOMIC_RELEASE);
+}
+
+typedef struct {
+  u8 unused;
+} De100TimedBlock;
+
+de100_file_scoped_fn inline void de100_timed_block_end(De100TimedBlock *block) {
+  (void)block;
+  de100_profiler_record(NULL);
+}
+
+#define DE100_PROFILER_JOIN_(a, b) a##b
+#define DE100_PROFILER_JOIN(a, b) DE100_PROFILER_JOIN_(a, b)
+
+/** Time the rest of the enclosing scope. `name` must be a string literal. */
+#define TIMED_BLOCK(name)                                                      \
+  local_persist_var const De100ProfileSite DE100_PROFILER_JOIN(                \
+      de100_profile_site_, __LINE__) = {name, __FILE__, __LINE__};             \
+  de100_profiler_record(&DE100_PROFILER_JOIN(de100_profile_site_, __LINE__));  \
+  De100TimedBlock DE100_PROFILER_JOIN(de100_timed_block_, __LINE__)            \
+      __attribute__((cleanup(de100_timed_block_end), unused)) = {0}
+
+/** Time the rest of the enclosing function. */
+#define TIMED_FUNCTION() TIMED_BLOCK(__func__)
+
+// ─────────────────────────────────────────────────────────────────────────
+// Engine side
+// ─────────────────────────────────────────────────────────────────────────
+
+/** Allocate the rings and frame history; sets g_de100_profiler. */
+bool de100_profiler_init(De100Profiler *profiler);
+
+void de100_profiler_shutdown(De100Profiler *profiler);
+
+/**
+ * Drain every thread's events into the call tree of frame `frame_index`
+ * (the frame that just ended) and start the next one.
+ */
+void de100_profiler_end_frame(De100Profiler *profiler, u32 frame_index);
+
+/**
+ * A retained frame (0 = the last one ended), NULL if not captured (yet).
+ */
+const De100ProfileFrame *
+de100_profiler_get_frame(const De100Profiler *profiler, u32 frames_back);
+
+/** Print `frame` as an indented tree (hits, total / self Mcycles, %). */
+void de100_profiler_print_frame(const De100ProfileFrame *frame);
+
+/**
+ * Keep the raw events of the next `frame_count` frames (starting with the
+ * one in progress) and write them to `path` (NULL = "de100-trace.json")
+ * as Chrome trace-event JSON. False if a capture is already running or the
+ * buffers can't be allocated.
+ */
+bool de100_profiler_trace_begin(De100Profiler *profiler, u32 frame_count,
+                                const char *path);
+
+/** Stop a running capture early and write what it has. */
+void de100_profiler_trace_end(De100Profiler *profiler);
+
+#else
+
+#define TIMED_BLOCK(name) ((void)0)
+#define TIMED_FUNCTION() ((void)0)
+
+#endif // DE100_INTERNAL
+
+#endif // DE100_COMMON_PROFILER_H
@@ -19,6 +19,18 @@
 #error "Unsupported platform for time operations"
 #endif
 
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define DE100_TICK_CLOCK_HAS_TSC 1
+#include <cpuid.h>
+#if defined(__linux__)
+#include <stdio.h>
+#include <string.h>
+#endif
+#else
+#define DE100_TICK_CLOCK_HAS_TSC 0
+#endif
+
 // ═══════════════════════════════════════════════════════════════════════════
 // PLATFORM-SPECIFIC CACHED STATE
 // ═══════════════════════════════════════════════════════════════════════════
@@ -175,6 +187,39 @@ void de100_sleep_ms(u32 milliseconds) {
   de100_sleep_seconds((f64)milliseconds / 1000.0);
 }
 
+void de100_sleep_until(const De100TimeSpec *deadline) {
+  if (!deadline) {
+    return;
+  }
+
+#if defined(__linux__) || defined(__FreeBSD__)
+  // ─────────────────────────────────────────────────────────────────────
+  // LINUX/BSD: clock_nanosleep on the same clock de100_get_timespec reads
+  // ─────────────────────────────────────────────────────────────────────
+  // With TIMER_ABSTIME a signal doesn't shorten the sleep: retrying with
+  // the same deadline just continues it.
+  // ─────────────────────────────────────────────────────────────────────
+
+  struct timespec ts;
+  ts.tv_sec = (time_t)deadline->seconds;
+  ts.tv_nsec = (long)deadline->nanoseconds;
+
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    // Continue sleeping until the deadline
+  }
+
+#else
+  // ─────────────────────────────────────────────────────────────────────
+  // OTHERS: no absolute sleep, sleep for what's left
+  // ─────────────────────────────────────────────────────────────────────
+
+  De100TimeSpec now;
+  de100_get_timespec(&now);
+  de100_sleep_seconds(de100_timespec_diff_seconds(&now, deadline));
+
+#endif
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // GET TIMESPEC
 // ═══════════════════════════════════════════════════════════════════════════
@@ -294,3 +339,101 @@ i32 de100_timespec_compare(const De100TimeSpec *a, const De100TimeSpec *b) {
 
   return 0;
 }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TICK CLOCK
+// ═══════════════════════════════════════════════════════════════════════════
+
+De100TickClock g_de100_tick_clock = {
+    .is_tsc = false,
+    .ticks_per_second = 1000000000ull,
+    .seconds_per_tick = 1.0 / 1000000000.0,
+};
+
+#if DE100_TICK_CLOCK_HAS_TSC
+
+/** CPUID: the TSC runs at a constant rate through P-/C-states. */
+de100_file_scoped_fn bool tsc_is_invariant(void) {
+  u32 eax, ebx, ecx, edx;
+  if (!__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) ||
+      eax < 0x80000007u) {
+    return false;
+  }
+  __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+  if (!(edx & (1u << 8))) {
+    return false;
+  }
+
+#if defined(__linux__)
+  // The kernel rejects TSCs that are invariant on paper but unsynchronized
+  // across sockets or unstable under a hypervisor: trust its verdict
+  FILE *file = fopen(
+      "/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+  if (file) {
+    char source[32] = {0};
+    bool is_tsc = fgets(source, sizeof(source), file) &&
+                  strncmp(source, "tsc", 3) == 0;
+    fclose(file);
+    return is_tsc;
+  }
+#endif
+  return true;
+}
+
+typedef struct {
+  u64 tsc;
+  i64 ns;
+} TickClockSample;
+
+/**
+ * A TSC reading and a monotonic one taken together: the tightest bracket
+ * of a few tries, so a preemption in between doesn't skew calibration.
+ */
+de100_file_scoped_fn TickClockSample tick_clock_sample(void) {
+  TickClockSample best = {0};
+  u64 best_width = ~0ull;
+  for (u32 i = 0; i < 8; ++i) {
+    De100TimeSpec now;
+    u64 before = __builtin_ia32_rdtsc();
+    de100_get_timespec(&now);
+    u64 after = __builtin_ia32_rdtsc();
+    if (after - before < best_width) {
+      best_width = after - before;
+      best.tsc = before + (after - before) / 2;
+      best.ns = now.seconds * 1000000000LL + now.nanoseconds;
+    }
+  }
+  return best;
+}
+
+#endif
+
+bool de100_tick_clock_init(void) {
+#if DE100_TICK_CLOCK_HAS_TSC
+  if (!tsc_is_invariant()) {
+    return false;
+  }
+
+  TickClockSample start = tick_clock_sample();
+  de100_sleep_ms(10);
+  TickClockSample end = tick_clock_sample();
+
+  if (end.ns <= start.ns || end.tsc <= start.tsc) {
+    return false;
+  }
+  f64 seconds = (f64)(end.ns - start.ns) / 1000000000.0;
+  f64 ticks_per_second = (f64)(end.tsc - start.tsc) / seconds;
+
+  // Anything outside 100 MHz..20 GHz is a broken reading, not a CPU
+  if (ticks_per_second < 1e8 || ticks_per_second > 2e10) {
+    return false;
+  }
+
+  g_de100_tick_clock.ticks_per_second = (u64)ticks_per_second;
+  g_de100_tick_clock.seconds_per_tick = 1.0 / ticks_per_second;
+  g_de100_tick_clock.is_tsc = true;
+  return true;
+#else
+  return false;
+#endif
+}
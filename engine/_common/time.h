@@ -68,6 +68,17 @@ void de100_sleep_seconds(f64 seconds);
  */
 void de100_sleep_ms(u32 milliseconds);
 
+/**
+ * Sleep until `deadline`, a de100_get_timespec() time.
+ *
+ * @param deadline Absolute monotonic time to wake up at
+ *
+ * Note: Absolute, so time spent before the call doesn't push the wake-up
+ * later, and a deadline in the past returns immediately. The wake-up is
+ * still late by the scheduler's latency (frame-timing.c measures it).
+ */
+void de100_sleep_until(const De100TimeSpec *deadline);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // LOW-LEVEL TIMESPEC FUNCTIONS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -115,4 +126,57 @@ f64 de100_timespec_diff_milliseconds(const De100TimeSpec *start,
  */
 i32 de100_timespec_compare(const De100TimeSpec *a, const De100TimeSpec *b);
 
+// ═══════════════════════════════════════════════════════════════════════════
+// TICK CLOCK
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// For hot loops (spin-waits, per-event timestamps): de100_now_ticks() is a
+// bare rdtsc when the CPU's TSC is invariant (constant rate, never stops)
+// and de100_tick_clock_init() has calibrated it against the monotonic
+// clock. Otherwise it falls back to de100_get_timespec() in nanoseconds.
+// Ticks are only meaningful as differences, converted with
+// de100_ticks_to_seconds().
+//
+// State is per module: the game library starts on the fallback until it
+// calls de100_tick_clock_init() itself.
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  bool is_tsc;
+  u64 ticks_per_second; // 1e9 on the fallback
+  f64 seconds_per_tick;
+} De100TickClock;
+
+extern De100TickClock g_de100_tick_clock;
+
+/**
+ * Pick the tick source and calibrate it (~10ms, once at startup).
+ *
+ * @return true if ticks come from the TSC
+ */
+bool de100_tick_clock_init(void);
+
+de100_file_scoped_fn inline u64 de100_now_ticks(void) {
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+  if (g_de100_tick_clock.is_tsc) {
+    return __builtin_ia32_rdtsc();
+  }
+#endif
+  De100TimeSpec now;
+  de100_get_timespec(&now);
+  return (u64)now.seconds * 1000000000ull + (u64)now.nanoseconds;
+}
+
+de100_file_scoped_fn inline f64 de100_ticks_to_seconds(u64 ticks) {
+  return (f64)ticks * g_de100_tick_clock.seconds_per_tick;
+}
+
+de100_file_scoped_fn inline u64 de100_seconds_to_ticks(f64 seconds) {
+  if (seconds <= 0.0) {
+    return 0;
+  }
+  return (u64)(seconds * (f64)g_de100_tick_clock.ticks_per_second);
+}
+
 #endif // DE100_COMMON_TIME_H
@@ -111,10 +111,13 @@ DE100_SRC_MAIN="$DE100_ENGINE_DIR/main.c"
 
 DE100_SRC_COMMON=(
     "$DE100_ENGINE_DIR/engine.c"
+    "$DE100_ENGINE_DIR/_common/compress.c"
     "$DE100_ENGINE_DIR/_common/dll.c"
     "$DE100_ENGINE_DIR/_common/file.c"
+    "$DE100_ENGINE_DIR/_common/hash.c"
     "$DE100_ENGINE_DIR/_common/memory.c"
     "$DE100_ENGINE_DIR/_common/path.c"
+    "$DE100_ENGINE_DIR/_common/profiler.c"
     "$DE100_ENGINE_DIR/_common/time.c"
 )
 
@@ -131,9 +134,19 @@ DE100_SRC_GAME=(
 
 DE100_SRC_PLATFORM_COMMON=(
     "$DE100_ENGINE_DIR/platforms/_common/replay-buffer.c"
+    "$DE100_ENGINE_DIR/platforms/_common/dirty-pages.c"
+    "$DE100_ENGINE_DIR/platforms/_common/parallel-copy.c"
+    "$DE100_ENGINE_DIR/platforms/_common/rewind.c"
+    "$DE100_ENGINE_DIR/platforms/_common/state-hash.c"
+    "$DE100_ENGINE_DIR/platforms/_common/async-writer.c"
+    "$DE100_ENGINE_DIR/platforms/_common/input-stream.c"
     "$DE100_ENGINE_DIR/platforms/_common/inputs-recording.c"
+    "$DE100_ENGINE_DIR/platforms/_common/playback-speed.c"
+    "$DE100_ENGINE_DIR/platforms/_common/replay-keyframes.c"
+    "$DE100_ENGINE_DIR/platforms/_common/fixed-timestep.c"
     "$DE100_ENGINE_DIR/platforms/_common/adaptive-fps.c"
     "$DE100_ENGINE_DIR/platforms/_common/frame-timing.c"
+    "$DE100_ENGINE_DIR/platforms/_common/frame-stats.c"
 )
 
 # ───────────────────────────────────────────────────────────────────────────────
@@ -149,13 +162,6 @@ de100_set_backend() {
     local GAME_DIR="$2"
     local DE100_INTERNAL="$3"
     
-    # Add internal debug sources if enabled
-    if [[ "$DE100_INTERNAL" == "1" ]]; then
-        DE100_SRC_PLATFORM_COMMON+=(
-            "$DE100_ENGINE_DIR/platforms/_common/frame-stats.c"
-        )
-    fi
-    
     # Auto-select backend if not specified
     if [[ -z "$backend" || "$backend" == "auto" ]]; then
         case "$DE100_OS" in
@@ -167,19 +173,29 @@ de100_set_backend() {
     
     local backend_dir="$DE100_ENGINE_DIR/platforms/$backend"
     
-    DE100_SRC_BACKEND=(
-        "$backend_dir/audio.c"
-        "$backend_dir/backend.c"
-        "$backend_dir/inputs/mouse.c"
-        "$backend_dir/hooks/utils.c"
-        "$GAME_DIR/adapters/$backend/inputs/keyboard.c"
-        "$GAME_DIR/adapters/$backend/inputs/joystick.c"
-    )
+    if [[ "$backend" == "null" ]]; then
+        # Headless: no devices, so no mouse file and no game adapters
+        DE100_SRC_BACKEND=(
+            "$backend_dir/audio.c"
+            "$backend_dir/backend.c"
+            "$backend_dir/batch.c"
+            "$backend_dir/hooks/utils.c"
+        )
+    else
+        DE100_SRC_BACKEND=(
+            "$backend_dir/audio.c"
+            "$backend_dir/backend.c"
+            "$backend_dir/inputs/mouse.c"
+            "$backend_dir/hooks/utils.c"
+            "$GAME_DIR/adapters/$backend/inputs/keyboard.c"
+            "$GAME_DIR/adapters/$backend/inputs/joystick.c"
+        )
+    fi
     
     # Set backend-specific library dependencies
     case "$backend" in
         x11)
-            DE100_BACKEND_LIBS="-lX11 -lXrandr -lGL -lGLX -lasound -ldl"
+            DE100_BACKEND_LIBS="-lX11 -lXrandr -lGL -lGLX -lasound -lpthread -ldl"
         ;;
         raylib)
             case "$DE100_OS" in
@@ -188,9 +204,12 @@ de100_set_backend() {
                 *)       DE100_BACKEND_LIBS="-lraylib -lpthread -ldl" ;;
             esac
         ;;
+        null)
+            DE100_BACKEND_LIBS="-lpthread -ldl"
+        ;;
         *)
             echo "Error: Unknown backend '$backend'" >&2
-            echo "Available: x11, raylib, auto" >&2
+            echo "Available: x11, raylib, null, auto" >&2
             return 1
         ;;
     esac
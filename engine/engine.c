@@ -1,13 +1,65 @@
 #include "engine.h"
 #include "./platforms/_common/hooks/utils.h"
 
+#include "_common/hash.h"
 #include "_common/memory.h"
 #include "_common/path.h"
 #include "_common/time.h"
 #include "game/base.h"
 #include "game/game-loader.h"
+#include "platforms/_common/inputs-recording.h"
+#include "platforms/_common/parallel-copy.h"
 #include "platforms/_common/replay-buffer.h"
 
+#include <stdlib.h>
+
+// Identifies the engine build in recording headers; override from the
+// build script (e.g. with the git revision) for reproducible IDs.
+#ifndef DE100_BUILD_ID
+#define DE100_BUILD_ID __DATE__ " " __TIME__
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ON-DEMAND COMMIT HOOK
+// ═══════════════════════════════════════════════════════════════════════════
+// Handed to the game through GameMemory.commit_transient (the game DLL can't
+// call de100_memory_commit() itself). `context` is the game state block.
+
+de100_file_scoped_fn u8 *engine_commit_game_memory(void *context,
+                                                   u8 *required_end) {
+  De100MemoryBlock *block = (De100MemoryBlock *)context;
+  u8 *base = (u8 *)block->base;
+
+  if (required_end < base || required_end > base + block->size) {
+    return NULL;
+  }
+
+  De100MemoryError error =
+      de100_memory_commit(block, (size_t)(required_end - base));
+  if (error != De100_MEMORY_OK) {
+    fprintf(stderr, "❌ Failed to commit game memory (%.1f MB): %s\n",
+            (f64)(required_end - base) / (1024.0 * 1024.0),
+            de100_memory_error_str(error));
+    return NULL;
+  }
+
+  return base + block->committed_size;
+}
+
+// Which huge page path a LARGE_PAGES block ended up on, for the init log
+de100_file_scoped_fn inline const char *
+engine_large_pages_str(const De100MemoryBlock *block) {
+  switch (block->page_mode) {
+  case De100_MEMORY_PAGE_MODE_HUGETLB:
+    return "hugetlb pool";
+  case De100_MEMORY_PAGE_MODE_TRANSPARENT:
+    return "THP via madvise";
+  case De100_MEMORY_PAGE_MODE_NORMAL:
+    break;
+  }
+  return "base pages: no hugetlb pool, THP refused";
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ENGINE INIT (Common across all platforms)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -27,6 +79,17 @@ int engine_init(EngineState *engine) {
   game->inputs = &platform->inputs[0];
   platform->old_inputs = &platform->inputs[1];
 
+  // ─────────────────────────────────────────────────────────────────────
+  // TICK CLOCK (frame pacer spin-waits)
+  // ─────────────────────────────────────────────────────────────────────
+
+  if (de100_tick_clock_init()) {
+    printf("✅ Tick clock: invariant TSC at %.3f GHz\n",
+           (f64)g_de100_tick_clock.ticks_per_second / 1e9);
+  } else {
+    printf("✅ Tick clock: monotonic clock (no usable invariant TSC)\n");
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // LOAD GAME CODE
   // ─────────────────────────────────────────────────────────────────────
@@ -94,6 +157,23 @@ int engine_init(EngineState *engine) {
   de100_set_target_fps(max_allowed_refresh_rate_hz);
   g_frame_counter = 0;
 
+  // Recorded input frames are updates, so recording rates follow it
+  fixed_timestep_init(&platform->fixed_timestep, game->config.fixed_update_hz,
+                      game->config.max_updates_per_frame);
+  u32 update_rate_hz = platform->fixed_timestep.is_enabled
+                           ? game->config.fixed_update_hz
+                           : max_allowed_refresh_rate_hz;
+  game->memory.seconds_per_update =
+      platform->fixed_timestep.is_enabled
+          ? (f32)platform->fixed_timestep.seconds_per_update
+          : game->config.target_seconds_per_frame;
+  game->memory.interpolation_alpha = 1.0f;
+  if (platform->fixed_timestep.is_enabled) {
+    printf("✅ Fixed timestep: %u updates/s (up to %u per frame)\n",
+           game->config.fixed_update_hz,
+           platform->fixed_timestep.max_updates_per_frame);
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // ALLOCATE GAME STATE MEMORY
   // ─────────────────────────────────────────────────────────────────────
@@ -107,16 +187,37 @@ int engine_init(EngineState *engine) {
   u64 total_size =
       game->config.permanent_storage_size + game->config.transient_storage_size;
 
+  // Lazy transient commit: reserve the whole range, commit only permanent
+  // storage now and let transient arenas grow into the rest.
+  // LARGE_PAGES: the replay snapshot memcpy and SoA sweeps walk the whole
+  // block, 2MB pages cut the TLB misses on those by ~512x.
+  De100MemoryFlags game_state_flags =
+      De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
+      De100_MEMORY_FLAG_ZEROED | De100_MEMORY_FLAG_LARGE_PAGES;
+  if (game->config.prefer_lazy_transient_commit) {
+    game_state_flags |= De100_MEMORY_FLAG_RESERVE_ONLY;
+  }
+
   allocations->game_state =
-      de100_memory_alloc(base_address, total_size,
-                         De100_MEMORY_FLAG_READ | De100_MEMORY_FLAG_WRITE |
-                             De100_MEMORY_FLAG_ZEROED);
+      de100_memory_alloc(base_address, total_size, game_state_flags);
 
   if (!de100_memory_is_valid(allocations->game_state)) {
     fprintf(stderr, "❌ Failed to allocate game state\n");
     return 1;
   }
 
+  if (game->config.prefer_lazy_transient_commit) {
+    De100MemoryError commit_error = de100_memory_commit(
+        &allocations->game_state, game->config.permanent_storage_size);
+    if (commit_error != De100_MEMORY_OK) {
+      fprintf(stderr, "❌ Failed to commit permanent storage: %s\n",
+              de100_memory_error_str(commit_error));
+      return 1;
+    }
+    game->memory.commit_transient = engine_commit_game_memory;
+    game->memory.commit_context = &allocations->game_state;
+  }
+
   game->memory.permanent_storage = allocations->game_state.base;
   game->memory.transient_storage =
       (u8 *)allocations->game_state.base + game->config.permanent_storage_size;
@@ -126,7 +227,22 @@ int engine_init(EngineState *engine) {
 
   platform->memory_state.total_size = total_size;
   platform->memory_state.game_memory = allocations->game_state.base;
-  printf("✅ Game state: %lu MB\n", total_size / (1024 * 1024));
+  platform->memory_state.game_memory_block = &allocations->game_state;
+  printf("✅ Game state: %lu MB [%s]", total_size / (1024 * 1024),
+         engine_large_pages_str(&allocations->game_state));
+  if (game->config.prefer_lazy_transient_commit) {
+    printf(" (reserved, %lu MB committed)",
+           (unsigned long)(allocations->game_state.committed_size /
+                           (1024 * 1024)));
+  }
+  printf("\n");
+
+  // ─────────────────────────────────────────────────────────────────────
+  // SNAPSHOT COPY THREADS
+  // ─────────────────────────────────────────────────────────────────────
+
+  parallel_copy_init(game->config.snapshot_copy_threads);
+  printf("✅ Snapshot copy threads: %u\n", parallel_copy_thread_count());
 
   // ─────────────────────────────────────────────────────────────────────
   // INITIALIZE REPLAY BUFFERS
@@ -134,7 +250,10 @@ int engine_init(EngineState *engine) {
 
   ReplayBufferInitResult replay_result = replay_buffers_init(
       platform->paths.exe_directory.path, platform->memory_state.game_memory,
-      platform->memory_state.total_size, platform->memory_state.replay_buffers);
+      platform->memory_state.total_size,
+      game->config.compress_replay_slots ? REPLAY_BUFFER_FORMAT_COMPRESSED
+                                         : REPLAY_BUFFER_FORMAT_MAPPED,
+      platform->memory_state.replay_buffers);
 
   if (!replay_result.success) {
     fprintf(stderr, "⚠️  Replay buffers failed to initialize: %s\n",
@@ -142,8 +261,108 @@ int engine_init(EngineState *engine) {
     fprintf(stderr, "   Input recording/playback will not work.\n");
     // Don't fail engine init - this is a debug feature
   } else {
-    printf("✅ Replay buffers: %d/%d initialized\n",
-           replay_result.buffers_initialized, MAX_REPLAY_BUFFERS);
+    printf("✅ Replay buffers: %d/%d initialized%s\n",
+           replay_result.buffers_initialized, MAX_REPLAY_BUFFERS,
+           game->config.compress_replay_slots ? " (compressed)" : "");
+  }
+
+  // Incremental snapshots and rewind: one dirty-page channel per consumer
+  DirtyPageTracker *dirty_pages = &platform->memory_state.dirty_pages;
+  dirty_pages_init(dirty_pages, platform->memory_state.game_memory,
+                   platform->memory_state.total_size,
+                   allocations->game_state.page_mode ==
+                           De100_MEMORY_PAGE_MODE_HUGETLB
+                       ? DE100_MEMORY_LARGE_PAGE_SIZE
+                       : de100_memory_page_size(),
+                   game->config.allow_write_fault_dirty_tracking);
+  for (i32 slot = VALID_REPLAY_BUFFERS_START_INDEX; slot < MAX_REPLAY_BUFFERS;
+       ++slot) {
+    ReplayBuffer *buffer = &platform->memory_state.replay_buffers[slot];
+    if (buffer->is_valid) {
+      buffer->dirty_channel = dirty_pages_add_channel(dirty_pages);
+    }
+  }
+  printf("✅ Snapshot dirty tracking: %s\n",
+         dirty_pages_mode_str(dirty_pages->mode));
+
+  // ─────────────────────────────────────────────────────────────────────
+  // REWIND HISTORY
+  // ─────────────────────────────────────────────────────────────────────
+
+  if (game->config.rewind_budget_size > 0) {
+    u64 rewind_region_size = game->config.rewind_region_size;
+    if (rewind_region_size == 0 ||
+        rewind_region_size > game->config.permanent_storage_size) {
+      rewind_region_size = game->config.permanent_storage_size;
+    }
+
+    RewindBuffer *rewind = &platform->memory_state.rewind;
+    if (rewind_init(rewind, platform->memory_state.game_memory,
+                    rewind_region_size, game->config.rewind_budget_size,
+                    dirty_pages)) {
+      printf("✅ Rewind: %.1f MB history over %.1f MB of permanent storage "
+             "(%s)\n",
+             (f64)rewind->ring_capacity / (1024.0 * 1024.0),
+             (f64)rewind->region_size / (1024.0 * 1024.0),
+             rewind->dirty_channel != DIRTY_PAGES_NO_CHANNEL
+                 ? dirty_pages_mode_str(dirty_pages->mode)
+                 : "full compare");
+    } else {
+      fprintf(stderr, "⚠️  Rewind failed to initialize, disabled\n");
+    }
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // REPLAY DETERMINISM CHECK
+  // ─────────────────────────────────────────────────────────────────────
+
+  if (game->config.check_replay_determinism &&
+      !dirty_pages_is_active(dirty_pages) &&
+      game->config.permanent_storage_size > STATE_HASH_UNTRACKED_MAX_SIZE) {
+    printf("⚠️  Replay determinism check off: no dirty page tracking, it "
+           "would rehash %.1f MB every frame\n",
+           (f64)game->config.permanent_storage_size / (1024.0 * 1024.0));
+  } else if (game->config.check_replay_determinism) {
+    StateHash *state_hash = &platform->memory_state.state_hash;
+    if (state_hash_init(state_hash, platform->memory_state.game_memory,
+                        game->config.permanent_storage_size, dirty_pages)) {
+      printf("✅ Replay determinism check: %.1f MB of permanent storage (%s)\n",
+             (f64)state_hash->region_size / (1024.0 * 1024.0),
+             state_hash->dirty_channel != DIRTY_PAGES_NO_CHANNEL
+                 ? dirty_pages_mode_str(dirty_pages->mode)
+                 : "full rehash");
+    } else {
+      fprintf(stderr,
+              "⚠️  Replay determinism check failed to initialize, disabled\n");
+    }
+  }
+
+  u32 keyframe_interval_frames =
+      (u32)(game->config.replay_keyframe_interval_seconds *
+                (f32)update_rate_hz +
+            0.5f);
+  if (keyframe_interval_frames > 0) {
+    // Untracked, every keyframe hashes its whole region on the game thread:
+    // keep that to permanent storage, where the game state lives. Tracked,
+    // each keyframe compresses whatever changed in all of game memory (see
+    // replay-keyframes.h for measured costs)
+    u64 keyframe_region_size = dirty_pages_is_active(dirty_pages)
+                                   ? platform->memory_state.total_size
+                                   : game->config.permanent_storage_size;
+    ReplayKeyframes *keyframes = &platform->memory_state.keyframes;
+    if (replay_keyframes_init(keyframes, platform->memory_state.game_memory,
+                              keyframe_region_size, keyframe_interval_frames,
+                              dirty_pages)) {
+      printf("✅ Replay keyframes: every %u frames over %.1f MB (%s)\n",
+             keyframe_interval_frames,
+             (f64)keyframes->region_size / (1024.0 * 1024.0),
+             keyframes->dirty_channel != DIRTY_PAGES_NO_CHANNEL
+                 ? dirty_pages_mode_str(dirty_pages->mode)
+                 : "chunk hashes");
+    } else {
+      fprintf(stderr,
+              "⚠️  Replay keyframes failed to initialize, seeking disabled\n");
+    }
   }
 
   // ─────────────────────────────────────────────────────────────────────
@@ -154,7 +373,9 @@ int engine_init(EngineState *engine) {
       game->config.window_width * game->config.window_height * 4;
 
   game->backbuffer.memory =
-      de100_memory_alloc(NULL, backbuffer_size, De100_MEMORY_FLAG_RW_ZEROED);
+      de100_memory_alloc(NULL, backbuffer_size,
+                         De100_MEMORY_FLAG_RW_ZEROED |
+                             De100_MEMORY_FLAG_LARGE_PAGES);
 
   if (!de100_memory_is_valid(game->backbuffer.memory)) {
     fprintf(stderr, "❌ Failed to allocate backbuffer\n");
@@ -165,8 +386,33 @@ int engine_init(EngineState *engine) {
   game->backbuffer.height = game->config.window_height;
   game->backbuffer.bytes_per_pixel = 4;
   game->backbuffer.pitch = game->config.window_width * 4;
-  printf("✅ Backbuffer: %dx%d\n", game->backbuffer.width,
-         game->backbuffer.height);
+  printf("✅ Backbuffer: %dx%d [%s]\n", game->backbuffer.width,
+         game->backbuffer.height,
+         engine_large_pages_str(&game->backbuffer.memory));
+
+  // ─────────────────────────────────────────────────────────────────────
+  // ALLOCATE FRAME ARENA
+  // ─────────────────────────────────────────────────────────────────────
+  //
+  // Separate block (not carved from game_state) so replay snapshots never
+  // copy per-frame scratch. Reset every frame by engine_begin_frame().
+
+  if (game->config.frame_arena_size > 0) {
+    allocations->frame_arena = de100_memory_alloc(
+        NULL, game->config.frame_arena_size, De100_MEMORY_FLAG_RW_ZEROED);
+
+    if (!de100_memory_is_valid(allocations->frame_arena)) {
+      fprintf(stderr, "❌ Failed to allocate frame arena\n");
+      return 1;
+    }
+
+    de100_arena_init(&game->memory.frame_arena, allocations->frame_arena.base,
+                     allocations->frame_arena.size);
+    de100_arena_track(&game->memory.arena_registry, &game->memory.frame_arena,
+                      "frame");
+    printf("✅ Frame arena: %lu KB\n",
+           (unsigned long)(allocations->frame_arena.size / 1024));
+  }
 
   // ─────────────────────────────────────────────────────────────────────
   // ALLOCATE AUDIO BUFFER
@@ -207,15 +453,351 @@ int engine_init(EngineState *engine) {
   // RECORDING STATE
   // ─────────────────────────────────────────────────────────────────────
 
-  platform->memory_state.recording_fd = -1;
-  platform->memory_state.playback_fd = -1;
+  platform->memory_state.recording_stream.fd = -1;
+  platform->memory_state.playback_stream.fd = -1;
+  platform->memory_state.recording_hash_fd = -1;
+  platform->memory_state.playback_hash_fd = -1;
+  platform->memory_state.first_divergent_frame = -1;
+  platform->memory_state.pending_seek_frame = -1;
   platform->memory_state.input_recording_index = 0;
   platform->memory_state.input_playing_index = 0;
 
+  // Stamped into recording headers so playback can tell a recording made by
+  // another build apart from one made by this build.
+  De100TimeSpec game_write_time = platform->game_main_code.meta.last_write_time;
+  platform->memory_state.stream_info = (InputStreamInfo){
+      .engine_build_id =
+          de100_hash64(DE100_BUILD_ID, sizeof(DE100_BUILD_ID) - 1, 0),
+      .game_build_id = (u64)game_write_time.seconds * 1000000000ull +
+                       (u64)game_write_time.nanoseconds,
+      .frame_rate_hz = update_rate_hz,
+  };
+
+#if DE100_INTERNAL
+  if (de100_profiler_init(&platform->profiler)) {
+    game->memory.profiler = &platform->profiler;
+    printf("✅ Profiler: %u threads x %u events\n", DE100_PROFILER_MAX_THREADS,
+           DE100_PROFILER_THREAD_EVENTS);
+
+    // Trace the first frames of the run (startup hitches, shader warmup...)
+    const char *trace_frames = getenv("DE100_TRACE_FRAMES");
+    if (trace_frames && atoi(trace_frames) > 0) {
+      de100_profiler_trace_begin(&platform->profiler, (u32)atoi(trace_frames),
+                                 getenv("DE100_TRACE_PATH"));
+    }
+  } else {
+    fprintf(stderr, "⚠️  Failed to allocate profiler, TIMED_BLOCKs are off\n");
+  }
+#endif
+
   printf("✅ Engine initialized\n");
   return 0;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// ENGINE BEGIN FRAME
+// ═══════════════════════════════════════════════════════════════════════════
+
+void engine_begin_frame(EngineState *engine) {
+#if DE100_INTERNAL
+  // Everything timed since the last call belongs to the previous frame
+  de100_profiler_end_frame(&engine->platform.profiler,
+                           g_frame_counter > 0 ? g_frame_counter - 1 : 0);
+  if (FRAME_LOG_EVERY_TEN_SECONDS_CHECK) {
+    de100_profiler_print_frame(
+        de100_profiler_get_frame(&engine->platform.profiler, 0));
+  }
+#endif
+
+  De100Arena *frame_arena = &engine->game.memory.frame_arena;
+  EngineFrameArenaStats *stats = &engine->platform.frame_arena_stats;
+
+  de100_arena_check_temp(frame_arena);
+
+  // Before the frame arena's peak is cleared below
+  de100_arena_registry_sample(&engine->game.memory.arena_registry);
+
+  stats->last_frame_used = frame_arena->peak_used;
+  stats->last_frame_pushes = frame_arena->push_count;
+  if (frame_arena->peak_used > stats->peak_frame_used) {
+    stats->peak_frame_used = frame_arena->peak_used;
+    stats->peak_frame_index = g_frame_counter;
+  }
+
+  de100_arena_reset(frame_arena);
+  de100_arena_clear_peak(frame_arena);
+
+#if DE100_INTERNAL
+  if (frame_arena->size > 0 && FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
+    printf("[FRAME ARENA] last: %.1f KB (%u pushes), peak: %.1f KB @ frame "
+           "%u, capacity: %.1f KB\n",
+           (f64)stats->last_frame_used / 1024.0, stats->last_frame_pushes,
+           (f64)stats->peak_frame_used / 1024.0, stats->peak_frame_index,
+           (f64)frame_arena->size / 1024.0);
+  }
+
+  if (engine->game.memory.commit_transient &&
+      FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
+    De100MemoryStats memory_stats = de100_memory_get_stats();
+    printf("[MEMORY] committed: %.1f MB / reserved: %.1f MB (%u commits)\n",
+           (f64)memory_stats.committed_bytes / (1024.0 * 1024.0),
+           (f64)memory_stats.reserved_bytes / (1024.0 * 1024.0),
+           memory_stats.commit_calls);
+  }
+#endif
+
+  u32 report_interval = engine->game.config.memory_report_interval_seconds;
+  if (report_interval > 0 && g_fps > 0 && g_frame_counter > 0 &&
+      g_frame_counter % (g_fps * report_interval) == 0) {
+    EngineMemoryReport report;
+    engine_memory_report(engine, &report);
+    engine_memory_report_print(engine, &report);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENGINE BEGIN UPDATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+void engine_begin_update(EngineState *engine, u32 update_index) {
+  TIMED_FUNCTION();
+  GameMemoryState *memory_state = &engine->platform.memory_state;
+
+  // Same polled input as the frame's first update, minus its transitions
+  if (update_index > 0) {
+    prepare_input_frame(engine->game.inputs, engine->game.inputs);
+  }
+
+  // Record where the previous update left permanent storage. Restores done
+  // by input playback are just more changes, so this keeps running then too.
+  // A held frame makes no update and so has no recorded hash.
+  rewind_capture(&memory_state->rewind, g_frame_counter,
+                 game_memory_state_committed_size(memory_state));
+
+  // The state the previous update left behind, against the recording
+  input_recording_hash_frame(memory_state);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENGINE MEMORY REPORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn EngineMemoryRegion *
+memory_report_add(EngineMemoryReport *report, const char *name,
+                  const void *base, u64 reserved, u64 committed) {
+  if (report->region_count >= ENGINE_MEMORY_REPORT_MAX_REGIONS) {
+    return NULL;
+  }
+  EngineMemoryRegion *region = &report->regions[report->region_count++];
+  snprintf(region->name, sizeof(region->name), "%s", name);
+  region->reserved_bytes = reserved;
+  region->committed_bytes = committed;
+
+  size_t resident = 0;
+  region->resident_known =
+      base && de100_memory_query_resident(base, (size_t)reserved, &resident);
+  region->resident_bytes = resident;
+
+  report->total_reserved_bytes += reserved;
+  report->total_committed_bytes += committed;
+  report->total_resident_bytes += resident;
+  return region;
+}
+
+de100_file_scoped_fn void memory_report_add_block(EngineMemoryReport *report,
+                                                  const char *name,
+                                                  const De100MemoryBlock *block) {
+  if (de100_memory_is_valid(*block)) {
+    memory_report_add(report, name, block->base, block->size,
+                      block->committed_size);
+  }
+}
+
+void engine_memory_report(const EngineState *engine, EngineMemoryReport *out) {
+  const EngineGameState *game = &engine->game;
+  const EngineAllocations *allocations = &engine->allocations;
+  const GameMemoryState *memory_state = &engine->platform.memory_state;
+
+  *out = (EngineMemoryReport){0};
+  out->allocator = de100_memory_get_stats();
+
+  // Game memory, split so permanent vs transient usage is visible
+  u64 committed = game_memory_state_committed_size(memory_state);
+  u64 permanent = game->memory.permanent_storage_size;
+  u64 transient = game->memory.transient_storage_size;
+  if (game->memory.permanent_storage) {
+    memory_report_add(out, "permanent storage", game->memory.permanent_storage,
+                      permanent, committed < permanent ? committed : permanent);
+  }
+  if (game->memory.transient_storage) {
+    memory_report_add(out, "transient storage", game->memory.transient_storage,
+                      transient, committed > permanent ? committed - permanent
+                                                       : 0);
+  }
+
+  memory_report_add_block(out, "frame arena", &allocations->frame_arena);
+  memory_report_add_block(out, "backbuffer", &game->backbuffer.memory);
+  memory_report_add_block(out, "audio samples", &allocations->audio_samples);
+
+  for (i32 slot = VALID_REPLAY_BUFFERS_START_INDEX; slot < MAX_REPLAY_BUFFERS;
+       ++slot) {
+    const ReplayBuffer *buffer = &memory_state->replay_buffers[slot];
+    if (!replay_buffer_is_valid(buffer)) {
+      continue;
+    }
+    char name[ENGINE_MEMORY_REGION_NAME_MAX];
+    if (buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+      // Nothing mapped: report the file
+      snprintf(name, sizeof(name), "replay slot %d (file)", slot);
+      memory_report_add(out, name, NULL, buffer->stored_size,
+                        buffer->stored_size);
+    } else {
+      snprintf(name, sizeof(name), "replay slot %d (mmap)", slot);
+      memory_report_add(out, name, buffer->memory_block, buffer->mapped_size,
+                        buffer->mapped_size);
+    }
+  }
+
+  memory_report_add_block(out, "rewind", &memory_state->rewind.storage);
+  memory_report_add_block(out, "replay keyframes",
+                          &memory_state->keyframes.storage);
+#if DE100_INTERNAL
+  memory_report_add_block(out, "profiler", &engine->platform.profiler.storage);
+#endif
+  memory_report_add_block(out, "dirty page tracking",
+                          &memory_state->dirty_pages.storage);
+}
+
+void engine_memory_report_print(const EngineState *engine,
+                                const EngineMemoryReport *report) {
+  const f64 mb = 1024.0 * 1024.0;
+
+  printf("[MEMORY REPORT] ───────────────────────────────────────────────\n");
+  printf("[MEMORY REPORT] %-24s %11s %11s %11s\n", "region", "reserved",
+         "committed", "resident");
+  for (u32 i = 0; i < report->region_count; ++i) {
+    const EngineMemoryRegion *region = &report->regions[i];
+    if (region->resident_known) {
+      printf("[MEMORY REPORT] %-24s %8.1f MB %8.1f MB %8.1f MB\n", region->name,
+             (f64)region->reserved_bytes / mb,
+             (f64)region->committed_bytes / mb,
+             (f64)region->resident_bytes / mb);
+    } else {
+      printf("[MEMORY REPORT] %-24s %8.1f MB %8.1f MB %11s\n", region->name,
+             (f64)region->reserved_bytes / mb,
+             (f64)region->committed_bytes / mb, "-");
+    }
+  }
+  printf("[MEMORY REPORT] %-24s %8.1f MB %8.1f MB %8.1f MB\n", "total",
+         (f64)report->total_reserved_bytes / mb,
+         (f64)report->total_committed_bytes / mb,
+         (f64)report->total_resident_bytes / mb);
+  printf("[MEMORY REPORT] allocator: %u blocks, peak committed %.1f MB, %u "
+         "on-demand commits\n",
+         report->allocator.block_count,
+         (f64)report->allocator.peak_committed_bytes / mb,
+         report->allocator.commit_calls);
+
+  const De100ArenaRegistry *registry = &engine->game.memory.arena_registry;
+  if (registry->count == 0) {
+    return;
+  }
+  printf("[MEMORY REPORT] %-24s %11s %11s %11s %13s\n", "arena", "size",
+         "used", "peak", "pushes/frame");
+  for (u32 i = 0; i < registry->count; ++i) {
+    const De100ArenaRegistryEntry *entry = &registry->entries[i];
+    printf("[MEMORY REPORT] %-24s %8.1f KB %8.1f KB %8.1f KB %6u/%-6u\n",
+           entry->tag, (f64)entry->arena->size / 1024.0,
+           (f64)entry->arena->used / 1024.0, (f64)entry->peak_used / 1024.0,
+           entry->last_frame_pushes, entry->peak_frame_pushes);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENGINE REWIND FRAME
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool engine_rewind_frame(EngineState *engine) {
+  GameMemoryState *memory_state = &engine->platform.memory_state;
+  RewindBuffer *rewind = &memory_state->rewind;
+
+  if (!rewind->is_scrubbing) {
+    return false;
+  }
+
+  // Stepping back under a recording or playback would desync it from the
+  // inputs file
+  if (memory_state->input_recording_index ||
+      memory_state->input_playing_index) {
+    rewind->is_scrubbing = false;
+    return false;
+  }
+
+  // Out of history: hold on the oldest frame until scrubbing stops
+  rewind_step_back(rewind, game_memory_state_committed_size(memory_state));
+
+#if DE100_INTERNAL
+  if (FRAME_LOG_EVERY_ONE_SECONDS_CHECK) {
+    printf("[REWIND] ⏪ %u frames left (%.1f KB of %.1f KB)\n",
+           rewind_frame_count(rewind), (f64)rewind->bytes_used / 1024.0,
+           (f64)rewind->ring_capacity / 1024.0);
+  }
+#endif
+
+  return true;
+}
+
+void engine_toggle_profiler_trace(EnginePlatformState *platform) {
+#if DE100_INTERNAL
+  if (platform->profiler.trace.is_capturing) {
+    de100_profiler_trace_end(&platform->profiler);
+    return;
+  }
+  // Named by frame so a later capture doesn't overwrite this one
+  char path[DE100_PROFILER_TRACE_PATH_MAX];
+  snprintf(path, sizeof(path), "de100-trace-%u.json", g_frame_counter);
+  if (!de100_profiler_trace_begin(&platform->profiler,
+                                  ENGINE_TRACE_KEY_FRAMES, path)) {
+    fprintf(stderr, "[PROFILE] ⚠️  Couldn't start a trace capture\n");
+  }
+#else
+  (void)platform;
+#endif
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENGINE PACE FRAME
+// ═══════════════════════════════════════════════════════════════════════════
+
+PlaybackPacing engine_pace_frame(EngineState *engine) {
+  GameMemoryState *memory_state = &engine->platform.memory_state;
+  FixedTimestep *timestep = &engine->platform.fixed_timestep;
+  GameMemory *memory = &engine->game.memory;
+
+  PlaybackPacing pacing = playback_speed_pace(
+      &memory_state->playback_speed, input_recording_is_playing(memory_state),
+      engine->game.config.target_seconds_per_frame);
+
+  if (!timestep->is_enabled) {
+    // One update per frame, as long as the frame is
+    memory->seconds_per_update = engine->game.config.target_seconds_per_frame;
+    return pacing;
+  }
+
+  // Fast-forward, stepping and seek catch-up decide the update count
+  // themselves: one per advanced frame, wall-clock time doesn't apply
+  if (!pacing.is_realtime || pacing.update_count == 0) {
+    fixed_timestep_reset(timestep, de100_get_wall_clock());
+    memory->interpolation_alpha = 1.0f;
+    return pacing;
+  }
+
+  pacing.update_count =
+      fixed_timestep_advance(timestep, de100_get_wall_clock());
+  memory->interpolation_alpha = fixed_timestep_alpha(timestep);
+  return pacing;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ENGINE SHUTDOWN
 // ═══════════════════════════════════════════════════════════════════════════
@@ -229,8 +811,46 @@ void engine_shutdown(EngineState *engine) {
 
   printf("[SHUTDOWN] Engine cleanup...\n");
 
+  if (engine->game.memory.frame_arena.size > 0) {
+    printf("[SHUTDOWN] Frame arena peak: %.1f KB of %.1f KB (frame %u)\n",
+           (f64)platform->frame_arena_stats.peak_frame_used / 1024.0,
+           (f64)engine->game.memory.frame_arena.size / 1024.0,
+           platform->frame_arena_stats.peak_frame_index);
+  }
+
+  De100MemoryStats memory_stats = de100_memory_get_stats();
+  printf("[SHUTDOWN] Memory: %.1f MB committed (peak %.1f MB) of %.1f MB "
+         "reserved in %u blocks\n",
+         (f64)memory_stats.committed_bytes / (1024.0 * 1024.0),
+         (f64)memory_stats.peak_committed_bytes / (1024.0 * 1024.0),
+         (f64)memory_stats.reserved_bytes / (1024.0 * 1024.0),
+         memory_stats.block_count);
+
+  if (platform->memory_state.rewind.is_enabled) {
+    RewindBuffer *rewind = &platform->memory_state.rewind;
+    printf("[SHUTDOWN] Rewind: %u frames held in %.1f KB, %lu captured, %lu "
+           "too big\n",
+           rewind_frame_count(rewind), (f64)rewind->bytes_used / 1024.0,
+           (unsigned long)rewind->frames_captured,
+           (unsigned long)rewind->frames_dropped_too_big);
+  }
+
+#if DE100_INTERNAL
+  EngineMemoryReport memory_report;
+  engine_memory_report(engine, &memory_report);
+  engine_memory_report_print(engine, &memory_report);
+#endif
+
+#if DE100_INTERNAL
+  de100_profiler_shutdown(&platform->profiler);
+#endif
+  rewind_shutdown(&platform->memory_state.rewind);
+  state_hash_shutdown(&platform->memory_state.state_hash);
+  replay_keyframes_shutdown(&platform->memory_state.keyframes);
+  dirty_pages_shutdown(&platform->memory_state.dirty_pages);
   replay_buffers_shutdown(platform->memory_state.replay_buffers,
                           platform->memory_state.total_size);
+  parallel_copy_shutdown();
 
 #if DE100_SANITIZE_WAVE_1_MEMORY
   // Clean up temp files
@@ -242,6 +862,9 @@ void engine_shutdown(EngineState *engine) {
   if (de100_memory_is_valid(allocations->audio_samples)) {
     de100_memory_free(&allocations->audio_samples);
   }
+  if (de100_memory_is_valid(allocations->frame_arena)) {
+    de100_memory_free(&allocations->frame_arena);
+  }
   if (de100_memory_is_valid(game->backbuffer.memory)) {
     de100_memory_free(&game->backbuffer.memory);
   }
@@ -3,6 +3,7 @@
 #define DE100_ENGINE_H
 
 #include "_common/memory.h"
+#include "_common/profiler.h"
 #include "game/audio.h"
 #include "game/backbuffer.h"
 #include "game/config.h"
@@ -11,6 +12,7 @@
 #include "game/memory.h"
 #include "game/thread.h"
 #include "platforms/_common/config.h"
+#include "platforms/_common/fixed-timestep.h"
 
 // ═══════════════════════════════════════════════════════════════════════════
 // ENGINE STATE
@@ -56,6 +58,49 @@ typedef struct {
 // Used by platform layer. Game code doesn't touch these.
 // ─────────────────────────────────────────────────────────────────────
 
+// ─────────────────────────────────────────────────────────────────────
+// FRAME ARENA STATS
+// ─────────────────────────────────────────────────────────────────────
+// Captured by engine_begin_frame() right before the frame arena is reset,
+// so "last_frame_*" always describes the previous, completed frame.
+// ─────────────────────────────────────────────────────────────────────
+
+typedef struct {
+  u64 last_frame_used;   // Bytes the previous frame pushed (high-water)
+  u32 last_frame_pushes; // Push calls the previous frame made
+  u64 peak_frame_used;   // Worst frame since startup
+  u32 peak_frame_index;  // g_frame_counter of that worst frame
+} EngineFrameArenaStats;
+
+// ─────────────────────────────────────────────────────────────────────
+// MEMORY REPORT
+// ─────────────────────────────────────────────────────────────────────
+// Snapshot of where the engine's memory goes, from engine_memory_report().
+// "resident" comes from mincore(): pages actually backed by RAM (or page
+// cache for replay slot mappings), which is what the game really uses out of
+// what GameConfig asked for.
+// ─────────────────────────────────────────────────────────────────────
+
+#define ENGINE_MEMORY_REPORT_MAX_REGIONS 16
+#define ENGINE_MEMORY_REGION_NAME_MAX 32
+
+typedef struct {
+  char name[ENGINE_MEMORY_REGION_NAME_MAX];
+  u64 reserved_bytes;  // Address space (on-disk size for compressed slots)
+  u64 committed_bytes; // Accessible without faulting
+  u64 resident_bytes;  // Backed by physical memory / page cache
+  bool resident_known; // false where mincore() isn't available
+} EngineMemoryRegion;
+
+typedef struct {
+  EngineMemoryRegion regions[ENGINE_MEMORY_REPORT_MAX_REGIONS];
+  u32 region_count;
+  u64 total_reserved_bytes;
+  u64 total_committed_bytes;
+  u64 total_resident_bytes;
+  De100MemoryStats allocator; // de100_memory_get_stats()
+} EngineMemoryReport;
+
 typedef struct {
   PlatformConfig config;
   GameMainCode game_main_code;
@@ -69,6 +114,14 @@ typedef struct {
   // ← Platform uses for state preservation
   GameInput *old_inputs;
 
+  EngineFrameArenaStats frame_arena_stats;
+
+  // Updates per frame (GameConfig.fixed_update_hz)
+  FixedTimestep fixed_timestep;
+
+  // TIMED_BLOCK call trees (DE100_INTERNAL builds only)
+  De100Profiler profiler;
+
   // Platform-specific extension (X11State*, Win32State*, etc.)
   void *backend;
 } EnginePlatformState;
@@ -76,6 +129,7 @@ typedef struct {
 typedef struct {
   De100MemoryBlock game_state;    // Permanent + Transient
   De100MemoryBlock audio_samples; // Audio sample buffer
+  De100MemoryBlock frame_arena;   // Backing for GameMemory.frame_arena
 } EngineAllocations;
 
 typedef struct {
@@ -126,6 +180,83 @@ int engine_init(EngineState *engine);
  */
 void engine_shutdown(EngineState *engine);
 
+/**
+ * Per-frame engine bookkeeping. Call once per frame, BEFORE polling input.
+ *
+ * - Records the previous frame's frame-arena usage into
+ *   engine->platform.frame_arena_stats
+ * - Resets GameMemory.frame_arena so this frame starts empty
+ * - Samples GameMemory.arena_registry and dumps the memory report every
+ *   GameConfig.memory_report_interval_seconds
+ */
+void engine_begin_frame(EngineState *engine);
+
+/**
+ * Per-update bookkeeping. Call before each update_and_render of the frame
+ * (PlaybackPacing.update_count of them), before recording / playing back
+ * that update's input.
+ *
+ * - Captures the state the previous update left into the rewind history
+ *   (when enabled) and the determinism hash
+ * - From the second update of a frame on: clears button transitions and the
+ *   mouse wheel, so a catch-up update doesn't see the frame's presses twice
+ */
+void engine_begin_update(EngineState *engine, u32 update_index);
+
+/**
+ * Rewind scrubbing. Call after engine_begin_frame, in place of
+ * update_and_render.
+ *
+ * While a game adapter holds rewind_set_scrubbing(&memory_state.rewind, true)
+ * this steps permanent storage back one frame and returns true; the backend
+ * then skips update_and_render so the game doesn't overwrite it. Returns
+ * false (run the frame normally) when not scrubbing, or while recording or
+ * playing back inputs.
+ *
+ * Only split games show the rewound state: engine_render still runs on
+ * presented frames and draws it. A fused game can't draw without updating,
+ * so its screen holds the last frame before scrubbing until it resumes.
+ */
+bool engine_rewind_frame(EngineState *engine);
+
+// Frames one press of the trace debug key captures (~5 s at 60 Hz)
+#define ENGINE_TRACE_KEY_FRAMES 300
+
+/**
+ * Profiler trace debug key (F9 in the X11 and raylib backends): start a
+ * capture of the next ENGINE_TRACE_KEY_FRAMES frames, or end the running
+ * one early and write it (see profiler.h). Does nothing without
+ * DE100_INTERNAL.
+ */
+void engine_toggle_profiler_trace(EnginePlatformState *platform);
+
+/**
+ * Playback speed and fixed timestep for the coming frame (see
+ * playback-speed.h, fixed-timestep.h). Call before engine_begin_frame.
+ * Outside input playback this is always "present, sleep to
+ * target_seconds_per_frame", with one update per frame or, under
+ * GameConfig.fixed_update_hz, as many as are due.
+ *
+ * Sets GameMemory.seconds_per_update / interpolation_alpha. When
+ * pacing.update_count is 0 the frame is held: skip input recording/playback
+ * and update_and_render.
+ */
+PlaybackPacing engine_pace_frame(EngineState *engine);
+
+/**
+ * Measure every engine-owned region (game memory, frame arena, backbuffer,
+ * audio, replay slots, rewind, dirty tracking). Walks page tables, so it
+ * costs ~1 ms per GB of reservation; fine for periodic dumps, not per frame.
+ */
+void engine_memory_report(const EngineState *engine, EngineMemoryReport *out);
+
+/**
+ * Print `report` plus every arena in GameMemory.arena_registry (size, used,
+ * all-time peak, pushes last frame / worst frame).
+ */
+void engine_memory_report_print(const EngineState *engine,
+                                const EngineMemoryReport *report);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ENGINE HELPERS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -143,6 +274,37 @@ de100_file_scoped_fn inline void engine_swap_inputs(EngineState *engine) {
   engine->platform.old_inputs = temp;
 }
 
+/**
+ * Run one game update: game_update, or game_update_and_render for games
+ * without the split (which then also draws).
+ */
+de100_file_scoped_fn inline void engine_update(EngineState *engine) {
+  TIMED_BLOCK("game update");
+  GameMainCode *code = &engine->platform.game_main_code;
+  if (game_main_code_is_split(code)) {
+    code->functions.update(&engine->game.thread_context, &engine->game.memory,
+                           engine->game.inputs);
+  } else {
+    code->functions.update_and_render(
+        &engine->game.thread_context, &engine->game.memory,
+        engine->game.inputs, &engine->game.backbuffer);
+  }
+}
+
+/**
+ * Draw the current state into the backbuffer. Call once per presented
+ * frame, after its updates. No-op without the split: the fused call
+ * already drew.
+ */
+de100_file_scoped_fn inline void engine_render(EngineState *engine) {
+  TIMED_BLOCK("game render");
+  GameMainCode *code = &engine->platform.game_main_code;
+  if (game_main_code_is_split(code)) {
+    code->functions.render(&engine->game.thread_context, &engine->game.memory,
+                           &engine->game.backbuffer);
+  }
+}
+
 /**
  * Check if engine is ready to run.
  */
@@ -0,0 +1,416 @@
+#ifndef DE100_GAME_ARENA_H
+#define DE100_GAME_ARENA_H
+
+#include "../_common/base.h"
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧠 MEMORY ARENA (Linear / Bump Allocator)
+// ═══════════════════════════════════════════════════════════════════════════
+// Casey's Day 34 `memory_arena`, generalised for the engine.
+//
+// An arena is a view over memory somebody else already owns (a slice of
+// GameMemory.permanent_storage, GameMemory.transient_storage, or the engine's
+// per-frame scratch block). Pushing moves a cursor forward; nothing is freed
+// individually. Lifetimes are handled by:
+//
+//   - de100_arena_pop_size()     undo the most recent push(es)
+//   - de100_arena_begin_temp()   checkpoint the cursor...
+//     de100_arena_end_temp()     ...and rewind to it (scoped scratch)
+//   - de100_arena_reset()        drop everything
+//
+// MEMORY LAYOUT:
+// ┌──────────────────────────────────────────────────────────────┐
+// │ base                                              base + size│
+// │ ├── used ──────────────┤                                     │
+// │ [struct A][pad][array B]│<────────── remaining ─────────────>│
+// │                        ↑ cursor                              │
+// │ ├── peak_used ─────────────────────┤ (high-water mark)       │
+// └──────────────────────────────────────────────────────────────┘
+//
+// All functions are static inline so game code can use them without linking
+// against the engine (same rule as audio-helpers.h). The arena never calls
+// malloc; running out of space returns NULL (and asserts in DE100_SLOW
+// builds).
+//
+// ON-DEMAND COMMIT:
+// When the backing block was reserved with De100_MEMORY_FLAG_RESERVE_ONLY only
+// [base, committed_end) is accessible. A push that crosses committed_end calls
+// the arena's `commit` hook, which the engine provides (the game DLL can't
+// call engine functions directly, so it's a function pointer, see
+// GameMemory.commit_transient). Arenas without a hook treat the whole range
+// as committed.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DE100_ARENA_DEFAULT_ALIGNMENT 16
+
+/**
+ * Make [.., required_end) accessible.
+ *
+ * @return The new committed end (>= required_end), or NULL on failure.
+ */
+typedef u8 *de100_arena_commit_fn(void *context, u8 *required_end);
+
+typedef struct {
+  u8 *base;   // First usable byte (not owned by the arena)
+  u64 size;   // Capacity in bytes
+  u64 used;   // Current cursor offset from base
+  u64 peak_used; // High-water mark since init/last de100_arena_clear_peak()
+  u32 push_count; // Pushes since init/last de100_arena_clear_peak()
+  u64 lifetime_push_count; // Pushes since init (never cleared)
+  i32 temp_count; // Open begin_temp() scopes (must be 0 at frame end)
+
+  // On-demand commit (NULL commit = fully committed)
+  de100_arena_commit_fn *commit;
+  void *commit_context;
+  u8 *committed_end; // Cached; pushes below it never call `commit`
+} De100Arena;
+
+/**
+ * Checkpoint returned by de100_arena_begin_temp().
+ * Pass it back to de100_arena_end_temp() to drop everything pushed since.
+ */
+typedef struct {
+  De100Arena *arena;
+  u64 used;
+} De100ArenaTemp;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Init / Reset
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// Usage (game_update_and_render, first frame):
+//   GameState *state = (GameState *)memory->permanent_storage;
+//   de100_arena_init(&state->world_arena,
+//                    (u8 *)memory->permanent_storage + sizeof(GameState),
+//                    memory->permanent_storage_size - sizeof(GameState));
+//
+de100_file_scoped_fn inline void de100_arena_init(De100Arena *arena,
+                                                  void *base, u64 size) {
+  arena->base = (u8 *)base;
+  arena->size = size;
+  arena->used = 0;
+  arena->peak_used = 0;
+  arena->push_count = 0;
+  arena->lifetime_push_count = 0;
+  arena->temp_count = 0;
+  arena->commit = NULL;
+  arena->commit_context = NULL;
+  arena->committed_end = arena->base + size;
+}
+
+/**
+ * Same as de100_arena_init() for memory that is only reserved. `commit` is
+ * called whenever a push goes past what's been committed so far.
+ */
+de100_file_scoped_fn inline void
+de100_arena_init_lazy(De100Arena *arena, void *base, u64 size,
+                      de100_arena_commit_fn *commit, void *commit_context) {
+  de100_arena_init(arena, base, size);
+  if (commit) {
+    arena->commit = commit;
+    arena->commit_context = commit_context;
+    arena->committed_end = arena->base;
+  }
+}
+
+/** Drop everything. Keeps peak_used so the high-water mark survives. */
+de100_file_scoped_fn inline void de100_arena_reset(De100Arena *arena) {
+  DEV_ASSERT_MSG(arena->temp_count == 0,
+                 "arena reset with %d open temp scope(s)", arena->temp_count);
+  arena->used = 0;
+  arena->temp_count = 0;
+}
+
+/** Start a new measurement window for peak_used / push_count. */
+de100_file_scoped_fn inline void de100_arena_clear_peak(De100Arena *arena) {
+  arena->peak_used = arena->used;
+  arena->push_count = 0;
+}
+
+de100_file_scoped_fn inline u64 de100_arena_remaining(const De100Arena *arena) {
+  return arena->size - arena->used;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Push / Pop
+// ─────────────────────────────────────────────────────────────────────────────
+
+/** Bytes needed to move `arena`'s cursor up to `alignment` (power of two). */
+de100_file_scoped_fn inline u64
+de100_arena_alignment_offset(const De100Arena *arena, u64 alignment) {
+  uintptr_t cursor = (uintptr_t)(arena->base + arena->used);
+  uintptr_t mask = (uintptr_t)alignment - 1;
+  return (u64)((alignment - (cursor & mask)) & mask);
+}
+
+/**
+ * Make sure everything below `base + new_used` is committed.
+ * The committed end is cached, so this is one compare on the hot path.
+ */
+de100_file_scoped_fn inline bool de100_arena_ensure_committed(De100Arena *arena,
+                                                              u64 new_used) {
+  u8 *required_end = arena->base + new_used;
+  if (required_end <= arena->committed_end) {
+    return true;
+  }
+  u8 *committed_end = arena->commit(arena->commit_context, required_end);
+  if (!committed_end) {
+    return false;
+  }
+  arena->committed_end = committed_end;
+  return true;
+}
+
+de100_file_scoped_fn inline void *
+de100_arena__push(De100Arena *arena, u64 size, u64 alignment, bool commit) {
+  if (alignment == 0) {
+    alignment = DE100_ARENA_DEFAULT_ALIGNMENT;
+  }
+  DEV_ASSERT_MSG((alignment & (alignment - 1)) == 0,
+                 "arena alignment %llu is not a power of two",
+                 (unsigned long long)alignment);
+
+  u64 offset = de100_arena_alignment_offset(arena, alignment);
+  u64 new_used = arena->used + offset + size;
+
+  if (new_used > arena->size || new_used < arena->used) {
+    DEV_ASSERT_MSG(false, "arena out of space: need %llu, have %llu",
+                   (unsigned long long)(offset + size),
+                   (unsigned long long)de100_arena_remaining(arena));
+    return NULL;
+  }
+
+  if (commit && !de100_arena_ensure_committed(arena, new_used)) {
+    DEV_ASSERT_MSG(false, "arena commit failed for %llu bytes",
+                   (unsigned long long)new_used);
+    return NULL;
+  }
+
+  void *result = arena->base + arena->used + offset;
+  arena->used = new_used;
+  arena->push_count++;
+  arena->lifetime_push_count++;
+  if (arena->used > arena->peak_used) {
+    arena->peak_used = arena->used;
+  }
+  return result;
+}
+
+/**
+ * Reserve `size` bytes aligned to `alignment` (power of two, 0 = default).
+ *
+ * @return Pointer to the (uninitialised) bytes, or NULL if the arena is full
+ *         (or the backing memory could not be committed).
+ *
+ * Note: memory is NOT zeroed; use de100_arena_push_size_zero() for that.
+ */
+de100_file_scoped_fn inline void *
+de100_arena_push_size_aligned(De100Arena *arena, u64 size, u64 alignment) {
+  return de100_arena__push(arena, size, alignment, true);
+}
+
+de100_file_scoped_fn inline void *de100_arena_push_size(De100Arena *arena,
+                                                        u64 size) {
+  return de100_arena_push_size_aligned(arena, size,
+                                       DE100_ARENA_DEFAULT_ALIGNMENT);
+}
+
+de100_file_scoped_fn inline void *de100_arena_push_size_zero(De100Arena *arena,
+                                                             u64 size) {
+  void *result = de100_arena_push_size(arena, size);
+  if (result) {
+    memset(result, 0, (size_t)size);
+  }
+  return result;
+}
+
+/**
+ * Undo the last `size` bytes pushed.
+ *
+ * Only valid when popping in reverse push order; alignment padding that was
+ * inserted before a push is NOT reclaimed (use temp scopes for exact rewind).
+ */
+de100_file_scoped_fn inline void de100_arena_pop_size(De100Arena *arena,
+                                                      u64 size) {
+  DEV_ASSERT_MSG(size <= arena->used, "arena pop of %llu bytes, only %llu used",
+                 (unsigned long long)size, (unsigned long long)arena->used);
+  arena->used = (size <= arena->used) ? (arena->used - size) : 0;
+}
+
+// Typed helpers (Casey's PushStruct / PushArray)
+#define DE100_ARENA_PUSH_STRUCT(arena, Type)                                   \
+  ((Type *)de100_arena_push_size_aligned((arena), sizeof(Type),                \
+                                         _Alignof(Type)))
+#define DE100_ARENA_PUSH_ARRAY(arena, count, Type)                             \
+  ((Type *)de100_arena_push_size_aligned(                                      \
+      (arena), (u64)(count) * sizeof(Type), _Alignof(Type)))
+#define DE100_ARENA_PUSH_STRUCT_ZERO(arena, Type)                              \
+  ((Type *)de100_arena_push_size_zero((arena), sizeof(Type)))
+#define DE100_ARENA_PUSH_ARRAY_ZERO(arena, count, Type)                        \
+  ((Type *)de100_arena_push_size_zero((arena), (u64)(count) * sizeof(Type)))
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Sub-arenas
+// ─────────────────────────────────────────────────────────────────────────────
+// Carve a child arena out of a parent (e.g. a level arena inside transient
+// storage). The child is freed when the parent is reset/popped past it.
+// The child inherits the parent's commit hook, so carving a large sub-arena
+// out of reserved memory doesn't commit it up front.
+//
+de100_file_scoped_fn inline bool de100_arena_sub_arena(De100Arena *parent,
+                                                       De100Arena *child,
+                                                       u64 size) {
+  void *base = de100_arena__push(parent, size, DE100_ARENA_DEFAULT_ALIGNMENT,
+                                 false);
+  if (!base) {
+    return false;
+  }
+  if (parent->commit) {
+    de100_arena_init_lazy(child, base, size, parent->commit,
+                          parent->commit_context);
+  } else {
+    de100_arena_init(child, base, size);
+  }
+  return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Temporary Memory (Casey's BeginTemporaryMemory / EndTemporaryMemory)
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// Usage:
+//   De100ArenaTemp temp = de100_arena_begin_temp(&state->transient_arena);
+//   Path *path = DE100_ARENA_PUSH_ARRAY(temp.arena, 1024, PathNode);
+//   ...
+//   de100_arena_end_temp(temp);
+//
+de100_file_scoped_fn inline De100ArenaTemp
+de100_arena_begin_temp(De100Arena *arena) {
+  De100ArenaTemp result = {.arena = arena, .used = arena->used};
+  arena->temp_count++;
+  return result;
+}
+
+de100_file_scoped_fn inline void de100_arena_end_temp(De100ArenaTemp temp) {
+  De100Arena *arena = temp.arena;
+  DEV_ASSERT_MSG(arena->used >= temp.used,
+                 "arena temp end below checkpoint (used %llu < %llu)",
+                 (unsigned long long)arena->used,
+                 (unsigned long long)temp.used);
+  DEV_ASSERT_MSG(arena->temp_count > 0, "%s", "unbalanced arena temp scope");
+  arena->used = temp.used;
+  arena->temp_count--;
+}
+
+/** Assert no temp scopes are left open (call at end of frame). */
+de100_file_scoped_fn inline void
+de100_arena_check_temp(const De100Arena *arena) {
+  DEV_ASSERT_MSG(arena->temp_count == 0, "arena has %d open temp scope(s)",
+                 arena->temp_count);
+  (void)arena;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tracking (memory instrumentation)
+// ─────────────────────────────────────────────────────────────────────────────
+// Arenas registered here show up in the engine's memory report with their
+// all-time high-water mark and per-frame push counts, so GameConfig sizes can
+// come from data. The registry lives in GameMemory (engine-owned, survives
+// hot reload); the tag is copied because the game DLL's string literals don't
+// survive a reload.
+//
+// Usage (game_update_and_render, first frame):
+//   de100_arena_track(&memory->arena_registry, &state->world_arena, "world");
+//
+// The engine samples the registry once per frame (engine_begin_frame).
+
+#define DE100_ARENA_REGISTRY_MAX 32
+#define DE100_ARENA_TAG_MAX 32
+
+typedef struct {
+  char tag[DE100_ARENA_TAG_MAX];
+  De100Arena *arena;
+  u64 peak_used; // All-time, unlike arena->peak_used
+  u64 last_lifetime_push_count;
+  u32 last_frame_pushes;
+  u32 peak_frame_pushes;
+} De100ArenaRegistryEntry;
+
+typedef struct {
+  De100ArenaRegistryEntry entries[DE100_ARENA_REGISTRY_MAX];
+  u32 count;
+} De100ArenaRegistry;
+
+/**
+ * Start reporting `arena` under `tag`. Tracking the same arena again just
+ * renames it. Returns false when the registry is full.
+ */
+de100_file_scoped_fn inline bool de100_arena_track(De100ArenaRegistry *registry,
+                                                   De100Arena *arena,
+                                                   const char *tag) {
+  De100ArenaRegistryEntry *entry = NULL;
+  for (u32 i = 0; i < registry->count; ++i) {
+    if (registry->entries[i].arena == arena) {
+      entry = &registry->entries[i];
+      break;
+    }
+  }
+  if (!entry) {
+    if (registry->count >= DE100_ARENA_REGISTRY_MAX) {
+      return false;
+    }
+    entry = &registry->entries[registry->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->arena = arena;
+    entry->last_lifetime_push_count = arena->lifetime_push_count;
+  }
+
+  u32 len = 0;
+  for (; tag && tag[len] && len < DE100_ARENA_TAG_MAX - 1; ++len) {
+    entry->tag[len] = tag[len];
+  }
+  entry->tag[len] = '\0';
+  return true;
+}
+
+de100_file_scoped_fn inline void
+de100_arena_untrack(De100ArenaRegistry *registry, De100Arena *arena) {
+  for (u32 i = 0; i < registry->count; ++i) {
+    if (registry->entries[i].arena == arena) {
+      registry->entries[i] = registry->entries[--registry->count];
+      return;
+    }
+  }
+}
+
+/**
+ * Fold one frame of activity into every entry. Call once per frame, BEFORE
+ * anything clears an arena's peak (the engine does this for the frame
+ * arena).
+ */
+de100_file_scoped_fn inline void
+de100_arena_registry_sample(De100ArenaRegistry *registry) {
+  for (u32 i = 0; i < registry->count; ++i) {
+    De100ArenaRegistryEntry *entry = &registry->entries[i];
+    const De100Arena *arena = entry->arena;
+
+    if (arena->peak_used > entry->peak_used) {
+      entry->peak_used = arena->peak_used;
+    }
+
+    // Lifetime count only goes down when the arena was re-initialised
+    u64 pushes = arena->lifetime_push_count >= entry->last_lifetime_push_count
+                     ? arena->lifetime_push_count -
+                           entry->last_lifetime_push_count
+                     : arena->lifetime_push_count;
+    entry->last_lifetime_push_count = arena->lifetime_push_count;
+    entry->last_frame_pushes = pushes > 0xFFFFFFFFu ? 0xFFFFFFFFu : (u32)pushes;
+    if (entry->last_frame_pushes > entry->peak_frame_pushes) {
+      entry->peak_frame_pushes = entry->last_frame_pushes;
+    }
+  }
+}
+
+#endif // DE100_GAME_ARENA_H
@@ -10,6 +10,16 @@ GameConfig get_default_game_config(void) {
 
   config.permanent_storage_size = MEGABYTES(64);
   config.transient_storage_size = GIGABYTES(1);
+  config.frame_arena_size = MEGABYTES(8);
+  config.prefer_lazy_transient_commit = false;
+  config.allow_write_fault_dirty_tracking = false;
+  config.compress_replay_slots = false;
+  config.snapshot_copy_threads = 0;
+  config.memory_report_interval_seconds = 0;
+  config.rewind_budget_size = 0;
+  config.rewind_region_size = 0;
+  config.check_replay_determinism = true;
+  config.replay_keyframe_interval_seconds = 5.0f;
 
   /* =========================
      GAME / BUILD FLAGS
@@ -29,6 +39,7 @@ GameConfig get_default_game_config(void) {
   config.prefer_borderless = false;
   config.prefer_resizable = true;
   config.prefer_adaptive_fps = false;
+  config.prefer_pipelined_present = false;
 
   strncpy(config.window_title, "DE100", sizeof(config.window_title) - 1);
   config.window_title[sizeof(config.window_title) - 1] = '\0';
@@ -53,6 +64,8 @@ GameConfig get_default_game_config(void) {
 
   config.target_seconds_per_frame =
       1.0f / (f32)config.max_allowed_refresh_rate_hz;
+  config.fixed_update_hz = 0;
+  config.max_updates_per_frame = 5;
 
   return config;
 }
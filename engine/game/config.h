@@ -24,6 +24,60 @@ typedef struct {
    * in bytes */
   u64 transient_storage_size;
 
+  /** Size of the per-frame scratch arena (GameMemory.frame_arena) in bytes.
+   * Reset by the engine every frame. 0 disables it. */
+  u64 frame_arena_size;
+
+  /** Reserve transient storage instead of committing it up front. Pages are
+   * committed in DE100_MEMORY_COMMIT_CHUNK_SIZE steps as arenas created with
+   * game_memory_init_transient_arena() grow. Raw writes into
+   * transient_storage past what an arena has pushed will fault. */
+  bool prefer_lazy_transient_commit;
+
+  /** When the kernel has no soft-dirty bits, track snapshot dirty pages with
+   * mprotect + SIGSEGV instead (see platforms/_common/dirty-pages.h).
+   * Off by default: syscalls that write into game memory then fail with
+   * EFAULT. Without either, replay snapshots copy all of game memory. */
+  bool allow_write_fault_dirty_tracking;
+
+  /** Store replay slots as sparse, LZ-compressed files instead of full-size
+   * memory-mapped ones. Slots then cost roughly the game's non-zero memory
+   * (usually a few MB) instead of total game memory each; saves/restores
+   * trade some CPU for that (see platforms/_common/replay-buffer.h). */
+  bool compress_replay_slots;
+
+  /** Threads that split big replay snapshot copies (calling thread
+   * included). 0 = one per core (max 8), 1 = single-threaded. The null
+   * backend's DE100_NULL_BENCH_SNAPSHOT_COPY=1 prints a serial vs parallel
+   * copy benchmark with this setting. */
+  u32 snapshot_copy_threads;
+
+  /** Print the engine memory report (regions, resident pages, tracked
+   * arenas) every N seconds. 0 = only at shutdown (internal builds). */
+  u32 memory_report_interval_seconds;
+
+  /** Bytes of history for frame-by-frame rewind (0 = disabled). Each frame
+   * stores only the 8-byte words of permanent storage that changed, so a few
+   * MB usually holds many seconds. Also costs one copy of the rewound region
+   * (see platforms/_common/rewind.h). */
+  u64 rewind_budget_size;
+  /** Leading bytes of permanent storage that rewind tracks (0 = all of it). */
+  u64 rewind_region_size;
+
+  /** Hash permanent storage every frame while recording (stored next to the
+   * inputs) and playing back (compared), reporting the first frame where
+   * playback diverges. Only pages written since the previous frame are
+   * rehashed (see platforms/_common/state-hash.h). Without a dirty page
+   * tracker that would be all of permanent storage every frame, so the
+   * check then stays off above STATE_HASH_UNTRACKED_MAX_SIZE (8 MB). */
+  bool check_replay_determinism;
+
+  /** Seconds between game memory keyframes while recording inputs (0 =
+   * none). Playback can then seek anywhere by restoring the nearest
+   * keyframe and simulating at most this long (see
+   * platforms/_common/replay-keyframes.h). */
+  f32 replay_keyframe_interval_seconds;
+
   /* =========================
      GAME / BUILD FLAGS
      ========================= */
@@ -64,6 +118,12 @@ typedef struct {
   /** Request adaptive frame pacing if possible */
   bool prefer_adaptive_fps;
 
+  /** Present on a separate thread if possible (X11): the game builds frame
+   * N+1 while frame N uploads and swaps, so a frame costs max(update,
+   * present) instead of their sum. The game then draws into one of two
+   * backbuffers in turn, so each frame must redraw the whole buffer. */
+  bool prefer_pipelined_present;
+
   /* =========================
      INPUT REQUIREMENTS
      ========================= */
@@ -91,6 +151,15 @@ typedef struct {
   /** Desired simulation timestep in seconds per frame */
   float target_seconds_per_frame;
 
+  /** Run game updates at a fixed rate, independent of the display rate and
+   * of adaptive FPS (0 = one update per displayed frame). Frames then run
+   * 0..max_updates_per_frame updates and pass the leftover fraction as
+   * GameMemory.interpolation_alpha (see
+   * platforms/_common/fixed-timestep.h). */
+  u32 fixed_update_hz;
+  /** Catch-up limit after a slow frame; time owed beyond it is dropped. */
+  u32 max_updates_per_frame;
+
   char window_title[64];
 
 } GameConfig;
@@ -165,12 +165,32 @@ int load_game_main_code(GameMainCode *game_code,
 
   printf("🔍 Loading symbols...\n");
 
-  // Load UpdateAndRender
+  // Optional Update / Render split (only used as a pair)
+  game_update_t *update = (game_update_t *)de100_dll_sym(
+      &stub_game_code.meta.code_lib, "game_update");
+  game_render_t *render = (game_render_t *)de100_dll_sym(
+      &stub_game_code.meta.code_lib, "game_render");
+
+  if (update && render) {
+    stub_game_code.functions.update = update;
+    stub_game_code.functions.render = render;
+    printf("   ✓ game_update: %p\n", (void *)update);
+    printf("   ✓ game_render: %p\n", (void *)render);
+  } else if (update || render) {
+    fprintf(stderr, "⚠️  '%s' exported without '%s', ignoring it\n",
+            update ? "game_update" : "game_render",
+            update ? "game_render" : "game_update");
+  }
+
+  // Load UpdateAndRender (optional with the split pair)
   stub_game_code.functions.update_and_render =
       (game_update_and_render_t *)de100_dll_sym(&stub_game_code.meta.code_lib,
                                                 "game_update_and_render");
 
-  if (!stub_game_code.functions.update_and_render) {
+  if (!stub_game_code.functions.update_and_render &&
+      game_main_code_is_split(&stub_game_code)) {
+    stub_game_code.functions.update_and_render = game_update_and_render_stub;
+  } else if (!stub_game_code.functions.update_and_render) {
     fprintf(stderr, "❌ Failed to load symbol 'game_update_and_render'\n");
     fprintf(stderr, "   Library: %s\n",
             temp_lib_name); // Changed back to temp_lib_name
@@ -185,8 +205,11 @@ int load_game_main_code(GameMainCode *game_code,
     return 1;
   }
 
-  printf("   ✓ game_update_and_render: %p\n",
-         (void *)stub_game_code.functions.update_and_render);
+  if (stub_game_code.functions.update_and_render !=
+      game_update_and_render_stub) {
+    printf("   ✓ game_update_and_render: %p\n",
+           (void *)stub_game_code.functions.update_and_render);
+  }
 
   // Load GetSoundSamples
   stub_game_code.functions.get_audio_samples =
@@ -218,6 +241,9 @@ int load_game_main_code(GameMainCode *game_code,
   stub_game_code.is_valid = true;
 
   printf("✅ Game main code loaded successfully!\n");
+  if (game_main_code_is_split(&stub_game_code)) {
+    printf("   update / render: split (render only presented frames)\n");
+  }
   printf("   update_and_render: %p %s\n",
          (void *)stub_game_code.functions.update_and_render,
          stub_game_code.functions.update_and_render ==
@@ -318,6 +344,8 @@ void unload_game_main_code(GameMainCode *game_code) {
     game_code->is_valid = false;
     game_code->functions.update_and_render = game_update_and_render_stub;
     game_code->functions.get_audio_samples = game_get_audio_samples_stub;
+    game_code->functions.update = NULL;
+    game_code->functions.render = NULL;
     game_code->meta.code_lib.handle = NULL;
     return;
   }
@@ -339,6 +367,8 @@ void unload_game_main_code(GameMainCode *game_code) {
   game_code->is_valid = false;
   game_code->functions.update_and_render = game_update_and_render_stub;
   game_code->functions.get_audio_samples = game_get_audio_samples_stub;
+  game_code->functions.update = NULL;
+  game_code->functions.render = NULL;
   game_code->meta.code_lib.handle = NULL;
 
   printf("✅ Game code reset to stub functions\n");
@@ -102,6 +102,22 @@ typedef GAME_INIT(game_init_t);
             GameInput *inputs, GameBackBuffer *buffer)
 typedef GAME_UPDATE_AND_RENDER(game_update_and_render_t);
 
+// Optional split of GAME_UPDATE_AND_RENDER. A game exporting both gets one
+// game_update per simulation step and one game_render per presented frame
+// (none for catch-up updates, fast-forwarded or headless frames; one even
+// on frames without an update, for GameMemory.interpolation_alpha).
+// game_render must not write game memory: replays and their determinism
+// hashes only account for game_update.
+#define GAME_UPDATE(name)                                                      \
+  void name(ThreadContext *thread_context, GameMemory *memory,                 \
+            GameInput *inputs)
+typedef GAME_UPDATE(game_update_t);
+
+#define GAME_RENDER(name)                                                      \
+  void name(ThreadContext *thread_context, GameMemory *memory,                 \
+            GameBackBuffer *buffer)
+typedef GAME_RENDER(game_render_t);
+
 // Called to fill audio buffer - may be called multiple times per frame
 #define GAME_GET_AUDIO_SAMPLES(name)                                           \
   void name(GameMemory *memory, GameAudioOutputBuffer *audio_buffer)
@@ -132,6 +148,9 @@ typedef struct {
   struct {
     game_update_and_render_t *update_and_render;
     game_get_audio_samples_t *get_audio_samples;
+    // Both set or both NULL (then update_and_render does both)
+    game_update_t *update;
+    game_render_t *render;
   } functions;
 } GameMainCode;
 
@@ -147,6 +166,12 @@ typedef struct {
 // API FUNCTIONS
 // ═══════════════════════════════════════════════════════════════════════════
 
+/** The game exports game_update + game_render (see GAME_UPDATE). */
+de100_file_scoped_fn inline bool
+game_main_code_is_split(const GameMainCode *game_code) {
+  return game_code->functions.update && game_code->functions.render;
+}
+
 /**
  * Load game code from a dynamic library.
  *
@@ -160,6 +185,9 @@ typedef struct {
  *
  * Never exits or crashes - always returns a valid GameCode structure.
  * On error, uses stub functions and sets is_valid to false.
+ *
+ * game_update + game_render are used when both are exported;
+ * game_update_and_render is then optional.
  */
 int load_game_main_code(GameMainCode *game_code,
                         GameCodePaths *game_code_paths);
@@ -2,7 +2,15 @@
 #define DE100_GAME_De100_MEMORY_H
 
 #include "../_common/memory.h"
+#include "../_common/profiler.h"
+#include "../platforms/_common/input-stream.h"
+#include "../platforms/_common/playback-speed.h"
+#include "../platforms/_common/replay-keyframes.h"
 #include "../platforms/_common/replay-buffer.h"
+#include "../platforms/_common/rewind.h"
+#include "../platforms/_common/state-hash.h"
+#include "arena.h"
+#include "pool.h"
 #include <stdint.h>
 
 // ═══════════════════════════════════════════════════════════════
@@ -26,11 +34,18 @@
 // └─────────────────────────────────────────────────────────────┘
 // ┌─────────────────────────────────────────────────────────────┐
 // │ TransientStorage (4GB)                                      │
+// │ (reserved-only + committed on demand when                   │
+// │  GameConfig.prefer_lazy_transient_commit is set)            │
 // │ [Ready for:]                                                │
 // │ - Level geometry                                            │
 // │ - Particle systems                                          │
 // │ - Temporary buffers                                         │
 // └─────────────────────────────────────────────────────────────┘
+// ┌─────────────────────────────────────────────────────────────┐
+// │ Frame Arena (8MB, separate engine block)                    │
+// │ - Reset by the engine at the start of every frame           │
+// │ - NOT part of replay snapshots (scratch only)               │
+// └─────────────────────────────────────────────────────────────┘
 // ═══════════════════════════════════════════════════════════════
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -68,10 +83,53 @@ typedef struct {
   u64 permanent_storage_size;
   // Size of the temporary storage block in bytes
   u64 transient_storage_size;
+  // Per-frame scratch arena. The engine resets it before every
+  // `game_update_and_render`, so anything pushed here is only valid until
+  // the end of the current frame (update + audio). Never store pointers into
+  // it in permanent storage!
+  De100Arena frame_arena;
+  // Set when transient storage is only reserved
+  // (GameConfig.prefer_lazy_transient_commit). Arenas over transient storage
+  // must go through game_memory_init_transient_arena() so their pushes commit
+  // pages on demand. NULL = transient storage is fully committed.
+  de100_arena_commit_fn *commit_transient;
+  void *commit_context;
+  // Arenas the game wants in the engine's memory report (see
+  // de100_arena_track()). The engine registers frame_arena itself.
+  De100ArenaRegistry arena_registry;
+  // Simulated time one `game_update_and_render` call advances:
+  // 1 / GameConfig.fixed_update_hz, or target_seconds_per_frame when fixed
+  // updates are off. A frame may make several calls (catching up) or none.
+  f32 seconds_per_update;
+  // How far the displayed moment lies past the last update, in updates
+  // (0..1). Render lerp(previous, current, alpha) to stay smooth when the
+  // display and update rates differ. Always 1 without fixed updates.
+  f32 interpolation_alpha;
+  // The engine's TIMED_BLOCK profiler (NULL outside DE100_INTERNAL builds).
+  // Point the game library's own g_de100_profiler at it every update.
+  De100Profiler *profiler;
   // Has this memory been initialized?
   bool32 is_initialized;
 } GameMemory;
 
+/**
+ * Init `arena` over [transient_storage + offset, +size), wiring the on-demand
+ * commit hook when transient storage is only reserved.
+ *
+ * Usage (game_update_and_render, first frame):
+ *   game_memory_init_transient_arena(memory, &state->transient_arena, 0,
+ *                                    memory->transient_storage_size);
+ */
+de100_file_scoped_fn inline void
+game_memory_init_transient_arena(GameMemory *memory, De100Arena *arena,
+                                 u64 offset, u64 size) {
+  DEV_ASSERT_MSG(offset + size <= memory->transient_storage_size,
+                 "transient arena [%llu, +%llu) is out of range",
+                 (unsigned long long)offset, (unsigned long long)size);
+  de100_arena_init_lazy(arena, (u8 *)memory->transient_storage + offset, size,
+                        memory->commit_transient, memory->commit_context);
+}
+
 typedef struct GameState GameState;
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -90,6 +148,9 @@ typedef struct {
   // ─────────────────────────────────────────────────────────────────────
   u64 total_size;    // permanent_storage_size + transient_storage_size
   void *game_memory; // Pointer to the allocated game memory block
+  // Backing block. With lazy transient commit only the first
+  // committed_size bytes are accessible, so snapshots stop there.
+  const De100MemoryBlock *game_memory_block;
 
   // ─────────────────────────────────────────────────────────────────────
   // REPLAY BUFFERS (Day 25 - Memory Mapped)
@@ -99,17 +160,57 @@ typedef struct {
   // ─────────────────────────────────────────────────────────────────────
   ReplayBuffer replay_buffers[MAX_REPLAY_BUFFERS];
 
+  // Pages written since each slot was last in sync with game memory, so
+  // save/restore only copy what the game touched (see dirty-pages.h).
+  DirtyPageTracker dirty_pages;
+
+  // Frame-by-frame history of permanent storage (disabled unless
+  // GameConfig.rewind_budget_size is set). Game adapters drive it with
+  // rewind_set_scrubbing().
+  RewindBuffer rewind;
+
+  // Per-frame fingerprint of permanent storage. Recording stores it next to
+  // the inputs, playback checks it (GameConfig.check_replay_determinism).
+  StateHash state_hash;
+
+  // Periodic snapshots written while recording, read to seek during
+  // playback (GameConfig.replay_keyframe_interval_seconds).
+  ReplayKeyframes keyframes;
+
   // ─────────────────────────────────────────────────────────────────────
   // INPUT RECORDING STATE
   // ─────────────────────────────────────────────────────────────────────
-  i32 recording_fd; // File descriptor for input events (-1 = not recording)
+  // Build/frame-rate facts stamped into every recording's header
+  InputStreamInfo stream_info;
+
+  InputStream recording_stream; // Input events being recorded
   i32 input_recording_index; // 0 = not recording, N = recording to slot N
+  i32 recording_hash_fd;     // Per-frame state hashes (-1 = none)
+  AsyncWriter recording_hash_writer; // Queues them off the game thread
 
   // ─────────────────────────────────────────────────────────────────────
   // INPUT PLAYBACK STATE
   // ─────────────────────────────────────────────────────────────────────
-  i32 playback_fd; // File descriptor for input events (-1 = not playing)
+  InputStream playback_stream; // Input events being played back
+  PlaybackSpeed playback_speed; // Set by game adapters, see playback-speed.h
   i32 input_playing_index; // 0 = not playing, N = playing from slot N
+  i32 playback_hash_fd;    // Recorded state hashes (-1 = none to check)
+  u64 playback_hash_frame; // Frames checked since the last restore
+  i64 pending_seek_frame;  // input_recording_playback_seek target, -1 = none
+  // First frame (since playback began) whose state differed from the
+  // recording, -1 = none so far
+  i64 first_divergent_frame;
+  u64 divergent_frame_count;
 } GameMemoryState;
 
+/** Bytes of game memory that currently hold data (what a snapshot copies). */
+de100_file_scoped_fn inline u64
+game_memory_state_committed_size(const GameMemoryState *state) {
+  if (state->game_memory_block &&
+      state->game_memory_block->committed_size < state->total_size) {
+    return state->game_memory_block->committed_size;
+  }
+  return state->total_size;
+}
+
 #endif // DE100_GAME_De100_MEMORY_H
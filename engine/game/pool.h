@@ -0,0 +1,324 @@
+#ifndef DE100_GAME_POOL_H
+#define DE100_GAME_POOL_H
+
+#include "../_common/base.h"
+#include "../_common/memory.h"
+#include "arena.h"
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧱 POOL ALLOCATOR (Fixed-size slots + generational handles)
+// ═══════════════════════════════════════════════════════════════════════════
+// For things that come and go every frame (entities, projectiles,
+// particles). Replaces "fixed array + swap-remove compaction pass":
+//
+//   - alloc/free are O(1) (free list threaded through `sparse`)
+//   - items never move, so pointers stay valid until the item is freed
+//   - `dense` lists live slots contiguously for iteration
+//   - handles carry a generation, so a handle to a freed (or freed and
+//     reused) slot is detected instead of silently aliasing a new item
+//
+// HANDLE LAYOUT (32 bits):
+// ┌──────────────────────┬──────────────────────┐
+// │ generation (16 bits) │ slot + 1 (16 bits)   │  0 = null handle
+// └──────────────────────┴──────────────────────┘
+//
+// PER-SLOT STATE:
+//   generations[slot]  odd = live, even = free (bumped on alloc AND free)
+//   sparse[slot]       live: position in dense[] / free: next free slot
+//   dense[i]           slot of the i-th live item (i < count)
+//
+// BACKING MEMORY:
+//   de100_pool_init()        pushes everything onto an arena (game code)
+//   de100_pool_init_block()  lays the pool out in a De100MemoryBlock and
+//                            remembers block.generation; a realloc of the
+//                            block (which moves it) is caught by a
+//                            DEV_ASSERT on the next access.
+//
+// Header-only for the same reason as arena.h: the game DLL uses it without
+// linking against the engine.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifndef DE100_POOL_INDEX_BITS
+#define DE100_POOL_INDEX_BITS 16
+#endif
+
+#define DE100_POOL_INDEX_MASK ((1u << DE100_POOL_INDEX_BITS) - 1)
+#define DE100_POOL_GENERATION_MASK ((1u << (32 - DE100_POOL_INDEX_BITS)) - 1)
+// slot + 1 is stored, so the all-ones index is unusable
+#define DE100_POOL_MAX_CAPACITY (DE100_POOL_INDEX_MASK - 1)
+#define DE100_POOL_NULL_HANDLE 0u
+#define DE100_POOL_NO_SLOT 0xFFFFFFFFu
+
+typedef u32 De100PoolHandle;
+
+typedef struct {
+  u8 *slots;        // capacity * slot_size bytes
+  u32 *generations; // Per slot, odd = live
+  u32 *sparse;      // Per slot, dense position (live) / next free (free)
+  u32 *dense;       // Live slots, [0, count)
+
+  u32 slot_size; // Bytes per slot (rounded to DE100_ARENA_DEFAULT_ALIGNMENT)
+  u32 capacity;
+  u32 count;     // Live items
+  u32 free_head; // First free slot, DE100_POOL_NO_SLOT when full
+
+  // Set by de100_pool_init_block() only
+  const De100MemoryBlock *block;
+  u32 block_generation;
+} De100Pool;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Handles
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u32 de100_pool_handle_slot(De100PoolHandle handle) {
+  return (handle & DE100_POOL_INDEX_MASK) - 1;
+}
+
+de100_file_scoped_fn inline u32
+de100_pool_handle_generation(De100PoolHandle handle) {
+  return handle >> DE100_POOL_INDEX_BITS;
+}
+
+de100_file_scoped_fn inline De100PoolHandle
+de100_pool_make_handle(u32 slot, u32 generation) {
+  return ((generation & DE100_POOL_GENERATION_MASK) << DE100_POOL_INDEX_BITS) |
+         (slot + 1);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Init
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline u32 de100_pool_aligned_slot_size(u32 slot_size) {
+  u32 align = DE100_ARENA_DEFAULT_ALIGNMENT;
+  return (slot_size + align - 1) & ~(align - 1);
+}
+
+/** Bytes de100_pool_init_block() needs for `capacity` slots of `slot_size`. */
+de100_file_scoped_fn inline u64 de100_pool_required_size(u32 slot_size,
+                                                         u32 capacity) {
+  u64 slots = (u64)de100_pool_aligned_slot_size(slot_size) * capacity;
+  u64 tables = (u64)capacity * sizeof(u32) * 3;
+  return slots + tables;
+}
+
+/** Lay the pool out over `memory` (already sized by required_size). */
+de100_file_scoped_fn inline void de100_pool__layout(De100Pool *pool, u8 *memory,
+                                                    u32 slot_size,
+                                                    u32 capacity) {
+  pool->slot_size = de100_pool_aligned_slot_size(slot_size);
+  pool->capacity = capacity;
+  pool->slots = memory;
+
+  u32 *tables = (u32 *)(memory + (u64)pool->slot_size * capacity);
+  pool->generations = tables;
+  pool->sparse = tables + capacity;
+  pool->dense = tables + 2 * (u64)capacity;
+
+  // Free list in slot order so the first allocs are cache-adjacent
+  for (u32 slot = 0; slot < capacity; ++slot) {
+    pool->generations[slot] = 0;
+    pool->sparse[slot] = (slot + 1 < capacity) ? slot + 1 : DE100_POOL_NO_SLOT;
+  }
+  pool->free_head = capacity ? 0 : DE100_POOL_NO_SLOT;
+  pool->count = 0;
+  pool->block = NULL;
+  pool->block_generation = 0;
+}
+
+/**
+ * Carve a pool for `capacity` items of `slot_size` bytes out of `arena`.
+ *
+ * Usage (game init):
+ *   DE100_POOL_INIT(&state->creeps, &state->world_arena, Creep, 256);
+ */
+de100_file_scoped_fn inline bool de100_pool_init(De100Pool *pool,
+                                                 De100Arena *arena,
+                                                 u32 slot_size, u32 capacity) {
+  DEV_ASSERT_MSG(capacity <= DE100_POOL_MAX_CAPACITY,
+                 "pool capacity %u exceeds %u", capacity,
+                 (u32)DE100_POOL_MAX_CAPACITY);
+  if (capacity > DE100_POOL_MAX_CAPACITY || slot_size == 0) {
+    return false;
+  }
+
+  u8 *memory = (u8 *)de100_arena_push_size(
+      arena, de100_pool_required_size(slot_size, capacity));
+  if (!memory) {
+    return false;
+  }
+
+  de100_pool__layout(pool, memory, slot_size, capacity);
+  return true;
+}
+
+/**
+ * Lay the pool out at the start of `block` and tie it to the block's
+ * generation. Returns false if the block is too small.
+ */
+de100_file_scoped_fn inline bool
+de100_pool_init_block(De100Pool *pool, const De100MemoryBlock *block,
+                      u32 slot_size, u32 capacity) {
+  if (!block || !block->is_valid || capacity > DE100_POOL_MAX_CAPACITY ||
+      slot_size == 0 ||
+      de100_pool_required_size(slot_size, capacity) > block->committed_size) {
+    return false;
+  }
+
+  de100_pool__layout(pool, (u8 *)block->base, slot_size, capacity);
+  pool->block = block;
+  pool->block_generation = block->generation;
+  return true;
+}
+
+#define DE100_POOL_INIT(pool, arena, Type, capacity)                           \
+  de100_pool_init((pool), (arena), (u32)sizeof(Type), (u32)(capacity))
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Alloc / Free / Lookup
+// ─────────────────────────────────────────────────────────────────────────────
+
+de100_file_scoped_fn inline void de100_pool_check_block(const De100Pool *pool) {
+  DEV_ASSERT_MSG(!pool->block ||
+                     pool->block->generation == pool->block_generation,
+                 "pool backing block was reallocated (generation %u -> %u)",
+                 pool->block_generation,
+                 pool->block ? pool->block->generation : 0);
+  (void)pool;
+}
+
+de100_file_scoped_fn inline void *de100_pool_slot_ptr(const De100Pool *pool,
+                                                      u32 slot) {
+  return pool->slots + (u64)slot * pool->slot_size;
+}
+
+/**
+ * Take a free slot. The slot is zeroed.
+ *
+ * @param out_handle  Receives the item's handle (may be NULL)
+ * @return            Pointer to the item, or NULL when the pool is full
+ */
+de100_file_scoped_fn inline void *de100_pool_alloc(De100Pool *pool,
+                                                   De100PoolHandle *out_handle) {
+  de100_pool_check_block(pool);
+
+  u32 slot = pool->free_head;
+  if (slot == DE100_POOL_NO_SLOT) {
+    if (out_handle) {
+      *out_handle = DE100_POOL_NULL_HANDLE;
+    }
+    return NULL;
+  }
+
+  pool->free_head = pool->sparse[slot];
+  pool->generations[slot]++; // even -> odd (live)
+  pool->sparse[slot] = pool->count;
+  pool->dense[pool->count++] = slot;
+
+  void *item = de100_pool_slot_ptr(pool, slot);
+  memset(item, 0, pool->slot_size);
+
+  if (out_handle) {
+    *out_handle = de100_pool_make_handle(slot, pool->generations[slot]);
+  }
+  return item;
+}
+
+/** Is `handle` still pointing at the item it was created for? */
+de100_file_scoped_fn inline bool de100_pool_is_live(const De100Pool *pool,
+                                                    De100PoolHandle handle) {
+  u32 slot = de100_pool_handle_slot(handle);
+  if (handle == DE100_POOL_NULL_HANDLE || slot >= pool->capacity) {
+    return false;
+  }
+  u32 generation = pool->generations[slot];
+  return (generation & 1u) &&
+         (generation & DE100_POOL_GENERATION_MASK) ==
+             de100_pool_handle_generation(handle);
+}
+
+/** Item for `handle`, or NULL if it was freed (stale handle). */
+de100_file_scoped_fn inline void *de100_pool_get(const De100Pool *pool,
+                                                 De100PoolHandle handle) {
+  de100_pool_check_block(pool);
+  if (!de100_pool_is_live(pool, handle)) {
+    return NULL;
+  }
+  return de100_pool_slot_ptr(pool, de100_pool_handle_slot(handle));
+}
+
+/**
+ * Return an item to the pool. Stale handles are ignored (returns false).
+ *
+ * The last dense entry is swapped into the freed position, so when freeing
+ * while iterating, walk dense[] backwards.
+ */
+de100_file_scoped_fn inline bool de100_pool_free(De100Pool *pool,
+                                                 De100PoolHandle handle) {
+  de100_pool_check_block(pool);
+  if (!de100_pool_is_live(pool, handle)) {
+    return false;
+  }
+
+  u32 slot = de100_pool_handle_slot(handle);
+  u32 position = pool->sparse[slot];
+  u32 last_slot = pool->dense[--pool->count];
+  pool->dense[position] = last_slot;
+  pool->sparse[last_slot] = position;
+
+  pool->generations[slot]++; // odd -> even (free)
+  pool->sparse[slot] = pool->free_head;
+  pool->free_head = slot;
+  return true;
+}
+
+/** Free everything. Every outstanding handle becomes stale. */
+de100_file_scoped_fn inline void de100_pool_clear(De100Pool *pool) {
+  de100_pool_check_block(pool);
+  for (i32 i = (i32)pool->count - 1; i >= 0; --i) {
+    u32 slot = pool->dense[i];
+    pool->generations[slot]++;
+    pool->sparse[slot] = pool->free_head;
+    pool->free_head = slot;
+  }
+  pool->count = 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dense iteration
+// ─────────────────────────────────────────────────────────────────────────────
+//
+// Usage:
+//   De100Pool *creeps = &state->creeps;
+//   for (i32 i = (i32)creeps->count - 1; i >= 0; --i) {
+//     Creep *creep = DE100_POOL_AT(creeps, i, Creep);
+//     if (creep->hp <= 0) {
+//       de100_pool_free(creeps, de100_pool_handle_at(creeps, i));
+//     }
+//   }
+//
+
+de100_file_scoped_fn inline void *de100_pool_at(const De100Pool *pool,
+                                                u32 dense_index) {
+  DEV_ASSERT_MSG(dense_index < pool->count, "pool index %u out of %u",
+                 dense_index, pool->count);
+  return de100_pool_slot_ptr(pool, pool->dense[dense_index]);
+}
+
+de100_file_scoped_fn inline De100PoolHandle
+de100_pool_handle_at(const De100Pool *pool, u32 dense_index) {
+  u32 slot = pool->dense[dense_index];
+  return de100_pool_make_handle(slot, pool->generations[slot]);
+}
+
+#define DE100_POOL_ALLOC(pool, out_handle, Type)                               \
+  ((Type *)de100_pool_alloc((pool), (out_handle)))
+#define DE100_POOL_GET(pool, handle, Type)                                     \
+  ((Type *)de100_pool_get((pool), (handle)))
+#define DE100_POOL_AT(pool, dense_index, Type)                                 \
+  ((Type *)de100_pool_at((pool), (dense_index)))
+
+#endif // DE100_GAME_POOL_H
@@ -0,0 +1,243 @@
+#include "./async-writer.h"
+#include "../../_common/file.h"
+#include "../../_common/time.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RING
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u64 round_up_pow2(u64 value) {
+  u64 result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+#if !defined(_WIN32)
+
+/** Write ring bytes [from, to) to the fd (at most two calls at the wrap). */
+de100_file_scoped_fn bool drain_range(AsyncWriter *writer, u64 from, u64 to) {
+  while (from < to) {
+    u64 index = from & writer->mask;
+    u64 chunk = to - from;
+    if (chunk > writer->capacity - index) {
+      chunk = writer->capacity - index;
+    }
+    if (!de100_file_write_all(writer->fd, writer->ring + index, (size_t)chunk)
+             .success) {
+      return false;
+    }
+    from += chunk;
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITER THREAD
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void deadline_after_ms(struct timespec *ts, u32 ms) {
+  clock_gettime(CLOCK_MONOTONIC, ts);
+  ts->tv_sec += ms / 1000;
+  ts->tv_nsec += (long)(ms % 1000) * 1000000L;
+  if (ts->tv_nsec >= 1000000000L) {
+    ts->tv_sec += 1;
+    ts->tv_nsec -= 1000000000L;
+  }
+}
+
+de100_file_scoped_fn void *writer_main(void *arg) {
+  AsyncWriter *writer = (AsyncWriter *)arg;
+  u64 synced_bytes = 0;
+  f64 last_sync_seconds = de100_get_wall_clock();
+
+  for (;;) {
+    pthread_mutex_lock(&writer->mutex);
+    if (!writer->quit &&
+        !__atomic_load_n(&writer->wake_pending, __ATOMIC_ACQUIRE)) {
+      struct timespec deadline;
+      deadline_after_ms(&deadline, ASYNC_WRITER_WRITE_INTERVAL_MS);
+      int wait_result = 0;
+      while (!writer->quit && wait_result != ETIMEDOUT &&
+             !__atomic_load_n(&writer->wake_pending, __ATOMIC_ACQUIRE)) {
+        wait_result =
+            pthread_cond_timedwait(&writer->wake, &writer->mutex, &deadline);
+      }
+    }
+    bool quit = writer->quit;
+    pthread_mutex_unlock(&writer->mutex);
+    __atomic_store_n(&writer->wake_pending, 0, __ATOMIC_RELEASE);
+
+    // Everything the producer published before this load is complete
+    u64 head = __atomic_load_n(&writer->head, __ATOMIC_ACQUIRE);
+    u64 tail = writer->tail;
+    if (head != tail && !writer->failed) {
+      if (drain_range(writer, tail, head)) {
+        writer->bytes_written += head - tail;
+      } else {
+        fprintf(stderr, "[ASYNC WRITER] ❌ Write failed, dropping further "
+                        "appends\n");
+        __atomic_store_n(&writer->failed, true, __ATOMIC_RELEASE);
+      }
+    }
+    // Release the space even on failure so a waiting producer can't hang
+    __atomic_store_n(&writer->tail, head, __ATOMIC_RELEASE);
+
+    f64 now = de100_get_wall_clock();
+    bool sync_due = (now - last_sync_seconds) * 1000.0 >=
+                    ASYNC_WRITER_SYNC_INTERVAL_MS;
+    if ((sync_due || quit) && writer->bytes_written != synced_bytes &&
+        !writer->failed) {
+      fdatasync(writer->fd);
+      synced_bytes = writer->bytes_written;
+      last_sync_seconds = now;
+    }
+
+    if (quit && head == __atomic_load_n(&writer->head, __ATOMIC_ACQUIRE)) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+de100_file_scoped_fn void request_drain(AsyncWriter *writer) {
+  if (__atomic_exchange_n(&writer->wake_pending, 1, __ATOMIC_ACQ_REL)) {
+    return; // Already asked
+  }
+  pthread_mutex_lock(&writer->mutex);
+  pthread_cond_signal(&writer->wake);
+  pthread_mutex_unlock(&writer->mutex);
+}
+
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool async_writer_open(AsyncWriter *writer, i32 fd, u64 capacity) {
+  *writer = (AsyncWriter){0};
+  writer->fd = fd;
+
+#if defined(_WIN32)
+  (void)capacity;
+  writer->is_open = true;
+  return true;
+#else
+  capacity = round_up_pow2(capacity ? capacity
+                                     : (u64)ASYNC_WRITER_DEFAULT_CAPACITY);
+  writer->storage =
+      de100_memory_alloc(NULL, (size_t)capacity, De100_MEMORY_FLAG_RW);
+  if (!de100_memory_is_valid(writer->storage)) {
+    return false;
+  }
+  writer->ring = (u8 *)writer->storage.base;
+  writer->capacity = capacity;
+  writer->mask = capacity - 1;
+
+  pthread_condattr_t cond_attr;
+  pthread_condattr_init(&cond_attr);
+  pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&writer->wake, &cond_attr);
+  pthread_condattr_destroy(&cond_attr);
+  pthread_mutex_init(&writer->mutex, NULL);
+
+  if (pthread_create(&writer->thread, NULL, writer_main, writer) != 0) {
+    pthread_cond_destroy(&writer->wake);
+    pthread_mutex_destroy(&writer->mutex);
+    de100_memory_free(&writer->storage);
+    writer->ring = NULL;
+    return false;
+  }
+
+  writer->is_open = true;
+  return true;
+#endif
+}
+
+bool async_writer_append(AsyncWriter *writer, const void *data, u64 size) {
+  if (!writer->is_open) {
+    return false;
+  }
+
+#if defined(_WIN32)
+  return de100_file_write_all(writer->fd, data, (size_t)size).success;
+#else
+  if (size > writer->capacity ||
+      __atomic_load_n(&writer->failed, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+
+  u64 head = writer->head;
+  u64 tail = __atomic_load_n(&writer->tail, __ATOMIC_ACQUIRE);
+  if (writer->capacity - (head - tail) < size) {
+    writer->stall_count++;
+    request_drain(writer);
+    while (writer->capacity - (head - tail) < size) {
+      sched_yield();
+      tail = __atomic_load_n(&writer->tail, __ATOMIC_ACQUIRE);
+    }
+    if (__atomic_load_n(&writer->failed, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+  }
+
+  const u8 *bytes = (const u8 *)data;
+  u64 index = head & writer->mask;
+  u64 first = size < writer->capacity - index ? size : writer->capacity - index;
+  memcpy(writer->ring + index, bytes, (size_t)first);
+  memcpy(writer->ring, bytes + first, (size_t)(size - first));
+
+  __atomic_store_n(&writer->head, head + size, __ATOMIC_RELEASE);
+
+  // Don't let a burst (keyframes, big records) run into a full ring
+  if (head + size - tail >= writer->capacity / 2) {
+    request_drain(writer);
+  }
+  return true;
+#endif
+}
+
+bool async_writer_close(AsyncWriter *writer) {
+  if (!writer || !writer->is_open) {
+    return true;
+  }
+
+#if defined(_WIN32)
+  writer->is_open = false;
+  return true;
+#else
+  pthread_mutex_lock(&writer->mutex);
+  writer->quit = true;
+  pthread_cond_signal(&writer->wake);
+  pthread_mutex_unlock(&writer->mutex);
+  pthread_join(writer->thread, NULL);
+
+  pthread_cond_destroy(&writer->wake);
+  pthread_mutex_destroy(&writer->mutex);
+
+  bool ok = !writer->failed && writer->bytes_written == writer->head;
+  if (writer->stall_count > 0) {
+    printf("[ASYNC WRITER] ⚠️  %llu appends waited for ring space "
+           "(%llu KB ring)\n",
+           (unsigned long long)writer->stall_count,
+           (unsigned long long)(writer->capacity / 1024));
+  }
+
+  de100_memory_free(&writer->storage);
+  writer->ring = NULL;
+  writer->is_open = false;
+  return ok;
+#endif
+}
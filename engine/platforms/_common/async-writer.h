@@ -0,0 +1,102 @@
+#ifndef DE100_PLATFORMS__COMMON_ASYNC_WRITER_H
+#define DE100_PLATFORMS__COMMON_ASYNC_WRITER_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include <stdbool.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 📝 ASYNC WRITER (Append-only file writes off the game thread)
+// ═══════════════════════════════════════════════════════════════════════════
+// Recording appends a few bytes to a file every frame. A write() per frame
+// puts every page-cache stall and writeback hiccup on the frame time, so
+// appends go into a single-producer/single-consumer ring instead and a
+// background thread drains it to the fd in large batches:
+//
+//   game thread (producer)          writer thread (consumer)
+//   ──────────────────────          ────────────────────────
+//   memcpy into ring                wakes every WRITE_INTERVAL (or when
+//   head += size (release)          the ring is half full), writes
+//                                   [tail, head) in one or two calls,
+//                                   tail = head (release),
+//                                   fdatasync every SYNC_INTERVAL
+//
+// head and tail are free-running byte counters (index = counter & mask), so
+// no locks are taken on the append path. The mutex/condvar only exists to
+// let the writer thread sleep.
+//
+// If the ring ever fills (disk stalled for longer than the ring covers), the
+// producer waits for space rather than dropping bytes: a recording with a
+// hole in it can't be played back.
+//
+// Without threads (Windows), appends are written synchronously.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define ASYNC_WRITER_DEFAULT_CAPACITY KILOBYTES(256) // Power of two
+#define ASYNC_WRITER_WRITE_INTERVAL_MS 50
+#define ASYNC_WRITER_SYNC_INTERVAL_MS 1000
+
+typedef struct {
+  bool is_open;
+  i32 fd; // Not owned: async_writer_close() leaves it open
+
+  u8 *ring;
+  u64 capacity; // Power of two
+  u64 mask;
+
+  // Free-running byte counters; head is written by the producer only,
+  // tail by the writer thread only
+  u64 head;
+  u64 tail;
+
+  bool failed;       // Set by the writer thread on a write error
+  u64 bytes_written; // Written to the fd so far (writer thread)
+  u64 stall_count;   // Appends that had to wait for space (producer)
+  u32 wake_pending;  // Producer asked for an early drain
+
+#if !defined(_WIN32)
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t wake;
+  bool quit;
+#endif
+
+  De100MemoryBlock storage;
+} AsyncWriter;
+
+/**
+ * Allocate the ring and start the writer thread for `fd`, which must be
+ * positioned where appends should go.
+ *
+ * @param capacity  Ring size in bytes, rounded up to a power of two
+ *                  (0 = ASYNC_WRITER_DEFAULT_CAPACITY)
+ * @return          false if the ring couldn't be allocated
+ */
+bool async_writer_open(AsyncWriter *writer, i32 fd, u64 capacity);
+
+/**
+ * Queue `size` bytes. Never issues a syscall unless the ring is full.
+ *
+ * @return false once the writer thread has hit a write error, or if `size`
+ *         is larger than the ring
+ */
+bool async_writer_append(AsyncWriter *writer, const void *data, u64 size);
+
+/**
+ * Drain everything queued, fdatasync, and stop the thread. The fd stays
+ * open (callers may still patch headers). Idempotent.
+ *
+ * @return true if every appended byte reached the fd
+ */
+bool async_writer_close(AsyncWriter *writer);
+
+static inline bool async_writer_is_open(const AsyncWriter *writer) {
+  return writer && writer->is_open;
+}
+
+#endif // DE100_PLATFORMS__COMMON_ASYNC_WRITER_H
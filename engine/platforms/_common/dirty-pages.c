@@ -0,0 +1,510 @@
+#include "./dirty-pages.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define DIRTY_PAGES_HAS_LINUX 1
+#else
+#define DIRTY_PAGES_HAS_LINUX 0
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONSTANTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define PAGEMAP_SOFT_DIRTY_BIT 55
+// Pagemap entries read per pread() (8 bytes each → 32KB buffer)
+#define PAGEMAP_BATCH_ENTRIES 4096
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BITMAP HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline bool bitmap_get(const u64 *bits, u64 index) {
+  return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+de100_file_scoped_fn inline void bitmap_set(u64 *bits, u64 index,
+                                            bool value) {
+  u64 mask = 1ull << (index & 63);
+  bits[index >> 6] = value ? bits[index >> 6] | mask : bits[index >> 6] & ~mask;
+}
+
+/** Whole words are filled at once; only the ragged ends go bit by bit. */
+de100_file_scoped_fn inline void bitmap_set_range(u64 *bits, u64 first,
+                                                  u64 count, bool value) {
+  u64 end = first + count;
+  for (; first < end && (first & 63); ++first) {
+    bitmap_set(bits, first, value);
+  }
+  u64 full_words = (end - first) / 64;
+  memset(bits + (first >> 6), value ? 0xFF : 0, full_words * sizeof(u64));
+  for (first += full_words * 64; first < end; ++first) {
+    bitmap_set(bits, first, value);
+  }
+}
+
+de100_file_scoped_fn inline u64 units_for_bytes(const DirtyPageTracker *t,
+                                                u64 bytes) {
+  u64 units = (bytes + t->unit_size - 1) / t->unit_size;
+  return units < t->unit_count ? units : t->unit_count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITE-FAULT MODE (SIGSEGV handler)
+// ═══════════════════════════════════════════════════════════════════════════
+// Only one tracker can own the handler (there's one game memory block).
+
+#if DIRTY_PAGES_HAS_LINUX
+
+de100_file_scoped_global_var DirtyPageTracker *g_fault_tracker = NULL;
+de100_file_scoped_global_var struct sigaction g_previous_segv_action;
+
+de100_file_scoped_fn void dirty_pages_segv_handler(int sig, siginfo_t *info,
+                                                   void *ucontext) {
+  DirtyPageTracker *t = g_fault_tracker;
+  u8 *address = (u8 *)info->si_addr;
+
+  if (t && address >= t->base && address < t->base + t->protected_size) {
+    u64 unit = (u64)(address - t->base) / t->unit_size;
+    __atomic_fetch_or(&t->pending[unit >> 6], 1ull << (unit & 63),
+                      __ATOMIC_RELAXED);
+    // mprotect isn't on the POSIX async-signal-safe list but is a plain
+    // syscall on Linux; this is how every write-barrier GC does it.
+    if (mprotect(t->base + unit * t->unit_size, t->unit_size,
+                 PROT_READ | PROT_WRITE) == 0) {
+      return;
+    }
+  }
+
+  // Not ours: hand over to whoever was there before
+  if (g_previous_segv_action.sa_flags & SA_SIGINFO) {
+    if (g_previous_segv_action.sa_sigaction) {
+      g_previous_segv_action.sa_sigaction(sig, info, ucontext);
+      return;
+    }
+  } else if (g_previous_segv_action.sa_handler != SIG_DFL &&
+             g_previous_segv_action.sa_handler != SIG_IGN) {
+    g_previous_segv_action.sa_handler(sig);
+    return;
+  }
+
+  // Default action: re-raise on return with the default disposition
+  signal(SIGSEGV, SIG_DFL);
+}
+
+de100_file_scoped_fn bool write_fault_install(DirtyPageTracker *t) {
+  if (g_fault_tracker) {
+    return false;
+  }
+
+  struct sigaction action = {0};
+  action.sa_sigaction = dirty_pages_segv_handler;
+  action.sa_flags = SA_SIGINFO | SA_NODEFER;
+  sigemptyset(&action.sa_mask);
+
+  if (sigaction(SIGSEGV, &action, &g_previous_segv_action) != 0) {
+    return false;
+  }
+  g_fault_tracker = t;
+  return true;
+}
+
+de100_file_scoped_fn void write_fault_uninstall(DirtyPageTracker *t) {
+  if (g_fault_tracker != t) {
+    return;
+  }
+  if (t->protected_size) {
+    mprotect(t->base, t->protected_size, PROT_READ | PROT_WRITE);
+    t->protected_size = 0;
+  }
+  sigaction(SIGSEGV, &g_previous_segv_action, NULL);
+  g_fault_tracker = NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SOFT-DIRTY MODE (/proc/self/pagemap)
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool soft_dirty_clear(DirtyPageTracker *t) {
+  return pwrite(t->clear_refs_fd, "4", 1, 0) == 1;
+}
+
+/** Read soft-dirty bits for units [first, first + count) into `out`. */
+de100_file_scoped_fn bool soft_dirty_read(DirtyPageTracker *t, u64 first,
+                                          u64 count, u64 *out_bits) {
+  u64 first_page = (u64)(uintptr_t)t->base / t->unit_size + first;
+  u64 done = 0;
+
+  while (done < count) {
+    u64 batch = count - done;
+    if (batch > PAGEMAP_BATCH_ENTRIES) {
+      batch = PAGEMAP_BATCH_ENTRIES;
+    }
+
+    ssize_t bytes = pread(t->pagemap_fd, t->scratch, batch * sizeof(u64),
+                          (off_t)((first_page + done) * sizeof(u64)));
+    if (bytes != (ssize_t)(batch * sizeof(u64))) {
+      return false;
+    }
+
+    for (u64 i = 0; i < batch; ++i) {
+      if ((t->scratch[i] >> PAGEMAP_SOFT_DIRTY_BIT) & 1) {
+        u64 unit = first + done + i;
+        out_bits[unit >> 6] |= (1ull << (unit & 63));
+      }
+    }
+    done += batch;
+  }
+  return true;
+}
+
+/**
+ * Kernels without CONFIG_MEM_SOFT_DIRTY accept the clear_refs write but never
+ * set the bit, which would silently turn every snapshot into a no-op. Prove
+ * it works on the first tracked page before trusting it.
+ */
+de100_file_scoped_fn bool soft_dirty_probe(DirtyPageTracker *t) {
+  if (!soft_dirty_clear(t)) {
+    return false;
+  }
+
+  volatile u8 *probe = t->base;
+  *probe = *probe; // Same value, but it's a write
+
+  u64 entry = 0;
+  off_t offset = (off_t)(((u64)(uintptr_t)t->base / t->unit_size) * 8);
+  if (pread(t->pagemap_fd, &entry, sizeof(entry), offset) != sizeof(entry)) {
+    return false;
+  }
+  return (entry >> PAGEMAP_SOFT_DIRTY_BIT) & 1;
+}
+
+#endif // DIRTY_PAGES_HAS_LINUX
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INIT / SHUTDOWN
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn bool allocate_bitmaps(DirtyPageTracker *t) {
+  t->unit_count = (t->size + t->unit_size - 1) / t->unit_size;
+  t->word_count = (t->unit_count + 63) / 64;
+
+  u64 bitmap_bytes = t->word_count * sizeof(u64);
+  u64 total = bitmap_bytes * (DIRTY_PAGES_MAX_CHANNELS + 1) +
+              PAGEMAP_BATCH_ENTRIES * sizeof(u64);
+
+  t->storage = de100_memory_alloc(NULL, total, De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(t->storage)) {
+    return false;
+  }
+
+  u64 *words = (u64 *)t->storage.base;
+  for (u32 i = 0; i < DIRTY_PAGES_MAX_CHANNELS; ++i) {
+    t->channels[i] = words + i * t->word_count;
+  }
+  t->pending = words + DIRTY_PAGES_MAX_CHANNELS * t->word_count;
+  t->scratch = t->pending + t->word_count;
+  return true;
+}
+
+bool dirty_pages_init(DirtyPageTracker *tracker, void *base, u64 size,
+                      u64 page_size, bool allow_write_fault) {
+  *tracker = (DirtyPageTracker){0};
+  tracker->pagemap_fd = -1;
+  tracker->clear_refs_fd = -1;
+
+  if (!base || size == 0) {
+    return false;
+  }
+
+  tracker->base = (u8 *)base;
+  tracker->size = size;
+
+#if DIRTY_PAGES_HAS_LINUX
+  tracker->unit_size = de100_memory_page_size();
+  if (!allocate_bitmaps(tracker)) {
+    return false;
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Soft-dirty first
+  // ─────────────────────────────────────────────────────────────────────
+  tracker->pagemap_fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+  tracker->clear_refs_fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+
+  if (tracker->pagemap_fd >= 0 && tracker->clear_refs_fd >= 0 &&
+      soft_dirty_probe(tracker)) {
+    tracker->mode = DIRTY_PAGES_MODE_SOFT_DIRTY;
+    return true;
+  }
+
+  if (tracker->pagemap_fd >= 0) {
+    close(tracker->pagemap_fd);
+    tracker->pagemap_fd = -1;
+  }
+  if (tracker->clear_refs_fd >= 0) {
+    close(tracker->clear_refs_fd);
+    tracker->clear_refs_fd = -1;
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Write-fault fallback (coarser units, see header)
+  // ─────────────────────────────────────────────────────────────────────
+  // mprotect can't split a huge page: a 64 KB unit inside a hugetlb block
+  // would fail to unprotect and the faulting write would never get through
+  u64 fault_unit_size = DIRTY_PAGES_WRITE_FAULT_UNIT_SIZE;
+  if (page_size > fault_unit_size) {
+    fault_unit_size = page_size;
+  }
+  bool is_aligned = ((uintptr_t)base & (fault_unit_size - 1)) == 0 &&
+                    (fault_unit_size & (fault_unit_size - 1)) == 0;
+  if (allow_write_fault && is_aligned) {
+    de100_memory_free(&tracker->storage);
+    tracker->unit_size = fault_unit_size;
+    if (allocate_bitmaps(tracker) && write_fault_install(tracker)) {
+      tracker->mode = DIRTY_PAGES_MODE_WRITE_FAULT;
+      return true;
+    }
+  }
+
+  de100_memory_free(&tracker->storage);
+#else
+  (void)page_size;
+  (void)allow_write_fault;
+#endif
+
+  tracker->mode = DIRTY_PAGES_MODE_NONE;
+  return false;
+}
+
+void dirty_pages_shutdown(DirtyPageTracker *tracker) {
+  if (!tracker) {
+    return;
+  }
+
+#if DIRTY_PAGES_HAS_LINUX
+  if (tracker->mode == DIRTY_PAGES_MODE_WRITE_FAULT) {
+    write_fault_uninstall(tracker);
+  }
+  if (tracker->pagemap_fd >= 0) {
+    close(tracker->pagemap_fd);
+  }
+  if (tracker->clear_refs_fd >= 0) {
+    close(tracker->clear_refs_fd);
+  }
+#endif
+
+  if (de100_memory_is_valid(tracker->storage)) {
+    de100_memory_free(&tracker->storage);
+  }
+
+  *tracker = (DirtyPageTracker){0};
+  tracker->pagemap_fd = -1;
+  tracker->clear_refs_fd = -1;
+}
+
+bool dirty_pages_is_active(const DirtyPageTracker *tracker) {
+  return tracker && tracker->mode != DIRTY_PAGES_MODE_NONE;
+}
+
+i32 dirty_pages_add_channel(DirtyPageTracker *tracker) {
+  if (!dirty_pages_is_active(tracker) ||
+      tracker->channel_count >= DIRTY_PAGES_MAX_CHANNELS) {
+    return DIRTY_PAGES_NO_CHANNEL;
+  }
+
+  i32 channel = (i32)tracker->channel_count++;
+  memset(tracker->channels[channel], 0xFF, tracker->word_count * sizeof(u64));
+  return channel;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HARVEST
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool dirty_pages_harvest(DirtyPageTracker *tracker, u64 active_size) {
+  if (!dirty_pages_is_active(tracker)) {
+    return false;
+  }
+
+  if (active_size > tracker->size) {
+    active_size = tracker->size;
+  }
+  u64 active_units = units_for_bytes(tracker, active_size);
+  u64 active_words = (active_units + 63) / 64;
+
+#if DIRTY_PAGES_HAS_LINUX
+  if (tracker->mode == DIRTY_PAGES_MODE_SOFT_DIRTY) {
+    // `pending` doubles as this harvest's result
+    memset(tracker->pending, 0, active_words * sizeof(u64));
+    if (!soft_dirty_read(tracker, 0, active_units, tracker->pending)) {
+      // Can't tell what changed: distrust everything
+      memset(tracker->pending, 0xFF, active_words * sizeof(u64));
+    }
+  }
+#endif
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Fan out to every channel
+  // ─────────────────────────────────────────────────────────────────────
+  u64 dirty_units = 0;
+  for (u64 w = 0; w < active_words; ++w) {
+    u64 bits;
+    if (w == active_words - 1 && (active_units & 63)) {
+      // Shared last word: leave the bits past active_units pending
+      u64 mask = ((u64)1 << (active_units & 63)) - 1;
+      bits = __atomic_fetch_and(&tracker->pending[w], ~mask, __ATOMIC_RELAXED) &
+             mask;
+    } else {
+      bits = __atomic_exchange_n(&tracker->pending[w], 0, __ATOMIC_RELAXED);
+    }
+    if (!bits) {
+      continue;
+    }
+    dirty_units += (u64)__builtin_popcountll(bits);
+    for (u32 c = 0; c < tracker->channel_count; ++c) {
+      tracker->channels[c][w] |= bits;
+    }
+  }
+
+  tracker->harvest_count++;
+  tracker->last_dirty_units = dirty_units;
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Start the next epoch
+  // ─────────────────────────────────────────────────────────────────────
+#if DIRTY_PAGES_HAS_LINUX
+  if (tracker->mode == DIRTY_PAGES_MODE_SOFT_DIRTY) {
+    return soft_dirty_clear(tracker);
+  }
+
+  if (tracker->mode == DIRTY_PAGES_MODE_WRITE_FAULT) {
+    u64 protect_size = active_units * tracker->unit_size;
+    if (protect_size > active_size) {
+      // Never touch reserved-but-uncommitted memory past active_size
+      protect_size = active_size & ~(tracker->unit_size - 1);
+    }
+    // Units past protect_size keep their protection and pending bits for
+    // the next harvest that covers them
+    u64 previously_protected = tracker->protected_size;
+    if (protect_size &&
+        mprotect(tracker->base, protect_size, PROT_READ) != 0) {
+      // Leave it writable and force full copies from now on
+      for (u32 c = 0; c < tracker->channel_count; ++c) {
+        memset(tracker->channels[c], 0xFF, tracker->word_count * sizeof(u64));
+      }
+      return false;
+    }
+    tracker->protected_size = protect_size > previously_protected
+                                  ? protect_size
+                                  : previously_protected;
+    // A partial trailing unit isn't protected, so it's always dirty
+    if (active_units * tracker->unit_size > protect_size) {
+      for (u32 c = 0; c < tracker->channel_count; ++c) {
+        bitmap_set_range(tracker->channels[c], protect_size / tracker->unit_size,
+                         active_units - protect_size / tracker->unit_size,
+                         true);
+      }
+    }
+  }
+#endif
+
+  return true;
+}
+
+void dirty_pages_mark_synced(DirtyPageTracker *tracker, i32 channel,
+                             u64 synced_size) {
+  if (!dirty_pages_is_active(tracker) || channel < 0 ||
+      (u32)channel >= tracker->channel_count) {
+    return;
+  }
+
+  u64 *bits = tracker->channels[channel];
+  // Only fully synced units become clean
+  u64 clean_units = synced_size / tracker->unit_size;
+  if (clean_units > tracker->unit_count) {
+    clean_units = tracker->unit_count;
+  }
+
+  u64 full_words = clean_units / 64;
+  memset(bits, 0, full_words * sizeof(u64));
+  memset(bits + full_words, 0xFF,
+         (tracker->word_count - full_words) * sizeof(u64));
+  bitmap_set_range(bits, full_words * 64, clean_units - full_words * 64,
+                   false);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// QUERIES
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool dirty_pages_next_run(const DirtyPageTracker *tracker, i32 channel,
+                          u64 limit, u64 *cursor, u64 *out_offset,
+                          u64 *out_size) {
+  if (!dirty_pages_is_active(tracker) || channel < 0 ||
+      (u32)channel >= tracker->channel_count) {
+    return false;
+  }
+
+  const u64 *bits = tracker->channels[channel];
+  u64 end_unit = units_for_bytes(tracker, limit);
+  u64 unit = *cursor;
+
+  // Skip clean units a word at a time where possible
+  while (unit < end_unit) {
+    u64 word = bits[unit >> 6] >> (unit & 63);
+    if (word) {
+      unit += (u64)__builtin_ctzll(word);
+      break;
+    }
+    unit = (unit | 63) + 1;
+  }
+  if (unit >= end_unit) {
+    *cursor = end_unit;
+    return false;
+  }
+
+  u64 run_end = unit + 1;
+  while (run_end < end_unit && bitmap_get(bits, run_end)) {
+    run_end++;
+  }
+  *cursor = run_end;
+
+  u64 offset = unit * tracker->unit_size;
+  u64 end = run_end * tracker->unit_size;
+  if (end > limit) {
+    end = limit;
+  }
+  *out_offset = offset;
+  *out_size = end - offset;
+  return true;
+}
+
+u64 dirty_pages_dirty_bytes(const DirtyPageTracker *tracker, i32 channel,
+                            u64 limit) {
+  u64 cursor = 0, offset = 0, size = 0, total = 0;
+  while (dirty_pages_next_run(tracker, channel, limit, &cursor, &offset,
+                              &size)) {
+    total += size;
+  }
+  return total;
+}
+
+const char *dirty_pages_mode_str(DirtyPagesMode mode) {
+  switch (mode) {
+  case DIRTY_PAGES_MODE_NONE:
+    return "none";
+  case DIRTY_PAGES_MODE_SOFT_DIRTY:
+    return "soft-dirty";
+  case DIRTY_PAGES_MODE_WRITE_FAULT:
+    return "write-fault";
+  }
+  return "unknown";
+}
@@ -0,0 +1,143 @@
+#ifndef DE100_PLATFORMS__COMMON_DIRTY_PAGES_H
+#define DE100_PLATFORMS__COMMON_DIRTY_PAGES_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧹 DIRTY PAGE TRACKING
+// ═══════════════════════════════════════════════════════════════════════════
+// Answers "which parts of game memory were written since X?" so snapshots
+// only copy what the game actually touched.
+//
+// MODES (picked at init, best first):
+//   SOFT_DIRTY   Linux soft-dirty bits. Writing "4" to /proc/self/clear_refs
+//                clears them, bit 55 of /proc/self/pagemap reads them back.
+//                Page granularity, no signal handler. Needs
+//                CONFIG_MEM_SOFT_DIRTY, so it's probed before use.
+//   WRITE_FAULT  The tracked range is mprotect'd read-only; a SIGSEGV
+//                handler records the first write to each unit and re-enables
+//                writes for it. Units are DIRTY_PAGES_WRITE_FAULT_UNIT_SIZE
+//                (or the block's page size if larger: hugetlb pages can't
+//                be mprotect'd piecewise) so the VMA count stays bounded.
+//                Syscalls that write into tracked memory (read(2) into
+//                game memory) fail with EFAULT instead of faulting, so this
+//                mode is opt-in.
+//   NONE         Unsupported. Callers fall back to full copies.
+//
+// CHANNELS:
+// Soft-dirty bits are process-wide and clearing them is destructive, so
+// every consumer (one per replay slot, ...) owns a channel: a bitmap of
+// "units that may differ from my copy". dirty_pages_harvest() ORs what the
+// kernel saw into EVERY channel before clearing, so no consumer loses
+// information when another one harvests.
+//
+//   harvest ──┬──> channel 0 |= dirty ──> slot 1 save/restore copies these
+//             ├──> channel 1 |= dirty ──> slot 2 ...
+//             └──> clear_refs / mprotect(PROT_READ)
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define DIRTY_PAGES_MAX_CHANNELS 8
+#define DIRTY_PAGES_NO_CHANNEL (-1)
+#define DIRTY_PAGES_WRITE_FAULT_UNIT_SIZE KILOBYTES(64)
+
+typedef enum {
+  DIRTY_PAGES_MODE_NONE = 0,
+  DIRTY_PAGES_MODE_SOFT_DIRTY,
+  DIRTY_PAGES_MODE_WRITE_FAULT,
+} DirtyPagesMode;
+
+typedef struct {
+  DirtyPagesMode mode;
+
+  u8 *base;
+  u64 size;       // Tracked bytes from base
+  u64 unit_size;  // Tracking granularity (power of two)
+  u64 unit_count; // ceil(size / unit_size)
+  u64 word_count; // u64 words per bitmap
+
+  u64 *channels[DIRTY_PAGES_MAX_CHANNELS];
+  u32 channel_count;
+
+  u64 *pending; // WRITE_FAULT: units written since the last harvest
+  u64 *scratch; // SOFT_DIRTY: pagemap read buffer
+  u64 protected_size; // WRITE_FAULT: bytes currently read-only
+
+  i32 pagemap_fd;
+  i32 clear_refs_fd;
+
+  De100MemoryBlock storage; // Backs channels + pending + scratch
+
+  // Stats (last harvest)
+  u64 harvest_count;
+  u64 last_dirty_units;
+} DirtyPageTracker;
+
+/**
+ * Start tracking [base, base + size).
+ *
+ * @param page_size          Page size backing the range
+ *                           (DE100_MEMORY_LARGE_PAGE_SIZE for hugetlb
+ *                           blocks); WRITE_FAULT units are never smaller
+ * @param allow_write_fault  Use WRITE_FAULT when soft-dirty is unavailable
+ * @return                   false if nothing is supported (mode = NONE);
+ *                           the tracker is still safe to pass around.
+ */
+bool dirty_pages_init(DirtyPageTracker *tracker, void *base, u64 size,
+                      u64 page_size, bool allow_write_fault);
+
+/** Restore protections/handlers and free the bitmaps. Idempotent. */
+void dirty_pages_shutdown(DirtyPageTracker *tracker);
+
+/**
+ * Register a consumer. Its bitmap starts all-dirty (nothing is known to be
+ * in sync yet). Returns DIRTY_PAGES_NO_CHANNEL when out of channels or when
+ * tracking is unsupported.
+ */
+i32 dirty_pages_add_channel(DirtyPageTracker *tracker);
+
+/**
+ * Fold everything written since the previous harvest into every channel and
+ * start a new tracking epoch.
+ *
+ * @param active_size  Bytes from base that are committed. Always pass all
+ *                     of it, even when the caller only needs a prefix:
+ *                     SOFT_DIRTY clears process-wide, so units left unread
+ *                     here would be lost to every other channel. Consumers
+ *                     of a prefix (rewind, the state hash) filter their own
+ *                     range through dirty_pages_next_run's limit.
+ */
+bool dirty_pages_harvest(DirtyPageTracker *tracker, u64 active_size);
+
+/**
+ * `channel`'s copy now matches memory for [0, synced_size). Everything past
+ * it is marked dirty (uncommitted/unsynced memory is never trusted).
+ */
+void dirty_pages_mark_synced(DirtyPageTracker *tracker, i32 channel,
+                             u64 synced_size);
+
+/**
+ * Walk dirty runs of `channel` below `limit` bytes.
+ *
+ * Usage:
+ *   u64 cursor = 0, offset, size;
+ *   while (dirty_pages_next_run(tracker, channel, limit, &cursor, &offset,
+ *                               &size)) {
+ *     memcpy(dst + offset, src + offset, size);
+ *   }
+ */
+bool dirty_pages_next_run(const DirtyPageTracker *tracker, i32 channel,
+                          u64 limit, u64 *cursor, u64 *out_offset,
+                          u64 *out_size);
+
+/** Dirty bytes of `channel` below `limit`. */
+u64 dirty_pages_dirty_bytes(const DirtyPageTracker *tracker, i32 channel,
+                            u64 limit);
+
+bool dirty_pages_is_active(const DirtyPageTracker *tracker);
+
+const char *dirty_pages_mode_str(DirtyPagesMode mode);
+
+#endif // DE100_PLATFORMS__COMMON_DIRTY_PAGES_H
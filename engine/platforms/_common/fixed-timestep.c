@@ -0,0 +1,72 @@
+#include "./fixed-timestep.h"
+
+#include <stdio.h>
+
+void fixed_timestep_init(FixedTimestep *timestep, u32 update_hz,
+                         u32 max_updates_per_frame) {
+  *timestep = (FixedTimestep){0};
+  if (update_hz == 0) {
+    return;
+  }
+
+  timestep->is_enabled = true;
+  timestep->seconds_per_update = 1.0 / (f64)update_hz;
+  timestep->max_updates_per_frame =
+      max_updates_per_frame ? max_updates_per_frame : 1;
+}
+
+u32 fixed_timestep_advance(FixedTimestep *timestep, f64 now_seconds) {
+  if (timestep->last_frame_seconds == 0.0) {
+    // First frame: nothing to measure yet, just get the game going
+    timestep->last_frame_seconds = now_seconds;
+    timestep->accumulator = timestep->seconds_per_update;
+  } else {
+    f64 elapsed = now_seconds - timestep->last_frame_seconds;
+    timestep->last_frame_seconds = now_seconds;
+    if (elapsed > 0.0) {
+      timestep->accumulator += elapsed;
+    }
+  }
+
+  u32 updates = 0;
+  while (timestep->accumulator >= timestep->seconds_per_update &&
+         updates < timestep->max_updates_per_frame) {
+    timestep->accumulator -= timestep->seconds_per_update;
+    updates++;
+  }
+
+  // Too far behind (breakpoint, window drag, load hitch): catching up on
+  // everything would only make the next frame later still. Drop whole
+  // updates, keep the fraction so alpha stays continuous.
+  if (timestep->accumulator >= timestep->seconds_per_update) {
+    u64 dropped =
+        (u64)(timestep->accumulator / timestep->seconds_per_update);
+    timestep->accumulator -= (f64)dropped * timestep->seconds_per_update;
+    timestep->dropped_updates += dropped;
+
+#if DE100_INTERNAL
+    printf("[FIXED TIMESTEP] ⚠️  Dropped %llu updates (%.1f ms behind)\n",
+           (unsigned long long)dropped,
+           (f64)dropped * timestep->seconds_per_update * 1000.0);
+#endif
+  }
+
+  timestep->update_count += updates;
+  return updates;
+}
+
+void fixed_timestep_reset(FixedTimestep *timestep, f64 now_seconds) {
+  timestep->last_frame_seconds = now_seconds;
+  timestep->accumulator = 0.0;
+}
+
+f32 fixed_timestep_alpha(const FixedTimestep *timestep) {
+  if (!timestep->is_enabled) {
+    return 1.0f;
+  }
+  f64 alpha = timestep->accumulator / timestep->seconds_per_update;
+  if (alpha > 1.0) {
+    alpha = 1.0;
+  }
+  return (f32)alpha;
+}
@@ -0,0 +1,67 @@
+#ifndef DE100_PLATFORMS__COMMON_FIXED_TIMESTEP_H
+#define DE100_PLATFORMS__COMMON_FIXED_TIMESTEP_H
+
+#include "../../_common/base.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⏱️ FIXED TIMESTEP (Simulation rate decoupled from the display rate)
+// ═══════════════════════════════════════════════════════════════════════════
+// Without it the game updates once per displayed frame, and the frame time
+// moves with adaptive FPS. With GameConfig.fixed_update_hz set, wall-clock
+// time goes into an accumulator and every frame runs as many fixed-size
+// updates as fit:
+//
+//   display 144 Hz, updates 60 Hz  → 0 or 1 update per frame
+//   display  30 Hz, updates 60 Hz  → 2 updates per frame
+//   frame took 200 ms (hitch)      → max_updates_per_frame, rest dropped
+//
+// What's left in the accumulator (less than one update) becomes the
+// interpolation alpha: the displayed moment lies that far between the last
+// update and the next one.
+//
+// Each update consumes one recorded input frame, so recordings replay the
+// same way whatever the display rate was.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  bool is_enabled;
+  f64 seconds_per_update;
+  u32 max_updates_per_frame;
+
+  f64 accumulator;
+  f64 last_frame_seconds; // Wall clock of the previous frame, 0 = none yet
+
+  u64 update_count;
+  u64 dropped_updates; // Owed after a hitch but over max_updates_per_frame
+} FixedTimestep;
+
+/**
+ * @param update_hz              Updates per second (0 = disabled: one update
+ *                               per frame)
+ * @param max_updates_per_frame  Catch-up limit per frame (0 = 1)
+ */
+void fixed_timestep_init(FixedTimestep *timestep, u32 update_hz,
+                         u32 max_updates_per_frame);
+
+/**
+ * Add the wall-clock time since the previous frame and take out the
+ * updates that are due.
+ *
+ * @param now_seconds  de100_get_wall_clock() at the start of this frame
+ * @return Updates to run this frame (0..max_updates_per_frame)
+ */
+u32 fixed_timestep_advance(FixedTimestep *timestep, f64 now_seconds);
+
+/**
+ * Restart the accumulator from `now_seconds`. For frames whose update count
+ * isn't wall-clock driven (playback fast-forward, stepping), so time spent
+ * in them isn't owed afterwards.
+ */
+void fixed_timestep_reset(FixedTimestep *timestep, f64 now_seconds);
+
+/** Fraction of an update left in the accumulator (0..1). */
+f32 fixed_timestep_alpha(const FixedTimestep *timestep);
+
+#endif // DE100_PLATFORMS__COMMON_FIXED_TIMESTEP_H
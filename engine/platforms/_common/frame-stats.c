@@ -1,17 +1,79 @@
 #include "./frame-stats.h"
 #include <stdio.h>
+#include <string.h>
 
 FrameStats g_frame_stats = {0};
 
-void frame_stats_init(void) {
-  g_frame_stats.frame_count = 0;
-  g_frame_stats.missed_frames = 0;
-  g_frame_stats.min_frame_time_ms = 0.0f;
-  g_frame_stats.max_frame_time_ms = 0.0f;
-  g_frame_stats.total_frame_time_ms = 0.0f;
+// ═══════════════════════════════════════════════════════════════════════════
+// HISTOGRAM
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn u32 histogram_bucket(u64 us) {
+  if (us < FRAME_HISTOGRAM_LINEAR) {
+    return (u32)us;
+  }
+  u64 max_us = (1ull << (FRAME_HISTOGRAM_MAX_BIT + 1)) - 1;
+  if (us > max_us) {
+    us = max_us;
+  }
+  u32 msb = 63u - (u32)__builtin_clzll(us);
+  u32 shift = msb - FRAME_HISTOGRAM_SUB_BITS;
+  u32 sub = (u32)(us >> shift) - (1u << FRAME_HISTOGRAM_SUB_BITS);
+  return FRAME_HISTOGRAM_LINEAR +
+         (msb - FRAME_HISTOGRAM_SUB_BITS - 1) * (1u << FRAME_HISTOGRAM_SUB_BITS) +
+         sub;
+}
+
+/** Smallest value (us) past the bucket. */
+de100_file_scoped_fn u64 histogram_bucket_end(u32 bucket) {
+  if (bucket < FRAME_HISTOGRAM_LINEAR) {
+    return bucket + 1;
+  }
+  u32 octave = (bucket - FRAME_HISTOGRAM_LINEAR) >> FRAME_HISTOGRAM_SUB_BITS;
+  u32 sub = (bucket - FRAME_HISTOGRAM_LINEAR) &
+            ((1u << FRAME_HISTOGRAM_SUB_BITS) - 1);
+  u32 shift = octave + 1;
+  return ((u64)((1u << FRAME_HISTOGRAM_SUB_BITS) + sub + 1)) << shift;
+}
+
+void frame_time_histogram_record(FrameTimeHistogram *histogram, f32 time_ms) {
+  u64 us = time_ms > 0.0f ? (u64)(time_ms * 1000.0f + 0.5f) : 0;
+  histogram->counts[histogram_bucket(us)]++;
+  histogram->count++;
+}
+
+f32 frame_time_histogram_percentile_ms(const FrameTimeHistogram *histogram,
+                                       f64 percentile) {
+  if (histogram->count == 0) {
+    return 0.0f;
+  }
+  // Rank of the frame the percentile lands on (1-based, at least the first)
+  u64 rank = (u64)(percentile / 100.0 * (f64)histogram->count + 0.999999);
+  if (rank < 1) {
+    rank = 1;
+  }
+  if (rank > histogram->count) {
+    rank = histogram->count;
+  }
+
+  u64 seen = 0;
+  for (u32 bucket = 0; bucket < FRAME_HISTOGRAM_BUCKETS; ++bucket) {
+    seen += histogram->counts[bucket];
+    if (seen >= rank) {
+      return (f32)histogram_bucket_end(bucket) / 1000.0f;
+    }
+  }
+  return (f32)histogram_bucket_end(FRAME_HISTOGRAM_BUCKETS - 1) / 1000.0f;
 }
 
-void frame_stats_record(f32 frame_time_ms, f32 target_seconds_per_frame) {
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME STATS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void frame_stats_init(void) { memset(&g_frame_stats, 0, sizeof(g_frame_stats)); }
+
+void frame_stats_record(f32 frame_time_ms, f32 work_time_ms,
+                        f32 sleep_time_ms, f32 target_seconds_per_frame) {
   g_frame_stats.frame_count++;
 
   if (frame_time_ms < g_frame_stats.min_frame_time_ms ||
@@ -24,21 +86,59 @@ void frame_stats_record(f32 frame_time_ms, f32 target_seconds_per_frame) {
 
   g_frame_stats.total_frame_time_ms += frame_time_ms;
 
+  frame_time_histogram_record(&g_frame_stats.frame_times, frame_time_ms);
+  if (work_time_ms >= 0.0f) {
+    frame_time_histogram_record(&g_frame_stats.work_times, work_time_ms);
+  }
+  if (sleep_time_ms >= 0.0f) {
+    frame_time_histogram_record(&g_frame_stats.sleep_times, sleep_time_ms);
+  }
+
   if ((frame_time_ms / 1000.0f) > (target_seconds_per_frame + 0.002f)) {
     g_frame_stats.missed_frames++;
+    g_frame_stats.miss_streak++;
+    if (g_frame_stats.miss_streak > g_frame_stats.longest_miss_streak) {
+      g_frame_stats.longest_miss_streak = g_frame_stats.miss_streak;
+      g_frame_stats.longest_miss_streak_end = g_frame_stats.frame_count;
+    }
+  } else {
+    g_frame_stats.miss_streak = 0;
+  }
+}
+
+de100_file_scoped_fn void print_percentiles(const char *label,
+                                            const FrameTimeHistogram *histogram) {
+  if (histogram->count == 0) {
+    return;
   }
+  printf("%-15s p50 %6.2fms  p90 %6.2fms  p99 %6.2fms  p99.9 %6.2fms\n", label,
+         frame_time_histogram_percentile_ms(histogram, 50.0),
+         frame_time_histogram_percentile_ms(histogram, 90.0),
+         frame_time_histogram_percentile_ms(histogram, 99.0),
+         frame_time_histogram_percentile_ms(histogram, 99.9));
 }
 
 void frame_stats_print(void) {
   printf("\n═══════════════════════════════════════════════════════════\n");
   printf("📊 FRAME TIME STATISTICS\n");
   printf("═══════════════════════════════════════════════════════════\n");
+  if (g_frame_stats.frame_count == 0) {
+    printf("No frames recorded\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    return;
+  }
   printf("Total frames:   %u\n", g_frame_stats.frame_count);
   printf("Missed frames:  %u (%.2f%%)\n", g_frame_stats.missed_frames,
          (f32)g_frame_stats.missed_frames / g_frame_stats.frame_count * 100.0f);
+  printf("Longest misses: %u in a row (ending at frame %u)\n",
+         g_frame_stats.longest_miss_streak,
+         g_frame_stats.longest_miss_streak_end);
   printf("Min frame time: %.2fms\n", g_frame_stats.min_frame_time_ms);
   printf("Max frame time: %.2fms\n", g_frame_stats.max_frame_time_ms);
   printf("Avg frame time: %.2fms\n",
          g_frame_stats.total_frame_time_ms / g_frame_stats.frame_count);
+  print_percentiles("Frame time:", &g_frame_stats.frame_times);
+  print_percentiles("Work time:", &g_frame_stats.work_times);
+  print_percentiles("Sleep time:", &g_frame_stats.sleep_times);
   printf("═══════════════════════════════════════════════════════════\n");
 }
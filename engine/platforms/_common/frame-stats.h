@@ -3,17 +3,60 @@
 
 #include "../../_common/base.h"
 
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME TIME HISTOGRAM
+// ═══════════════════════════════════════════════════════════════════════════
+// HDR-style log buckets over microseconds: exact below 32us, then 16
+// buckets per power of two (≤ 6.25% wide) up to ~2 min. Fixed 1.5 KB,
+// recording is a couple of shifts, so it's kept in every build.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FRAME_HISTOGRAM_SUB_BITS 4 // 16 buckets per octave
+#define FRAME_HISTOGRAM_LINEAR (2u << FRAME_HISTOGRAM_SUB_BITS) // Exact below
+#define FRAME_HISTOGRAM_MAX_BIT 26                              // < 2^27us
+#define FRAME_HISTOGRAM_BUCKETS                                                \
+  (FRAME_HISTOGRAM_LINEAR +                                                    \
+   (FRAME_HISTOGRAM_MAX_BIT - FRAME_HISTOGRAM_SUB_BITS) *                      \
+       (1u << FRAME_HISTOGRAM_SUB_BITS))
+
+typedef struct {
+  u32 counts[FRAME_HISTOGRAM_BUCKETS];
+  u32 count;
+} FrameTimeHistogram;
+
 typedef struct {
   u32 frame_count;
   u32 missed_frames;
   f32 min_frame_time_ms;
   f32 max_frame_time_ms;
   f32 total_frame_time_ms;
+
+  // Consecutive missed frames: one 40ms hitch vs. a second of them
+  u32 miss_streak;
+  u32 longest_miss_streak;
+  u32 longest_miss_streak_end; // frame_count when it ended
+
+  FrameTimeHistogram frame_times;
+  FrameTimeHistogram work_times;
+  FrameTimeHistogram sleep_times;
 } FrameStats;
 extern FrameStats g_frame_stats;
 
 void frame_stats_init(void);
-void frame_stats_record(f32 frame_time_ms, f32 target_seconds_per_frame);
+/**
+ * Record one frame. `work_time_ms` / `sleep_time_ms` < 0 = not measured by
+ * this backend (left out of their histograms).
+ */
+void frame_stats_record(f32 frame_time_ms, f32 work_time_ms,
+                        f32 sleep_time_ms, f32 target_seconds_per_frame);
 void frame_stats_print(void);
 
+void frame_time_histogram_record(FrameTimeHistogram *histogram, f32 time_ms);
+/**
+ * The time `percentile` (0..100) of the recorded frames stayed under, to
+ * within a bucket; 0 when empty.
+ */
+f32 frame_time_histogram_percentile_ms(const FrameTimeHistogram *histogram,
+                                       f64 percentile);
+
 #endif // DE100_PLATFORMS__COMMON_FRAME_STATS_H
@@ -7,8 +7,29 @@
 
 FrameTiming g_frame_timing = {0};
 
+de100_file_scoped_fn inline i64 timespec_to_ns(const De100TimeSpec *time) {
+  return time->seconds * 1000000000LL + time->nanoseconds;
+}
+
+de100_file_scoped_fn inline De100TimeSpec ns_to_timespec(i64 ns) {
+  return (De100TimeSpec){ns / 1000000000LL, ns % 1000000000LL};
+}
+
+de100_file_scoped_fn inline i64 now_ns(void) {
+  De100TimeSpec now;
+  de100_get_timespec(&now);
+  return timespec_to_ns(&now);
+}
+
+de100_file_scoped_fn inline void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+
 void frame_timing_begin(void) {
   de100_get_timespec(&g_frame_timing.frame_start);
+  g_frame_timing.spin_seconds = 0.0f;
 #if DE100_INTERNAL
   g_frame_timing.start_cycles = __rdtsc();
 #endif
@@ -20,30 +41,79 @@ void frame_timing_mark_work_done(void) {
       &g_frame_timing.frame_start, &g_frame_timing.work_end);
 }
 
-void frame_timing_sleep_until_target(f32 target_seconds) {
-  f32 seconds_elapsed = g_frame_timing.work_seconds;
+/** Feed one wake-up lateness sample into the estimate. */
+de100_file_scoped_fn void record_wake_latency(f32 sample_seconds) {
+  FrameTiming *timing = &g_frame_timing;
+  if (timing->wake_latency_seconds == 0.0f) {
+    timing->wake_latency_seconds = FRAME_TIMING_INITIAL_WAKE_LATENCY_SECONDS;
+  }
+  f32 deviation = sample_seconds - timing->wake_latency_seconds;
+  if (deviation < 0.0f) {
+    deviation = -deviation;
+  }
+  timing->wake_latency_seconds +=
+      (sample_seconds - timing->wake_latency_seconds) / 16.0f;
+  timing->wake_jitter_seconds +=
+      (deviation - timing->wake_jitter_seconds) / 16.0f;
+}
 
-  if (seconds_elapsed < target_seconds) {
-    f32 sleep_threshold = target_seconds - 0.003f;
+de100_file_scoped_fn f32 spin_tail_seconds(void) {
+  f32 latency = g_frame_timing.wake_latency_seconds;
+  if (latency == 0.0f) {
+    latency = FRAME_TIMING_INITIAL_WAKE_LATENCY_SECONDS;
+  }
+  f32 tail = latency + 3.0f * g_frame_timing.wake_jitter_seconds;
+  if (tail < FRAME_TIMING_MIN_SPIN_SECONDS) {
+    tail = FRAME_TIMING_MIN_SPIN_SECONDS;
+  }
+  if (tail > FRAME_TIMING_MAX_SPIN_SECONDS) {
+    tail = FRAME_TIMING_MAX_SPIN_SECONDS;
+  }
+  return tail;
+}
 
-    // Phase 1: Coarse sleep
-    while (seconds_elapsed < sleep_threshold) {
-      de100_sleep_ms(1);
+void frame_timing_sleep_until_target(f32 target_seconds) {
+  FrameTiming *timing = &g_frame_timing;
+  i64 target_ns = (i64)((f64)target_seconds * 1000000000.0);
+  i64 now = now_ns();
+
+  // Previous deadline + target keeps the average rate exact. First frame,
+  // or after unpaced frames / a long stall: start over from this frame.
+  i64 deadline = timing->deadline_ns + target_ns;
+  if (timing->deadline_ns == 0 || deadline + target_ns < now) {
+    deadline = timespec_to_ns(&timing->frame_start) + target_ns;
+  }
+  timing->deadline_ns = deadline;
+  timing->paced_frames++;
 
-      De100TimeSpec current;
-      de100_get_timespec(&current);
-      seconds_elapsed = (f32)de100_timespec_diff_seconds(
-          &g_frame_timing.frame_start, &current);
-    }
+  if (now >= deadline) {
+    timing->late_frames++;
+    return;
+  }
+
+  // Phase 1: absolute sleep to just before the deadline
+  i64 wake_at = deadline - (i64)((f64)spin_tail_seconds() * 1000000000.0);
+  if (now < wake_at) {
+    De100TimeSpec wake_time = ns_to_timespec(wake_at);
+    de100_sleep_until(&wake_time);
+    now = now_ns();
+    record_wake_latency((f32)(now - wake_at) / 1000000000.0f);
+  }
 
-    // Phase 2: Spin-wait
-    while (seconds_elapsed < target_seconds) {
-      De100TimeSpec current;
-      de100_get_timespec(&current);
-      seconds_elapsed = (f32)de100_timespec_diff_seconds(
-          &g_frame_timing.frame_start, &current);
+  // Phase 2: spin the rest on the tick clock (a bare rdtsc per poll when
+  // calibrated, instead of a clock_gettime)
+  u64 spin_start = de100_now_ticks();
+  if (now < deadline) {
+    u64 spin_end =
+        spin_start + de100_seconds_to_ticks((f64)(deadline - now) / 1e9);
+    u64 ticks = spin_start;
+    while (ticks < spin_end) {
+      cpu_relax();
+      ticks = de100_now_ticks();
     }
+    timing->spin_seconds = (f32)de100_ticks_to_seconds(ticks - spin_start);
   }
+  timing->total_spin_seconds += timing->spin_seconds;
 }
 
 void frame_timing_end(void) {
@@ -65,6 +135,14 @@ f32 frame_timing_get_ms(void) { return g_frame_timing.total_seconds * 1000.0f; }
 
 f32 frame_timing_get_fps(void) { return 1.0f / g_frame_timing.total_seconds; }
 
+f32 frame_timing_get_avg_spin_ms(void) {
+  if (g_frame_timing.paced_frames == 0) {
+    return 0.0f;
+  }
+  return (f32)(g_frame_timing.total_spin_seconds * 1000.0 /
+               (f64)g_frame_timing.paced_frames);
+}
+
 #if DE100_INTERNAL
 f32 frame_timing_get_mcpf(void) {
   return (g_frame_timing.end_cycles - g_frame_timing.start_cycles) / 1000000.0f;
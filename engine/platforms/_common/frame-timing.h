@@ -4,6 +4,22 @@
 #include "../../_common/base.h"
 #include "../../_common/time.h"
 
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAME PACER
+// ═══════════════════════════════════════════════════════════════════════════
+// Frames end on a fixed deadline schedule (previous deadline + target, so
+// rounding and wake-up lateness don't accumulate). Waiting for a deadline is
+// an absolute sleep (de100_sleep_until) to just before it, then a short spin.
+// The spin tail is sized from this machine's measured wake-up lateness
+// (EWMA mean + 3 x mean deviation), so a quiet system spins ~50-100 us a
+// frame instead of milliseconds. More than a frame behind, the schedule
+// restarts from now instead of rushing frames to catch up.
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FRAME_TIMING_INITIAL_WAKE_LATENCY_SECONDS 0.0005f
+#define FRAME_TIMING_MIN_SPIN_SECONDS 0.00005f
+#define FRAME_TIMING_MAX_SPIN_SECONDS 0.002f
+
 typedef struct {
   De100TimeSpec frame_start;
   De100TimeSpec work_end;
@@ -12,6 +28,15 @@ typedef struct {
   f32 total_seconds;
   // f32 total_ms;
   f32 sleep_seconds;
+  f32 spin_seconds; // Part of sleep_seconds spent busy-waiting (CPU time)
+
+  // Pacer
+  i64 deadline_ns;          // When the previous frame was due, 0 = none
+  f32 wake_latency_seconds; // How late an absolute sleep wakes (EWMA)
+  f32 wake_jitter_seconds;  // Mean deviation of that (EWMA)
+  u64 paced_frames;
+  u64 late_frames; // Work alone overran the deadline
+  f64 total_spin_seconds;
 #if DE100_INTERNAL
   u64 start_cycles;
   u64 end_cycles;
@@ -31,6 +56,9 @@ f32 frame_timing_get_ms(void);
 
 f32 frame_timing_get_fps(void);
 
+/** Average spin per paced frame so far, in ms. */
+f32 frame_timing_get_avg_spin_ms(void);
+
 #if DE100_INTERNAL
 f32 frame_timing_get_mcpf(void);
 #endif
@@ -0,0 +1,504 @@
+#include "./input-stream.h"
+#include "../../_common/file.h"
+#include "../../_common/hash.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ERROR MESSAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_global_var const char *g_input_stream_error_messages[] = {
+    [INPUT_STREAM_SUCCESS] = "Success",
+    [INPUT_STREAM_ERROR_OPEN_FAILED] = "Failed to open input stream file",
+    [INPUT_STREAM_ERROR_WRITE_FAILED] = "Failed to write input stream",
+    [INPUT_STREAM_ERROR_READ_FAILED] = "Failed to read input stream",
+    [INPUT_STREAM_ERROR_BAD_HEADER] = "Not an input stream (bad header)",
+    [INPUT_STREAM_ERROR_VERSION_MISMATCH] =
+        "Input stream format version not supported",
+    [INPUT_STREAM_ERROR_LAYOUT_MISMATCH] =
+        "Recorded with a different GameInput layout",
+    [INPUT_STREAM_ERROR_CORRUPT] = "Input stream frame data is corrupt",
+    [INPUT_STREAM_ERROR_END_OF_STREAM] = "End of input stream",
+    [INPUT_STREAM_ERROR_OUT_OF_MEMORY] = "Out of memory for input stream",
+};
+
+const char *input_stream_strerror(InputStreamErrorCode code) {
+  if (code >= 0 && code < INPUT_STREAM_ERROR_COUNT) {
+    return g_input_stream_error_messages[code];
+  }
+  return "Unknown input stream error";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define INPUT_STREAM_VARINT_MAX 10
+// Zero gaps shorter than this stay inside a literal run (a new op costs 2+)
+#define INPUT_STREAM_MIN_ZERO_GAP 3
+
+de100_file_scoped_fn inline InputStreamResult
+make_result(bool success, InputStreamErrorCode code) {
+  return (InputStreamResult){.success = success, .error_code = code};
+}
+
+/** LEB128. Returns bytes written (out needs INPUT_STREAM_VARINT_MAX). */
+de100_file_scoped_fn inline u32 varint_write(u8 *out, u64 value) {
+  u32 n = 0;
+  while (value >= 0x80) {
+    out[n++] = (u8)(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = (u8)value;
+  return n;
+}
+
+de100_file_scoped_fn inline bool varint_read(const u8 **p, const u8 *end,
+                                             u64 *out) {
+  u64 value = 0;
+  for (u32 shift = 0; shift < 64; shift += 7) {
+    if (*p >= end) {
+      return false;
+    }
+    u8 byte = *(*p)++;
+    value |= (u64)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *out = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+de100_file_scoped_fn inline bool is_keyframe(const InputStream *stream,
+                                             u64 frame_index) {
+  return frame_index % stream->header.keyframe_interval == 0;
+}
+
+/**
+ * Apply one record's ops to `out`, which holds the base frame on entry.
+ * Returns false on malformed data.
+ */
+de100_file_scoped_fn bool decode_ops(const u8 *p, const u8 *end, u8 *out) {
+  u64 pos = 0;
+  while (p < end) {
+    u64 skip, count;
+    if (!varint_read(&p, end, &skip) || !varint_read(&p, end, &count)) {
+      return false;
+    }
+    pos += skip;
+    if (pos > sizeof(GameInput) || count > sizeof(GameInput) - pos ||
+        count > (u64)(end - p)) {
+      return false;
+    }
+    for (u64 i = 0; i < count; ++i) {
+      out[pos + i] ^= p[i];
+    }
+    p += count;
+    pos += count;
+  }
+  return true;
+}
+
+/** Walk one record at `offset`; false if it runs past `limit`. */
+de100_file_scoped_fn bool record_bounds(const u8 *data, u64 offset,
+                                        u64 limit, const u8 **out_ops,
+                                        const u8 **out_end) {
+  const u8 *p = data + offset;
+  const u8 *end = data + limit;
+  u64 size;
+  if (!varint_read(&p, end, &size) || size > (u64)(end - p)) {
+    return false;
+  }
+  *out_ops = p;
+  *out_end = p + size;
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LAYOUT HASH
+// ═══════════════════════════════════════════════════════════════════════════
+
+u64 input_stream_layout_hash(void) {
+  u64 layout[] = {
+      sizeof(GameInput),
+      sizeof(GameControllerInput),
+      sizeof(GameButtonState),
+      DE100_GAME_BUTTON_COUNT,
+      ArraySize(((GameInput *)0)->controllers),
+      offsetof(GameInput, mouse_buttons),
+      offsetof(GameInput, mouse_x),
+      offsetof(GameInput, mouse_y),
+      offsetof(GameInput, mouse_z),
+      offsetof(GameControllerInput, stick_avg_x),
+      offsetof(GameControllerInput, stick_avg_y),
+      offsetof(GameControllerInput, controller_index),
+      offsetof(GameControllerInput, is_analog),
+      offsetof(GameControllerInput, is_connected),
+      offsetof(GameButtonState, ended_down),
+      offsetof(GameButtonState, half_transition_count),
+  };
+  return de100_hash64(layout, sizeof(layout), INPUT_STREAM_MAGIC);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITING
+// ═══════════════════════════════════════════════════════════════════════════
+
+InputStreamResult input_stream_open_write(InputStream *stream,
+                                          const char *filename,
+                                          const InputStreamInfo *info) {
+  *stream = (InputStream){0};
+  stream->fd = -1;
+
+  u64 encode_capacity = 2 * sizeof(GameInput) + 2 * INPUT_STREAM_VARINT_MAX;
+  u64 index_bytes =
+      INPUT_STREAM_MAX_INDEX_ENTRIES * sizeof(InputStreamIndexEntry);
+  stream->storage = de100_memory_alloc(
+      NULL, (size_t)(index_bytes + encode_capacity), De100_MEMORY_FLAG_RW);
+  if (!de100_memory_is_valid(stream->storage)) {
+    return make_result(false, INPUT_STREAM_ERROR_OUT_OF_MEMORY);
+  }
+  stream->index = (InputStreamIndexEntry *)stream->storage.base;
+  stream->encode_buffer = (u8 *)stream->storage.base + index_bytes;
+  stream->encode_capacity = encode_capacity;
+
+  De100FileOpenResult open_result = de100_file_open(
+      filename, DE100_FILE_WRITE | DE100_FILE_CREATE | DE100_FILE_TRUNCATE);
+  if (!open_result.success) {
+    de100_memory_free(&stream->storage);
+    return make_result(false, INPUT_STREAM_ERROR_OPEN_FAILED);
+  }
+
+  InputStreamHeader *header = &stream->header;
+  header->magic = INPUT_STREAM_MAGIC;
+  header->version = INPUT_STREAM_VERSION;
+  header->header_size = sizeof(InputStreamHeader);
+  header->input_size = sizeof(GameInput);
+  header->layout_hash = input_stream_layout_hash();
+  header->keyframe_interval = INPUT_STREAM_KEYFRAME_INTERVAL;
+  if (info) {
+    header->engine_build_id = info->engine_build_id;
+    header->game_build_id = info->game_build_id;
+    header->frame_rate_hz = info->frame_rate_hz;
+  }
+
+  if (!de100_file_write_all(open_result.fd, header, sizeof(*header)).success) {
+    de100_file_close(open_result.fd);
+    de100_memory_free(&stream->storage);
+    return make_result(false, INPUT_STREAM_ERROR_WRITE_FAILED);
+  }
+
+  if (!async_writer_open(&stream->writer, open_result.fd, 0)) {
+    de100_file_close(open_result.fd);
+    de100_memory_free(&stream->storage);
+    return make_result(false, INPUT_STREAM_ERROR_OUT_OF_MEMORY);
+  }
+
+  stream->fd = open_result.fd;
+  stream->write_offset = sizeof(*header);
+  stream->is_writing = true;
+  stream->is_open = true;
+  return make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+InputStreamResult input_stream_write(InputStream *stream,
+                                     const GameInput *input) {
+  if (!stream->is_open || !stream->is_writing) {
+    return make_result(false, INPUT_STREAM_ERROR_WRITE_FAILED);
+  }
+
+  bool keyframe = is_keyframe(stream, stream->frame_index);
+  if (keyframe && stream->index_count < INPUT_STREAM_MAX_INDEX_ENTRIES) {
+    stream->index[stream->index_count++] = (InputStreamIndexEntry){
+        .frame_index = stream->frame_index,
+        .file_offset = stream->write_offset,
+    };
+  }
+
+  // Ops go after room for the size prefix, which is moved in front last
+  const u8 *current = (const u8 *)input;
+  const u8 *base = (const u8 *)&stream->previous;
+  u8 *ops = stream->encode_buffer + INPUT_STREAM_VARINT_MAX;
+  u8 *op = ops;
+  u64 n = sizeof(GameInput);
+  u64 cursor = 0;
+
+#define INPUT_STREAM_DIFF(i) (keyframe ? current[i] : (u8)(current[i] ^ base[i]))
+  u64 i = 0;
+  while (i < n) {
+    if (!INPUT_STREAM_DIFF(i)) {
+      ++i;
+      continue;
+    }
+
+    u64 start = i;
+    u64 end = i;
+    while (i < n) {
+      if (INPUT_STREAM_DIFF(i)) {
+        end = ++i;
+        continue;
+      }
+      u64 gap_end = i;
+      while (gap_end < n && !INPUT_STREAM_DIFF(gap_end) &&
+             gap_end - i < INPUT_STREAM_MIN_ZERO_GAP) {
+        ++gap_end;
+      }
+      if (gap_end < n && gap_end - i < INPUT_STREAM_MIN_ZERO_GAP) {
+        i = gap_end; // Short gap: cheaper to carry the zeros as literals
+        continue;
+      }
+      break;
+    }
+
+    op += varint_write(op, start - cursor);
+    op += varint_write(op, end - start);
+    for (u64 b = start; b < end; ++b) {
+      *op++ = INPUT_STREAM_DIFF(b);
+    }
+    cursor = end;
+    i = end;
+  }
+#undef INPUT_STREAM_DIFF
+
+  u8 size_prefix[INPUT_STREAM_VARINT_MAX];
+  u32 prefix_size = varint_write(size_prefix, (u64)(op - ops));
+  u8 *record = ops - prefix_size;
+  memcpy(record, size_prefix, prefix_size);
+  u64 record_size = (u64)(op - record);
+
+  if (!async_writer_append(&stream->writer, record, record_size)) {
+    return make_result(false, INPUT_STREAM_ERROR_WRITE_FAILED);
+  }
+
+  stream->previous = *input;
+  stream->write_offset += record_size;
+  stream->frame_index++;
+  return make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// READING
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Rebuild frame count + index from the records (stream never closed). */
+de100_file_scoped_fn void rebuild_index(InputStream *stream) {
+  u64 offset = stream->header.header_size;
+  u64 frame = 0;
+  stream->index_count = 0;
+
+  const u8 *ops, *end;
+  while (offset < stream->data_size &&
+         record_bounds(stream->data, offset, stream->data_size, &ops, &end)) {
+    if (is_keyframe(stream, frame) &&
+        stream->index_count < INPUT_STREAM_MAX_INDEX_ENTRIES) {
+      stream->index[stream->index_count++] = (InputStreamIndexEntry){
+          .frame_index = frame,
+          .file_offset = offset,
+      };
+    }
+    offset = (u64)(end - stream->data);
+    ++frame;
+  }
+
+  stream->frames_end = offset;
+  stream->header.frame_count = frame;
+}
+
+InputStreamResult input_stream_open_read(InputStream *stream,
+                                         const char *filename,
+                                         const InputStreamInfo *info) {
+  *stream = (InputStream){0};
+  stream->fd = -1;
+
+  De100FileSizeResult size_result = de100_file_get_size(filename);
+  if (!size_result.success) {
+    return make_result(false, INPUT_STREAM_ERROR_OPEN_FAILED);
+  }
+  u64 file_size = (u64)size_result.value;
+  if (file_size < sizeof(InputStreamHeader)) {
+    return make_result(false, INPUT_STREAM_ERROR_BAD_HEADER);
+  }
+
+  u64 index_bytes =
+      INPUT_STREAM_MAX_INDEX_ENTRIES * sizeof(InputStreamIndexEntry);
+  stream->storage = de100_memory_alloc(NULL, (size_t)(index_bytes + file_size),
+                                       De100_MEMORY_FLAG_RW);
+  if (!de100_memory_is_valid(stream->storage)) {
+    return make_result(false, INPUT_STREAM_ERROR_OUT_OF_MEMORY);
+  }
+  stream->index = (InputStreamIndexEntry *)stream->storage.base;
+  stream->data = (u8 *)stream->storage.base + index_bytes;
+  stream->data_size = file_size;
+
+  De100FileOpenResult open_result = de100_file_open(filename, DE100_FILE_READ);
+  bool read_ok = open_result.success &&
+                 de100_file_read_all(open_result.fd, stream->data,
+                                     (size_t)file_size)
+                     .success;
+  if (open_result.success) {
+    de100_file_close(open_result.fd);
+  }
+  if (!read_ok) {
+    de100_memory_free(&stream->storage);
+    return make_result(false, open_result.success
+                                  ? INPUT_STREAM_ERROR_READ_FAILED
+                                  : INPUT_STREAM_ERROR_OPEN_FAILED);
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Header checks
+  // ─────────────────────────────────────────────────────────────────────
+
+  InputStreamHeader *header = &stream->header;
+  memcpy(header, stream->data, sizeof(*header));
+
+  InputStreamErrorCode error = INPUT_STREAM_SUCCESS;
+  if (header->magic != INPUT_STREAM_MAGIC) {
+    error = INPUT_STREAM_ERROR_BAD_HEADER;
+  } else if (header->version != INPUT_STREAM_VERSION ||
+             header->header_size != sizeof(InputStreamHeader) ||
+             header->keyframe_interval == 0) {
+    error = INPUT_STREAM_ERROR_VERSION_MISMATCH;
+  } else if (header->input_size != sizeof(GameInput) ||
+             header->layout_hash != input_stream_layout_hash()) {
+    error = INPUT_STREAM_ERROR_LAYOUT_MISMATCH;
+  }
+  if (error != INPUT_STREAM_SUCCESS) {
+    de100_memory_free(&stream->storage);
+    return make_result(false, error);
+  }
+
+  if (info && (header->engine_build_id != info->engine_build_id ||
+               header->game_build_id != info->game_build_id)) {
+    printf("[INPUT STREAM] ⚠️  '%s' was recorded by a different %s build\n",
+           filename,
+           header->engine_build_id != info->engine_build_id ? "engine"
+                                                            : "game");
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Index: from the file when it was closed cleanly, else by walking
+  // ─────────────────────────────────────────────────────────────────────
+
+  u64 index_bytes_in_file =
+      (u64)header->index_count * sizeof(InputStreamIndexEntry);
+  bool index_ok = header->index_offset >= header->header_size &&
+                  header->index_count <= INPUT_STREAM_MAX_INDEX_ENTRIES &&
+                  header->index_offset <= file_size &&
+                  index_bytes_in_file <= file_size - header->index_offset;
+  if (index_ok) {
+    memcpy(stream->index, stream->data + header->index_offset,
+           (size_t)index_bytes_in_file);
+    stream->index_count = header->index_count;
+    stream->frames_end = header->index_offset;
+  } else {
+    rebuild_index(stream);
+  }
+
+  stream->read_offset = header->header_size;
+  stream->is_open = true;
+  return make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+InputStreamResult input_stream_read(InputStream *stream, GameInput *out) {
+  if (!stream->is_open || stream->is_writing) {
+    return make_result(false, INPUT_STREAM_ERROR_READ_FAILED);
+  }
+  if (stream->frame_index >= stream->header.frame_count) {
+    return make_result(false, INPUT_STREAM_ERROR_END_OF_STREAM);
+  }
+
+  const u8 *ops, *end;
+  if (!record_bounds(stream->data, stream->read_offset, stream->frames_end,
+                     &ops, &end)) {
+    return make_result(false, INPUT_STREAM_ERROR_CORRUPT);
+  }
+
+  GameInput decoded;
+  if (is_keyframe(stream, stream->frame_index)) {
+    memset(&decoded, 0, sizeof(decoded));
+  } else {
+    decoded = stream->previous;
+  }
+  if (!decode_ops(ops, end, (u8 *)&decoded)) {
+    return make_result(false, INPUT_STREAM_ERROR_CORRUPT);
+  }
+
+  stream->previous = decoded;
+  stream->read_offset = (u64)(end - stream->data);
+  stream->frame_index++;
+  *out = decoded;
+  return make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+InputStreamResult input_stream_seek(InputStream *stream, u64 frame_index) {
+  if (!stream->is_open || stream->is_writing ||
+      frame_index > stream->header.frame_count) {
+    return make_result(false, INPUT_STREAM_ERROR_READ_FAILED);
+  }
+
+  // Nearest keyframe at or before the target
+  stream->frame_index = 0;
+  stream->read_offset = stream->header.header_size;
+  if (stream->index_count > 0) {
+    u64 entry = frame_index / stream->header.keyframe_interval;
+    if (entry >= stream->index_count) {
+      entry = stream->index_count - 1;
+    }
+    stream->frame_index = stream->index[entry].frame_index;
+    stream->read_offset = stream->index[entry].file_offset;
+  }
+
+  GameInput scratch;
+  while (stream->frame_index < frame_index) {
+    InputStreamResult result = input_stream_read(stream, &scratch);
+    if (!result.success) {
+      return result;
+    }
+  }
+  return make_result(true, INPUT_STREAM_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CLOSE
+// ═══════════════════════════════════════════════════════════════════════════
+
+void input_stream_close(InputStream *stream) {
+  if (!stream || !stream->is_open) {
+    return;
+  }
+
+  if (stream->is_writing) {
+    InputStreamHeader *header = &stream->header;
+    header->frame_count = stream->frame_index;
+    header->index_offset = stream->write_offset;
+    header->index_count = stream->index_count;
+
+    // Drain the queued records first: the index goes after them
+    bool ok = async_writer_close(&stream->writer) &&
+              de100_file_write_all(stream->fd, stream->index,
+                                   stream->index_count *
+                                       sizeof(InputStreamIndexEntry))
+                  .success &&
+              de100_file_seek(stream->fd, 0, DE100_SEEK_SET).success &&
+              de100_file_write_all(stream->fd, header, sizeof(*header))
+                  .success;
+    if (!ok) {
+      // Readers rebuild the index from the records
+      fprintf(stderr, "[INPUT STREAM] ⚠️  Failed to finalize recording "
+                      "(%llu frames still readable)\n",
+              (unsigned long long)stream->frame_index);
+    }
+    de100_file_close(stream->fd);
+  }
+
+  if (de100_memory_is_valid(stream->storage)) {
+    de100_memory_free(&stream->storage);
+  }
+  *stream = (InputStream){0};
+  stream->fd = -1;
+}
@@ -0,0 +1,160 @@
+#ifndef DE100_PLATFORMS__COMMON_INPUT_STREAM_H
+#define DE100_PLATFORMS__COMMON_INPUT_STREAM_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "../../game/inputs.h"
+#include "./async-writer.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎞️ INPUT STREAM (Recorded GameInput container)
+// ═══════════════════════════════════════════════════════════════════════════
+// The on-disk format of loop_edit_N_input.hmi. Raw GameInput structs are
+// hundreds of bytes and almost identical frame to frame, so each frame is
+// stored as the XOR against the previous one, with zero runs skipped.
+//
+// FILE:
+//   [InputStreamHeader]
+//   [frame record] x frame_count
+//   [InputStreamIndexEntry] x index_count     (written on close)
+//
+// FRAME RECORD:
+//   [varint payload size][ops...]
+//   op = [varint zero bytes to skip][varint literal count][literals]
+//
+//   decoded = base XOR (diff described by the ops, zeros elsewhere)
+//   base    = previous frame, or all zeros on a keyframe
+//
+// Every keyframe_interval-th frame is a keyframe (self-contained) and gets
+// an index entry, so seeking to frame N decodes at most keyframe_interval
+// frames starting from the keyframe at or before N.
+//
+// A stream that was never closed (crash) has index_offset == 0; readers
+// rebuild the frame count and index by walking the records. Records are
+// queued on an AsyncWriter, so a crash loses at most the last few writer
+// intervals, and a record cut in half is dropped by the walk.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define INPUT_STREAM_MAGIC 0x504E4944u // "DINP"
+#define INPUT_STREAM_VERSION 1u
+#define INPUT_STREAM_KEYFRAME_INTERVAL 256
+// Recording stops growing the index past this (~77 h at 60 Hz with the
+// default interval); later frames are still written, just not seekable.
+#define INPUT_STREAM_MAX_INDEX_ENTRIES 65536
+
+typedef struct {
+  u32 magic;
+  u32 version;
+  u32 header_size;
+  u32 input_size;   // sizeof(GameInput) when recorded
+  u64 layout_hash;  // input_stream_layout_hash() when recorded
+  u64 engine_build_id;
+  u64 game_build_id;
+  u32 frame_rate_hz;
+  u32 keyframe_interval;
+  u64 frame_count;  // Patched on close
+  u64 index_offset; // Patched on close, 0 = not closed cleanly
+  u32 index_count;
+  u32 reserved;
+} InputStreamHeader;
+
+typedef struct {
+  u64 frame_index;
+  u64 file_offset; // Of the keyframe's record
+} InputStreamIndexEntry;
+
+/** What the recorder knows about the build; stored in the header. */
+typedef struct {
+  u64 engine_build_id;
+  u64 game_build_id;
+  u32 frame_rate_hz;
+} InputStreamInfo;
+
+typedef enum {
+  INPUT_STREAM_SUCCESS = 0,
+  INPUT_STREAM_ERROR_OPEN_FAILED,
+  INPUT_STREAM_ERROR_WRITE_FAILED,
+  INPUT_STREAM_ERROR_READ_FAILED,
+  INPUT_STREAM_ERROR_BAD_HEADER,
+  INPUT_STREAM_ERROR_VERSION_MISMATCH,
+  INPUT_STREAM_ERROR_LAYOUT_MISMATCH,
+  INPUT_STREAM_ERROR_CORRUPT,
+  INPUT_STREAM_ERROR_END_OF_STREAM,
+  INPUT_STREAM_ERROR_OUT_OF_MEMORY,
+
+  INPUT_STREAM_ERROR_COUNT
+} InputStreamErrorCode;
+
+typedef struct {
+  bool success;
+  InputStreamErrorCode error_code;
+} InputStreamResult;
+
+typedef struct {
+  bool is_open;
+  bool is_writing;
+  InputStreamHeader header;
+
+  GameInput previous; // Delta base: last frame written / decoded
+  u64 frame_index;    // Next frame to write / read
+
+  // Writing: records go through the async writer, header/index directly
+  i32 fd;
+  AsyncWriter writer;
+  u64 write_offset;
+  u8 *encode_buffer;
+  u64 encode_capacity;
+
+  // Reading: the whole file stays in memory (a few bytes per frame)
+  u8 *data;
+  u64 data_size;
+  u64 read_offset;
+  u64 frames_end; // Offset where frame records stop
+
+  InputStreamIndexEntry *index;
+  u32 index_count;
+
+  De100MemoryBlock storage;
+} InputStream;
+
+/** Fingerprint of the GameInput layout (size, button count, field offsets). */
+u64 input_stream_layout_hash(void);
+
+InputStreamResult input_stream_open_write(InputStream *stream,
+                                          const char *filename,
+                                          const InputStreamInfo *info);
+
+InputStreamResult input_stream_write(InputStream *stream,
+                                     const GameInput *input);
+
+/**
+ * Open a recording for playback. Fails on a different format version or
+ * GameInput layout; a different build ID only warns (the determinism check
+ * is what tells whether the game still replays it the same way).
+ */
+InputStreamResult input_stream_open_read(InputStream *stream,
+                                         const char *filename,
+                                         const InputStreamInfo *info);
+
+/** Decode the next frame. error_code END_OF_STREAM after the last one. */
+InputStreamResult input_stream_read(InputStream *stream, GameInput *out);
+
+/** Position the stream so the next read returns frame `frame_index`. */
+InputStreamResult input_stream_seek(InputStream *stream, u64 frame_index);
+
+/** Writers: patch the header and append the index. Idempotent. */
+void input_stream_close(InputStream *stream);
+
+static inline bool input_stream_is_open(const InputStream *stream) {
+  return stream && stream->is_open;
+}
+
+static inline u64 input_stream_frame_count(const InputStream *stream) {
+  return stream->header.frame_count;
+}
+
+const char *input_stream_strerror(InputStreamErrorCode code);
+
+#endif // DE100_PLATFORMS__COMMON_INPUT_STREAM_H
@@ -106,6 +106,9 @@
 
 #include "inputs-recording.h"
 #include "../../_common/file.h"
+#include "../../_common/profiler.h"
+#include "../../_common/time.h"
+#include "./input-stream.h"
 #include "./replay-buffer.h"
 #include <stdio.h>
 #include <string.h>
@@ -126,6 +129,30 @@ de100_file_scoped_fn inline void get_input_filename(const char *exe_directory,
            slot_index);
 }
 
+/** Per-frame state hashes recorded next to the inputs (one u64 per frame). */
+de100_file_scoped_fn inline void get_hash_filename(const char *exe_directory,
+                                                   i32 slot_index,
+                                                   char *buffer,
+                                                   size_t buffer_size) {
+  snprintf(buffer, buffer_size, "%sloop_edit_%d_hash.hmi", exe_directory,
+           slot_index);
+}
+
+/** Periodic game memory keyframes for seeking (see replay-keyframes.h). */
+de100_file_scoped_fn inline void get_keyframes_filename(
+    const char *exe_directory, i32 slot_index, char *buffer,
+    size_t buffer_size) {
+  snprintf(buffer, buffer_size, "%sloop_edit_%d_keys.hmi", exe_directory,
+           slot_index);
+}
+
+de100_file_scoped_fn inline void close_hash_fd(i32 *fd) {
+  if (*fd >= 0) {
+    de100_file_close(*fd);
+    *fd = -1;
+  }
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // RECORDING IMPLEMENTATION (Updated for Day 25)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -166,13 +193,12 @@ bool input_recording_begin(const char *exe_directory, GameMemoryState *state,
   get_input_filename(exe_directory, slot_index, input_filename,
                      sizeof(input_filename));
 
-  De100FileOpenResult open_result =
-      de100_file_open(input_filename, DE100_FILE_WRITE | DE100_FILE_CREATE |
-                                          DE100_FILE_TRUNCATE);
+  InputStreamResult open_result = input_stream_open_write(
+      &state->recording_stream, input_filename, &state->stream_info);
 
   if (!open_result.success) {
     fprintf(stderr, "[INPUT RECORDING] Failed to create input file: %s\n",
-            de100_file_strerror(open_result.error_code));
+            input_stream_strerror(open_result.error_code));
     return false;
   }
 
@@ -183,18 +209,47 @@ bool input_recording_begin(const char *exe_directory, GameMemoryState *state,
   // ─────────────────────────────────────────────────────────────────────
   printf("[INPUT RECORDING] 📼 Starting recording to slot %d\n", slot_index);
 
-  ReplayBufferResult save_result = replay_buffer_save_state(
-      replay_buffer, state->game_memory, state->total_size);
+  // Async: the game keeps running while a forked child writes the slot.
+  ReplayBufferResult save_result = replay_buffer_save_state_async(
+      replay_buffer, state->game_memory,
+      game_memory_state_committed_size(state), &state->dirty_pages);
   if (!save_result.success) {
     fprintf(stderr, "[INPUT RECORDING] Failed to save state: %s\n",
             replay_buffer_strerror(save_result.error_code));
-    de100_file_close(open_result.fd);
+    input_stream_close(&state->recording_stream);
     return false;
   }
 
-  state->recording_fd = open_result.fd;
   state->input_recording_index = slot_index;
 
+  // Hashes are optional: without them playback just isn't verified. A stale
+  // file from an older recording must not be checked against this one.
+  char hash_filename[256];
+  get_hash_filename(exe_directory, slot_index, hash_filename,
+                    sizeof(hash_filename));
+  if (state->state_hash.is_enabled) {
+    De100FileOpenResult hash_open =
+        de100_file_open(hash_filename, DE100_FILE_WRITE | DE100_FILE_CREATE |
+                                           DE100_FILE_TRUNCATE);
+    state->recording_hash_fd = hash_open.success ? hash_open.fd : -1;
+    if (hash_open.success &&
+        !async_writer_open(&state->recording_hash_writer, hash_open.fd, 0)) {
+      close_hash_fd(&state->recording_hash_fd);
+    }
+  } else {
+    de100_file_delete(hash_filename);
+  }
+
+  // Keyframes are optional too: without them playback can only seek by
+  // simulating from frame 0
+  char keyframes_filename[256];
+  get_keyframes_filename(exe_directory, slot_index, keyframes_filename,
+                         sizeof(keyframes_filename));
+  if (!replay_keyframes_begin_write(&state->keyframes, keyframes_filename,
+                                    game_memory_state_committed_size(state))) {
+    de100_file_delete(keyframes_filename);
+  }
+
   printf("[INPUT RECORDING] ✅ Recording started (slot %d)\n", slot_index);
   return true;
 }
@@ -205,13 +260,33 @@ void input_recording_record_frame(GameMemoryState *state,
     return;
   }
 
-  // Write input frame to file (this is small, file I/O is fine)
-  De100FileIOResult result =
-      de100_file_write_all(state->recording_fd, input, sizeof(GameInput));
+  // Report (and check) the background snapshot started by
+  // input_recording_begin(). A failed snapshot makes the recording useless.
+  ReplayBuffer *replay_buffer =
+      replay_buffer_get(state->replay_buffers, state->input_recording_index);
+  if (replay_buffer && replay_buffer->pending_save_pid > 0) {
+    ReplayBufferResult poll_result = replay_buffer_poll_save(replay_buffer);
+    if (!poll_result.success &&
+        poll_result.error_code != REPLAY_BUFFER_ERROR_SAVE_PENDING) {
+      fprintf(stderr, "[INPUT RECORDING] Snapshot failed: %s\n",
+              replay_buffer_strerror(poll_result.error_code));
+      input_recording_end(state);
+      return;
+    }
+  }
+
+  // Memory right now is the state this frame's input is applied to
+  replay_keyframes_maybe_capture(&state->keyframes,
+                                 state->recording_stream.frame_index,
+                                 game_memory_state_committed_size(state));
+
+  // Delta-encoded: a few bytes per frame (see input-stream.h)
+  InputStreamResult result =
+      input_stream_write(&state->recording_stream, input);
 
   if (!result.success) {
     fprintf(stderr, "[INPUT RECORDING] Failed to write input frame: %s\n",
-            de100_file_strerror(result.error_code));
+            input_stream_strerror(result.error_code));
     input_recording_end(state);
   }
 }
@@ -224,8 +299,13 @@ void input_recording_end(GameMemoryState *state) {
   printf("[INPUT RECORDING] ⏹️ Stopping recording (slot %d)\n",
          state->input_recording_index);
 
-  de100_file_close(state->recording_fd);
-  state->recording_fd = -1;
+  printf("[INPUT RECORDING] %llu frames, %.1f KB\n",
+         (unsigned long long)state->recording_stream.frame_index,
+         (f64)state->recording_stream.write_offset / 1024.0);
+  input_stream_close(&state->recording_stream);
+  replay_keyframes_end_write(&state->keyframes);
+  async_writer_close(&state->recording_hash_writer);
+  close_hash_fd(&state->recording_hash_fd);
   state->input_recording_index = 0;
 }
 
@@ -267,51 +347,194 @@ bool input_recording_playback_begin(const char *exe_directory,
   get_input_filename(exe_directory, slot_index, input_filename,
                      sizeof(input_filename));
 
-  De100FileOpenResult open_result =
-      de100_file_open(input_filename, DE100_FILE_READ);
+  InputStreamResult open_result = input_stream_open_read(
+      &state->playback_stream, input_filename, &state->stream_info);
 
   if (!open_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to open input file: %s\n",
-            de100_file_strerror(open_result.error_code));
+            input_stream_strerror(open_result.error_code));
     return false;
   }
 
   printf("[INPUT PLAYBACK] ▶️ Starting playback from slot %d\n", slot_index);
 
+  // The async snapshot from input_recording_begin() must land first
+  ReplayBufferResult wait_result = replay_buffer_wait_save(replay_buffer);
+  if (!wait_result.success) {
+    fprintf(stderr, "[INPUT PLAYBACK] Snapshot is unusable: %s\n",
+            replay_buffer_strerror(wait_result.error_code));
+    input_stream_close(&state->playback_stream);
+    return false;
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // FAST: Restore state from memory-mapped replay buffer (memcpy!)
   // ─────────────────────────────────────────────────────────────────────
-  ReplayBufferResult restore_result = replay_buffer_restore_state(
-      replay_buffer, state->game_memory, state->total_size);
+  ReplayBufferResult restore_result = replay_buffer_restore_state_incremental(
+      replay_buffer, state->game_memory,
+      game_memory_state_committed_size(state), &state->dirty_pages);
 
   if (!restore_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to restore state: %s\n",
             replay_buffer_strerror(restore_result.error_code));
-    de100_file_close(open_result.fd);
+    input_stream_close(&state->playback_stream);
     return false;
   }
-  state->playback_fd = open_result.fd;
   state->input_playing_index = slot_index;
 
+  state->playback_hash_frame = 0;
+  state->pending_seek_frame = -1;
+  state->first_divergent_frame = -1;
+  state->divergent_frame_count = 0;
+  if (state->state_hash.is_enabled) {
+    char hash_filename[256];
+    get_hash_filename(exe_directory, slot_index, hash_filename,
+                      sizeof(hash_filename));
+    De100FileOpenResult hash_open =
+        de100_file_open(hash_filename, DE100_FILE_READ);
+    state->playback_hash_fd = hash_open.success ? hash_open.fd : -1;
+  }
+
+  char keyframes_filename[256];
+  get_keyframes_filename(exe_directory, slot_index, keyframes_filename,
+                         sizeof(keyframes_filename));
+  if (replay_keyframes_open_read(&state->keyframes, keyframes_filename)) {
+    printf("[INPUT PLAYBACK] 🎯 %u keyframes, seekable\n",
+           state->keyframes.keyframe_count);
+  }
+
   printf("[INPUT PLAYBACK] ✅ Playback started (slot %d)\n", slot_index);
   return true;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// SEEK
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Runs inside playback_frame, where the loop restore runs too: this frame's
+// state hash was already checked, and its input is read right after.
+//
+//   restore slot (frame 0) ─> apply keyframe k ─> input stream to frame k
+//   ─> this frame plays input k, catch-up plays k+1 .. target
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void playback_seek_now(GameMemoryState *state,
+                                            u64 target_frame) {
+  f64 start_seconds = de100_get_wall_clock();
+
+  ReplayBuffer *replay_buffer =
+      replay_buffer_get(state->replay_buffers, state->input_playing_index);
+  if (!replay_buffer_is_valid(replay_buffer)) {
+    fprintf(stderr, "[INPUT PLAYBACK] Replay buffer became invalid\n");
+    input_recording_playback_end(state);
+    return;
+  }
+
+  u64 active_size = game_memory_state_committed_size(state);
+  ReplayBufferResult restore_result = replay_buffer_restore_state_incremental(
+      replay_buffer, state->game_memory, active_size, &state->dirty_pages);
+  if (!restore_result.success) {
+    fprintf(stderr, "[INPUT PLAYBACK] Failed to restore state for seek: %s\n",
+            replay_buffer_strerror(restore_result.error_code));
+    input_recording_playback_end(state);
+    return;
+  }
+
+  u32 keyframe = replay_keyframes_find(&state->keyframes, target_frame);
+  i64 restored = 0;
+  if (keyframe > 0) {
+    restored =
+        replay_keyframes_restore(&state->keyframes, keyframe, active_size);
+    if (restored < 0) {
+      fprintf(stderr, "[INPUT PLAYBACK] ⚠️  Keyframe %u unreadable, seeking "
+                      "from frame 0\n",
+              keyframe);
+      keyframe = 0;
+      restore_result = replay_buffer_restore_state_incremental(
+          replay_buffer, state->game_memory, active_size, &state->dirty_pages);
+      if (!restore_result.success) {
+        input_recording_playback_end(state);
+        return;
+      }
+    }
+  }
+  u64 start_frame = replay_keyframes_frame(&state->keyframes, keyframe);
+
+  InputStreamResult seek_result =
+      input_stream_seek(&state->playback_stream, start_frame);
+  if (!seek_result.success) {
+    fprintf(stderr, "[INPUT PLAYBACK] Failed to seek input: %s\n",
+            input_stream_strerror(seek_result.error_code));
+    input_recording_playback_end(state);
+    return;
+  }
+
+  // The restored state is recorded frame start_frame, already past this
+  // frame's check, so checking resumes at start_frame + 1
+  if (state->playback_hash_fd >= 0) {
+    if (de100_file_seek(state->playback_hash_fd,
+                        (i64)((start_frame + 1) * sizeof(u64)),
+                        DE100_SEEK_SET)
+            .success) {
+      state->playback_hash_frame = start_frame + 1;
+    } else {
+      close_hash_fd(&state->playback_hash_fd);
+    }
+  }
+
+  playback_speed_catch_up(&state->playback_speed, target_frame - start_frame);
+
+  printf("[INPUT PLAYBACK] ⏩ Seek to frame %llu: keyframe at %llu (%.1f KB "
+         "restored in %.2fms), simulating %llu frames\n",
+         (unsigned long long)target_frame, (unsigned long long)start_frame,
+         (f64)restored / 1024.0,
+         (de100_get_wall_clock() - start_seconds) * 1000.0,
+         (unsigned long long)(target_frame - start_frame));
+}
+
+bool input_recording_playback_seek(GameMemoryState *state, u64 frame_index) {
+  if (state->input_playing_index == 0) {
+    return false;
+  }
+
+  u64 frame_count = input_stream_frame_count(&state->playback_stream);
+  if (frame_count == 0) {
+    return false;
+  }
+  if (frame_index >= frame_count) {
+    frame_index = frame_count - 1;
+  }
+
+  state->pending_seek_frame = (i64)frame_index;
+  // Held (STEP) frames never reach playback_frame; make sure one does
+  playback_speed_catch_up(&state->playback_speed, 1);
+  return true;
+}
+
 void input_recording_playback_frame(GameMemoryState *state, GameInput *input) {
   if (state->input_playing_index == 0) {
     return;
   }
 
-  De100FileIOResult read_result =
-      de100_file_read_all(state->playback_fd, input, sizeof(GameInput));
+  if (state->pending_seek_frame >= 0) {
+    playback_seek_now(state, (u64)state->pending_seek_frame);
+    state->pending_seek_frame = -1;
+    if (state->input_playing_index == 0) {
+      return; // Seek failed and ended playback
+    }
+  }
+
+  InputStreamResult read_result =
+      input_stream_read(&state->playback_stream, input);
 
   if (read_result.success) {
     return;
   }
 
-  if (!read_result.success && read_result.error_code != DE100_FILE_ERROR_EOF) {
+  if (read_result.error_code != INPUT_STREAM_ERROR_END_OF_STREAM) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to read input: %s\n",
-            de100_file_strerror(read_result.error_code));
+            input_stream_strerror(read_result.error_code));
     input_recording_playback_end(state);
     return;
   }
@@ -320,13 +543,13 @@ void input_recording_playback_frame(GameMemoryState *state, GameInput *input) {
   i32 slot = state->input_playing_index;
   printf("[INPUT PLAYBACK] 🔄 Looping back to start (slot %d)\n", slot);
 
-  // Seek back to beginning of input file
-  De100FileSizeResult seek_result =
-      de100_file_seek(state->playback_fd, 0, DE100_SEEK_SET);
+  // Seek back to the first frame (a keyframe, so this is O(1))
+  InputStreamResult seek_result =
+      input_stream_seek(&state->playback_stream, 0);
 
   if (!seek_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to seek: %s\n",
-            de100_file_strerror(seek_result.error_code));
+            input_stream_strerror(seek_result.error_code));
     input_recording_playback_end(state);
     return;
   }
@@ -342,8 +565,9 @@ void input_recording_playback_frame(GameMemoryState *state, GameInput *input) {
     return;
   }
 
-  ReplayBufferResult restore_result = replay_buffer_restore_state(
-      replay_buffer, state->game_memory, state->total_size);
+  ReplayBufferResult restore_result = replay_buffer_restore_state_incremental(
+      replay_buffer, state->game_memory,
+      game_memory_state_committed_size(state), &state->dirty_pages);
 
   if (!restore_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to restore state on loop: %s\n",
@@ -352,13 +576,22 @@ void input_recording_playback_frame(GameMemoryState *state, GameInput *input) {
     return;
   }
 
+  // The restored state IS recorded frame 0, so checking resumes at frame 1
+  if (state->playback_hash_fd >= 0) {
+    if (de100_file_seek(state->playback_hash_fd, sizeof(u64), DE100_SEEK_SET)
+            .success) {
+      state->playback_hash_frame = 1;
+    } else {
+      close_hash_fd(&state->playback_hash_fd);
+    }
+  }
+
   // Read first input frame
-  read_result =
-      de100_file_read_all(state->playback_fd, input, sizeof(GameInput));
+  read_result = input_stream_read(&state->playback_stream, input);
 
   if (!read_result.success) {
     fprintf(stderr, "[INPUT PLAYBACK] Failed to read first input on loop: %s\n",
-            de100_file_strerror(read_result.error_code));
+            input_stream_strerror(read_result.error_code));
     input_recording_playback_end(state);
     return;
   }
@@ -372,11 +605,79 @@ void input_recording_playback_end(GameMemoryState *state) {
   printf("[INPUT PLAYBACK] ⏹️ Stopping playback (slot %d)\n",
          state->input_playing_index);
 
-  de100_file_close(state->playback_fd);
-  state->playback_fd = -1;
+  if (state->divergent_frame_count > 0) {
+    printf("[INPUT PLAYBACK] ❌ Not deterministic: %llu frames diverged, "
+           "first at frame %lld\n",
+           (unsigned long long)state->divergent_frame_count,
+           (long long)state->first_divergent_frame);
+  }
+
+  input_stream_close(&state->playback_stream);
+  replay_keyframes_close_read(&state->keyframes);
+  close_hash_fd(&state->playback_hash_fd);
   state->input_playing_index = 0;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// DETERMINISM CHECK
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// Runs at the start of every frame, before that frame's input is recorded or
+// played, so hash N is "the state input N is applied to":
+//
+//   recording:  begin (snapshot)  | hash 0, input 0 | hash 1, input 1 | ...
+//   playback:   begin (restore)   | check 0, input 0 | check 1, input 1 | ...
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+void input_recording_hash_frame(GameMemoryState *state) {
+  bool recording = state->recording_hash_fd >= 0;
+  bool playing = state->playback_hash_fd >= 0;
+  if (!recording && !playing) {
+    return;
+  }
+  TIMED_FUNCTION();
+
+  u64 hash = state_hash_update(&state->state_hash,
+                               game_memory_state_committed_size(state));
+
+  if (recording &&
+      !async_writer_append(&state->recording_hash_writer, &hash,
+                           sizeof(hash))) {
+    fprintf(stderr, "[INPUT RECORDING] Failed to write state hash, "
+                    "recording won't be verifiable\n");
+    async_writer_close(&state->recording_hash_writer);
+    close_hash_fd(&state->recording_hash_fd);
+  }
+
+  if (!playing) {
+    return;
+  }
+
+  u64 expected = 0;
+  if (!de100_file_read_all(state->playback_hash_fd, &expected,
+                           sizeof(expected))
+           .success) {
+    // Past the last recorded frame (the one that loops back), or a short
+    // file: nothing to compare. The loop restore seeks back.
+    return;
+  }
+
+  u64 frame = state->playback_hash_frame++;
+  if (hash == expected) {
+    return;
+  }
+
+  if (state->first_divergent_frame < 0) {
+    state->first_divergent_frame = (i64)frame;
+    printf("[INPUT PLAYBACK] ❌ State diverged from the recording at frame "
+           "%llu (slot %d): expected %016llx, got %016llx\n",
+           (unsigned long long)frame, state->input_playing_index,
+           (unsigned long long)expected, (unsigned long long)hash);
+  }
+  state->divergent_frame_count++;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // TOGGLE FUNCTION (Updated for Day 25 - Can Exit Playback!)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -46,12 +46,30 @@ bool input_recording_playback_begin(const char *exe_directory,
  */
 void input_recording_playback_frame(GameMemoryState *state, GameInput *input);
 
+/**
+ * Jump playback so the next presented frame is recorded frame
+ * `frame_index` (clamped to the recording). Restores the nearest keyframe
+ * at or before it, then simulates the rest uncapped (see
+ * playback_speed_catch_up). Takes effect on the next playback frame.
+ *
+ * @return false when not playing back
+ */
+bool input_recording_playback_seek(GameMemoryState *state, u64 frame_index);
+
 /**
  * End playback.
  * Closes input file.
  */
 void input_recording_playback_end(GameMemoryState *state);
 
+/**
+ * Per-frame determinism check (GameConfig.check_replay_determinism).
+ * Call once per frame before the frame's input is recorded or played back:
+ * while recording it stores the state hash, during playback it compares and
+ * reports the first frame that diverged. No-op otherwise.
+ */
+void input_recording_hash_frame(GameMemoryState *state);
+
 typedef enum {
   INPUT_RECORDING_TOGGLE_STARTTED_RECORDING,
   INPUT_RECORDING_TOGGLE_SWITCHED_TO_PLAYBACK,
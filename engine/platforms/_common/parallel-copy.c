@@ -0,0 +1,424 @@
+#include "./parallel-copy.h"
+#include "../../_common/memory.h"
+#include "../../_common/time.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define PARALLEL_COPY_HAS_THREADS 0
+#else
+#define PARALLEL_COPY_HAS_THREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PARALLEL_COPY_HAS_STREAMING 1
+#else
+#define PARALLEL_COPY_HAS_STREAMING 0
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// JOBS
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u8 *dst;
+  const u8 *src;
+  u64 size;
+
+  // Dirty-run mode when tracker != NULL (size is then the limit)
+  const DirtyPageTracker *tracker;
+  i32 channel;
+
+  bool non_temporal;
+  u32 thread_count;
+  u64 copied[PARALLEL_COPY_MAX_THREADS];
+} ParallelCopyJob;
+
+typedef struct {
+  bool is_running;
+  u32 thread_count; // Caller included
+
+#if PARALLEL_COPY_HAS_THREADS
+  pthread_t threads[PARALLEL_COPY_MAX_THREADS];
+  pthread_mutex_t mutex;
+  pthread_cond_t work_ready;
+  pthread_cond_t work_done;
+#endif
+
+  ParallelCopyJob *job;
+  u64 generation; // Bumped per job; workers wait for it to change
+  u32 remaining;  // Workers still on the current job
+  bool quit;
+} ParallelCopyPool;
+
+de100_file_scoped_global_var ParallelCopyPool g_parallel_copy = {
+    .thread_count = 1,
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COPY KERNELS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void copy_block(u8 *dst, const u8 *src, u64 size,
+                                     bool non_temporal) {
+#if PARALLEL_COPY_HAS_STREAMING
+  if (non_temporal && size >= 256) {
+    // Align the destination, stream 64 bytes (one cache line) at a time
+    u64 head = (16 - ((uintptr_t)dst & 15)) & 15;
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    size -= head;
+
+    u64 body = size & ~(u64)63;
+    for (u64 i = 0; i < body; i += 64) {
+      __m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+      __m128i b = _mm_loadu_si128((const __m128i *)(src + i + 16));
+      __m128i c = _mm_loadu_si128((const __m128i *)(src + i + 32));
+      __m128i d = _mm_loadu_si128((const __m128i *)(src + i + 48));
+      _mm_stream_si128((__m128i *)(dst + i), a);
+      _mm_stream_si128((__m128i *)(dst + i + 16), b);
+      _mm_stream_si128((__m128i *)(dst + i + 32), c);
+      _mm_stream_si128((__m128i *)(dst + i + 48), d);
+    }
+    memcpy(dst + body, src + body, size - body);
+    return;
+  }
+#else
+  (void)non_temporal;
+#endif
+  memcpy(dst, src, size);
+}
+
+de100_file_scoped_fn inline void copy_fence(bool non_temporal) {
+#if PARALLEL_COPY_HAS_STREAMING
+  // Streaming stores are weakly ordered; publish them before reporting done
+  if (non_temporal) {
+    _mm_sfence();
+  }
+#else
+  (void)non_temporal;
+#endif
+}
+
+/** Do thread `index`'s share of `job`. */
+de100_file_scoped_fn void run_share(ParallelCopyJob *job, u32 index) {
+  u64 copied = 0;
+
+  if (!job->tracker) {
+    // One contiguous slice each, cache-line aligned; the last thread takes
+    // whatever is left through to size
+    u64 slice =
+        ((job->size + job->thread_count - 1) / job->thread_count + 63) &
+        ~(u64)63;
+    u64 start = (u64)index * slice;
+    if (start < job->size) {
+      u64 bytes = job->size - start < slice || index == job->thread_count - 1
+                      ? job->size - start
+                      : slice;
+      copy_block(job->dst + start, job->src + start, bytes,
+                 job->non_temporal);
+      copied = bytes;
+    }
+  } else {
+    u64 cursor = 0, offset = 0, size = 0;
+    while (dirty_pages_next_run(job->tracker, job->channel, job->size,
+                                &cursor, &offset, &size)) {
+      u64 end = offset + size;
+      u64 block = offset / PARALLEL_COPY_BLOCK_SIZE;
+      // Jump to this thread's first block in the run
+      block += (index + job->thread_count - block % job->thread_count) %
+               job->thread_count;
+
+      for (u64 block_start = block * PARALLEL_COPY_BLOCK_SIZE;
+           block_start < end;
+           block_start += (u64)job->thread_count * PARALLEL_COPY_BLOCK_SIZE) {
+        u64 from = block_start > offset ? block_start : offset;
+        u64 to = block_start + PARALLEL_COPY_BLOCK_SIZE < end
+                     ? block_start + PARALLEL_COPY_BLOCK_SIZE
+                     : end;
+        copy_block(job->dst + from, job->src + from, to - from,
+                   job->non_temporal);
+        copied += to - from;
+      }
+    }
+  }
+
+  copy_fence(job->non_temporal);
+  job->copied[index] = copied;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// POOL
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if PARALLEL_COPY_HAS_THREADS
+de100_file_scoped_fn void *worker_main(void *arg) {
+  ParallelCopyPool *pool = &g_parallel_copy;
+  u32 index = (u32)(uintptr_t)arg;
+  u64 seen_generation = 0;
+
+  pthread_mutex_lock(&pool->mutex);
+  for (;;) {
+    while (!pool->quit && pool->generation == seen_generation) {
+      pthread_cond_wait(&pool->work_ready, &pool->mutex);
+    }
+    if (pool->quit) {
+      break;
+    }
+    seen_generation = pool->generation;
+    ParallelCopyJob *job = pool->job;
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (index < job->thread_count) {
+      run_share(job, index);
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->remaining == 0) {
+      pthread_cond_signal(&pool->work_done);
+    }
+  }
+  pthread_mutex_unlock(&pool->mutex);
+  return NULL;
+}
+#endif
+
+bool parallel_copy_init(u32 thread_count) {
+  ParallelCopyPool *pool = &g_parallel_copy;
+  if (pool->is_running) {
+    return true;
+  }
+
+#if PARALLEL_COPY_HAS_THREADS
+  if (thread_count == 0) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    thread_count = cores > 0 ? (u32)cores : 1;
+  }
+  if (thread_count > PARALLEL_COPY_MAX_THREADS) {
+    thread_count = PARALLEL_COPY_MAX_THREADS;
+  }
+  if (thread_count <= 1) {
+    pool->thread_count = 1;
+    return false;
+  }
+
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->work_ready, NULL);
+  pthread_cond_init(&pool->work_done, NULL);
+  pool->generation = 0;
+  pool->quit = false;
+
+  // Thread 0 is whoever calls parallel_copy()
+  u32 started = 1;
+  for (u32 i = 1; i < thread_count; ++i) {
+    if (pthread_create(&pool->threads[i], NULL, worker_main,
+                       (void *)(uintptr_t)i) != 0) {
+      break;
+    }
+    started++;
+  }
+
+  pool->thread_count = started;
+  pool->is_running = true;
+  if (started == 1) {
+    parallel_copy_shutdown();
+    return false;
+  }
+  return true;
+#else
+  (void)thread_count;
+  pool->thread_count = 1;
+  return false;
+#endif
+}
+
+void parallel_copy_shutdown(void) {
+  ParallelCopyPool *pool = &g_parallel_copy;
+  if (!pool->is_running) {
+    return;
+  }
+
+#if PARALLEL_COPY_HAS_THREADS
+  pthread_mutex_lock(&pool->mutex);
+  pool->quit = true;
+  pthread_cond_broadcast(&pool->work_ready);
+  pthread_mutex_unlock(&pool->mutex);
+
+  for (u32 i = 1; i < pool->thread_count; ++i) {
+    pthread_join(pool->threads[i], NULL);
+  }
+
+  pthread_cond_destroy(&pool->work_done);
+  pthread_cond_destroy(&pool->work_ready);
+  pthread_mutex_destroy(&pool->mutex);
+#endif
+
+  pool->is_running = false;
+  pool->thread_count = 1;
+}
+
+u32 parallel_copy_thread_count(void) { return g_parallel_copy.thread_count; }
+
+/** Run `job` on the caller plus every worker; returns total bytes copied. */
+de100_file_scoped_fn u64 run_job(ParallelCopyJob *job) {
+  ParallelCopyPool *pool = &g_parallel_copy;
+
+#if PARALLEL_COPY_HAS_THREADS
+  if (pool->is_running && job->thread_count > 1) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->job = job;
+    pool->remaining = pool->thread_count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->mutex);
+
+    run_share(job, 0);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->remaining > 0) {
+      pthread_cond_wait(&pool->work_done, &pool->mutex);
+    }
+    pool->job = NULL;
+    pthread_mutex_unlock(&pool->mutex);
+  } else
+#endif
+  {
+    job->thread_count = 1;
+    run_share(job, 0);
+  }
+
+  u64 copied = 0;
+  for (u32 i = 0; i < job->thread_count; ++i) {
+    copied += job->copied[i];
+  }
+  return copied;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC COPIES
+// ═══════════════════════════════════════════════════════════════════════════
+
+void parallel_copy(void *dst, const void *src, u64 size) {
+  if (!dst || !src || size == 0) {
+    return;
+  }
+
+  ParallelCopyJob job = {
+      .dst = (u8 *)dst,
+      .src = (const u8 *)src,
+      .size = size,
+      .non_temporal = size >= PARALLEL_COPY_NON_TEMPORAL_MIN_SIZE,
+      .thread_count =
+          size >= PARALLEL_COPY_MIN_SIZE ? g_parallel_copy.thread_count : 1,
+  };
+  run_job(&job);
+}
+
+u64 parallel_copy_dirty_runs(void *dst, const void *src, u64 limit,
+                             const DirtyPageTracker *tracker, i32 channel) {
+  u64 dirty = dirty_pages_dirty_bytes(tracker, channel, limit);
+  if (dirty == 0) {
+    return 0;
+  }
+
+  ParallelCopyJob job = {
+      .dst = (u8 *)dst,
+      .src = (const u8 *)src,
+      .size = limit,
+      .tracker = tracker,
+      .channel = channel,
+      .non_temporal = dirty >= PARALLEL_COPY_NON_TEMPORAL_MIN_SIZE,
+      .thread_count =
+          dirty >= PARALLEL_COPY_MIN_SIZE ? g_parallel_copy.thread_count : 1,
+  };
+  return run_job(&job);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BENCHMARK
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn f64 bench_best_of(ParallelCopyJob *job, u32 runs) {
+  f64 best = 1e9;
+  for (u32 r = 0; r < runs; ++r) {
+    u32 thread_count = job->thread_count;
+    f64 start = de100_get_wall_clock();
+    run_job(job);
+    f64 elapsed = de100_get_wall_clock() - start;
+    job->thread_count = thread_count;
+    if (elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+void parallel_copy_benchmark(u64 size) {
+  size &= ~(u64)63;
+  if (size == 0) {
+    return;
+  }
+
+  De100MemoryBlock src = de100_memory_alloc(NULL, (size_t)size,
+                                            De100_MEMORY_FLAG_RW_ZEROED);
+  De100MemoryBlock dst = de100_memory_alloc(NULL, (size_t)size,
+                                            De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(src) || !de100_memory_is_valid(dst)) {
+    fprintf(stderr, "[PARALLEL COPY] Benchmark: failed to allocate 2 x %.1f "
+                    "MB\n",
+            (f64)size / (1024.0 * 1024.0));
+    if (de100_memory_is_valid(src)) {
+      de100_memory_free(&src);
+    }
+    if (de100_memory_is_valid(dst)) {
+      de100_memory_free(&dst);
+    }
+    return;
+  }
+
+  // Fault everything in first so the runs measure copying, not page faults
+  memset(src.base, 0xA5, (size_t)size);
+  memset(dst.base, 0x5A, (size_t)size);
+
+  struct {
+    const char *name;
+    u32 thread_count;
+    bool non_temporal;
+  } variants[] = {
+      {"serial memcpy", 1, false},
+      {"serial streaming", 1, true},
+      {"parallel memcpy", g_parallel_copy.thread_count, false},
+      {"parallel streaming", g_parallel_copy.thread_count, true},
+  };
+
+  printf("[PARALLEL COPY] Benchmark: %.1f MB, %u threads, streaming stores "
+         "%s\n",
+         (f64)size / (1024.0 * 1024.0), g_parallel_copy.thread_count,
+         PARALLEL_COPY_HAS_STREAMING ? "available" : "unavailable");
+
+  f64 baseline = 0.0;
+  for (u32 v = 0; v < ArraySize(variants); ++v) {
+    ParallelCopyJob job = {
+        .dst = (u8 *)dst.base,
+        .src = (const u8 *)src.base,
+        .size = size,
+        .non_temporal = variants[v].non_temporal,
+        .thread_count = variants[v].thread_count,
+    };
+    f64 seconds = bench_best_of(&job, 5);
+    if (v == 0) {
+      baseline = seconds;
+    }
+    printf("[PARALLEL COPY]   %-20s %8.2f ms  %8.0f MB/s  %.2fx\n",
+           variants[v].name, seconds * 1000.0,
+           (f64)size / (1024.0 * 1024.0) / seconds, baseline / seconds);
+  }
+
+  de100_memory_free(&dst);
+  de100_memory_free(&src);
+}
@@ -0,0 +1,69 @@
+#ifndef DE100_PLATFORMS__COMMON_PARALLEL_COPY_H
+#define DE100_PLATFORMS__COMMON_PARALLEL_COPY_H
+
+#include "../../_common/base.h"
+#include "./dirty-pages.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⚡ PARALLEL SNAPSHOT COPY
+// ═══════════════════════════════════════════════════════════════════════════
+// Replay save/restore copy up to all of game memory, and playback restores
+// on every loop. One core can't saturate memory bandwidth, so big copies are
+// split across a small pool of worker threads (the caller works too).
+//
+//   contiguous copy:  [ t0 | t1 | t2 | t3 ]        one slice per thread
+//   dirty runs:       blocks of PARALLEL_COPY_BLOCK_SIZE, block i goes to
+//                     thread i % thread_count (every thread walks the same
+//                     runs and skips blocks that aren't its own)
+//
+// Copies at least PARALLEL_COPY_NON_TEMPORAL_MIN_SIZE use non-temporal
+// (streaming) stores where the CPU has them, so a 1 GB snapshot doesn't
+// evict the whole cache on its way through.
+//
+// The pool is process-global and NOT fork-safe: only the calling thread
+// exists in a fork()ed child, so writer children must copy serially.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define PARALLEL_COPY_MAX_THREADS 8
+#define PARALLEL_COPY_BLOCK_SIZE MEGABYTES(1)
+// Below this, waking workers costs more than it saves
+#define PARALLEL_COPY_MIN_SIZE MEGABYTES(4)
+#define PARALLEL_COPY_NON_TEMPORAL_MIN_SIZE MEGABYTES(8)
+
+/**
+ * Start the worker pool.
+ *
+ * @param thread_count  Threads per copy, caller included. 0 = one per core
+ *                      (capped at PARALLEL_COPY_MAX_THREADS), 1 = no pool.
+ * @return              false if no workers could be started (copies still
+ *                      work, single-threaded)
+ */
+bool parallel_copy_init(u32 thread_count);
+
+/** Stop and join the workers. Idempotent. */
+void parallel_copy_shutdown(void);
+
+/** Threads a copy fans out to (1 when the pool isn't running). */
+u32 parallel_copy_thread_count(void);
+
+/** memcpy, fanned out across the pool when large enough. */
+void parallel_copy(void *dst, const void *src, u64 size);
+
+/**
+ * Copy every dirty run of `channel` below `limit` from src to dst (both
+ * laid out like the tracked range).
+ *
+ * @return Bytes copied
+ */
+u64 parallel_copy_dirty_runs(void *dst, const void *src, u64 limit,
+                             const DirtyPageTracker *tracker, i32 channel);
+
+/**
+ * Time the serial memcpy against the pool (regular and streaming stores)
+ * over `size` bytes and print MB/s. Allocates 2 x size.
+ */
+void parallel_copy_benchmark(u64 size);
+
+#endif // DE100_PLATFORMS__COMMON_PARALLEL_COPY_H
@@ -0,0 +1,125 @@
+#include "./playback-speed.h"
+
+#include <stdio.h>
+
+de100_file_scoped_global_var const char *g_playback_speed_mode_names[] = {
+    [PLAYBACK_SPEED_REALTIME] = "realtime",
+    [PLAYBACK_SPEED_SCALED] = "scaled",
+    [PLAYBACK_SPEED_FAST_FORWARD] = "fast-forward",
+    [PLAYBACK_SPEED_STEP] = "step",
+};
+
+const char *playback_speed_mode_name(PlaybackSpeedMode mode) {
+  if (mode >= 0 && (u32)mode < ArraySize(g_playback_speed_mode_names)) {
+    return g_playback_speed_mode_names[mode];
+  }
+  return "unknown";
+}
+
+void playback_speed_set_mode(PlaybackSpeed *speed, PlaybackSpeedMode mode,
+                             u32 param) {
+  speed->mode = mode;
+  speed->pending_steps = 0;
+  speed->frames_since_present = 0;
+
+  switch (mode) {
+  case PLAYBACK_SPEED_SCALED:
+    speed->multiplier = param < 1 ? 1 : param;
+    if (speed->multiplier > PLAYBACK_SPEED_MAX_MULTIPLIER) {
+      speed->multiplier = PLAYBACK_SPEED_MAX_MULTIPLIER;
+    }
+    printf("[PLAYBACK] ⏩ %ux speed\n", speed->multiplier);
+    break;
+  case PLAYBACK_SPEED_FAST_FORWARD:
+    speed->present_interval = param ? param : 1;
+    printf("[PLAYBACK] ⏭️  Fast-forward (presenting 1 frame in %u)\n",
+           speed->present_interval);
+    break;
+  case PLAYBACK_SPEED_STEP:
+    printf("[PLAYBACK] ⏸️  Stepping\n");
+    break;
+  case PLAYBACK_SPEED_REALTIME:
+  default:
+    speed->mode = PLAYBACK_SPEED_REALTIME;
+    printf("[PLAYBACK] ▶️  Realtime\n");
+    break;
+  }
+}
+
+void playback_speed_step(PlaybackSpeed *speed, u32 frames) {
+  if (speed->mode == PLAYBACK_SPEED_STEP) {
+    speed->pending_steps += frames;
+  }
+}
+
+void playback_speed_catch_up(PlaybackSpeed *speed, u64 frames) {
+  speed->catch_up_frames = frames;
+}
+
+/** Present 1 frame in `interval`, counting from the last one presented. */
+de100_file_scoped_fn inline bool should_present(PlaybackSpeed *speed,
+                                                u32 interval) {
+  if (++speed->frames_since_present >= interval) {
+    speed->frames_since_present = 0;
+    return true;
+  }
+  return false;
+}
+
+PlaybackPacing playback_speed_pace(PlaybackSpeed *speed, bool is_playing,
+                                   f32 target_seconds_per_frame) {
+  PlaybackPacing pacing = {
+      .advance = true,
+      .update_count = 1,
+      .present = true,
+      .is_realtime = true,
+      .target_seconds_per_frame = target_seconds_per_frame,
+  };
+  speed->is_holding = false;
+
+  if (!is_playing) {
+    speed->catch_up_frames = 0;
+    return pacing;
+  }
+
+  if (speed->catch_up_frames > 0) {
+    speed->catch_up_frames--;
+    pacing.is_realtime = false;
+    pacing.target_seconds_per_frame = 0.0f;
+    pacing.present = speed->catch_up_frames == 0;
+    return pacing;
+  }
+
+  switch (speed->mode) {
+  case PLAYBACK_SPEED_SCALED:
+    pacing.is_realtime = speed->multiplier == 1;
+    pacing.target_seconds_per_frame =
+        target_seconds_per_frame / (f32)speed->multiplier;
+    pacing.present = should_present(speed, speed->multiplier);
+    break;
+
+  case PLAYBACK_SPEED_FAST_FORWARD:
+    pacing.is_realtime = false;
+    pacing.target_seconds_per_frame = 0.0f;
+    pacing.present = should_present(speed, speed->present_interval);
+    break;
+
+  case PLAYBACK_SPEED_STEP:
+    // Keep sleeping at the normal rate so a paused game doesn't spin
+    pacing.is_realtime = false;
+    if (speed->pending_steps > 0) {
+      speed->pending_steps--;
+    } else {
+      pacing.advance = false;
+      pacing.update_count = 0;
+      speed->is_holding = true;
+    }
+    break;
+
+  case PLAYBACK_SPEED_REALTIME:
+  default:
+    break;
+  }
+
+  return pacing;
+}
@@ -0,0 +1,87 @@
+#ifndef DE100_PLATFORMS__COMMON_PLAYBACK_SPEED_H
+#define DE100_PLATFORMS__COMMON_PLAYBACK_SPEED_H
+
+#include "../../_common/base.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⏩ PLAYBACK SPEED (How fast input playback runs)
+// ═══════════════════════════════════════════════════════════════════════════
+// Playback normally runs at the wall-clock frame rate like live play. To get
+// to the interesting part of a long recording faster (or to crawl through
+// it), game adapters pick a mode; backends ask for the pacing of each frame
+// and skip the sleep / present / update accordingly:
+//
+//   REALTIME      1 frame per target frame time (default)
+//   SCALED        N x speed: sleeps target / N, presents 1 frame in N
+//   FAST_FORWARD  Never sleeps, presents 1 frame in `present_interval`
+//   STEP          Paused: holds the current frame until playback_speed_step
+//                 queues more (1 = single-step)
+//
+// After a seek (input_recording_playback_seek), the frames between the
+// restored keyframe and the target run as catch-up first: uncapped, not
+// presented until the last one, whatever the mode.
+//
+// Only applies while playback is running; recording and live play are
+// always realtime. A held frame consumes no input and is not hashed, so the
+// determinism check and the input stream stay in step with the recording.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define PLAYBACK_SPEED_MAX_MULTIPLIER 64
+
+typedef enum {
+  PLAYBACK_SPEED_REALTIME = 0,
+  PLAYBACK_SPEED_SCALED,
+  PLAYBACK_SPEED_FAST_FORWARD,
+  PLAYBACK_SPEED_STEP,
+} PlaybackSpeedMode;
+
+typedef struct {
+  PlaybackSpeedMode mode;
+  u32 multiplier;       // SCALED
+  u32 present_interval; // FAST_FORWARD (1 = present every frame)
+  u32 pending_steps;    // STEP
+  u64 catch_up_frames;  // Seek: frames to simulate before the mode applies
+
+  // Set by playback_speed_pace for the current frame
+  bool is_holding;
+  u64 frames_since_present;
+} PlaybackSpeed;
+
+/** What the backend does this frame. */
+typedef struct {
+  bool advance;     // Consume an input frame and run update_and_render
+  u32 update_count; // Updates to run (advance ? 1 : 0 here; engine_pace_frame
+                    // applies the fixed timestep on top)
+  bool present;     // Show the backbuffer
+  bool is_realtime; // Frame time is meaningful (stats, adaptive FPS)
+  f32 target_seconds_per_frame; // Sleep target, 0 = don't sleep
+} PlaybackPacing;
+
+/**
+ * @param param  SCALED: speed multiplier (clamped to 1..MAX_MULTIPLIER)
+ *               FAST_FORWARD: present 1 frame in `param` (0 = 1)
+ *               Ignored otherwise
+ */
+void playback_speed_set_mode(PlaybackSpeed *speed, PlaybackSpeedMode mode,
+                             u32 param);
+
+/** STEP mode: advance `frames` more frames (1 = single-step). */
+void playback_speed_step(PlaybackSpeed *speed, u32 frames);
+
+/** Run the next `frames` frames as fast as possible, presenting the last. */
+void playback_speed_catch_up(PlaybackSpeed *speed, u64 frames);
+
+/**
+ * Decide the current frame. Call once per frame before engine_begin_frame.
+ *
+ * @param is_playing               Input playback is running
+ * @param target_seconds_per_frame The realtime frame budget
+ */
+PlaybackPacing playback_speed_pace(PlaybackSpeed *speed, bool is_playing,
+                                   f32 target_seconds_per_frame);
+
+const char *playback_speed_mode_name(PlaybackSpeedMode mode);
+
+#endif // DE100_PLATFORMS__COMMON_PLAYBACK_SPEED_H
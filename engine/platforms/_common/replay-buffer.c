@@ -1,6 +1,9 @@
 #include "./replay-buffer.h"
+#include "./parallel-copy.h"
+#include "../../_common/compress.h"
 #include "../../_common/file.h"
 #include "../../_common/memory.h"
+#include "../../_common/time.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -18,6 +21,7 @@
     defined(__unix__) || defined(__MACH__)
 #include <errno.h>
 #include <sys/mman.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #else
 #error "Unsupported platform for replay buffer"
@@ -41,6 +45,8 @@ de100_file_scoped_global_var const char *g_replay_buffer_error_messages[] = {
         "Failed to memory-map replay buffer file",
     [REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID] = "Replay buffer is not valid",
     [REPLAY_BUFFER_ERROR_SAVE_FAILED] = "Failed to save state to replay buffer",
+    [REPLAY_BUFFER_ERROR_SAVE_PENDING] =
+        "Snapshot is still being written in the background",
     [REPLAY_BUFFER_ERROR_RESTORE_FAILED] =
         "Failed to restore state from replay buffer",
 };
@@ -69,6 +75,13 @@ make_result(bool success, ReplayBufferErrorCode code) {
   return (ReplayBufferResult){.success = success, .error_code = code};
 }
 
+de100_file_scoped_fn inline bool
+replay_buffer_can_increment(const ReplayBuffer *buffer,
+                            const DirtyPageTracker *tracker) {
+  return buffer && dirty_pages_is_active(tracker) &&
+         buffer->dirty_channel != DIRTY_PAGES_NO_CHANNEL;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // PLATFORM-SPECIFIC MMAP WRAPPERS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -190,12 +203,351 @@ de100_file_scoped_fn bool de100_file_resize(i32 fd, u64 size) {
 
 #endif // Platform selection
 
+// ═══════════════════════════════════════════════════════════════════════════
+// COMPRESSED SLOT FILES
+// ═══════════════════════════════════════════════════════════════════════════
+//
+//   [ReplaySlotFileHeader]
+//   [chunk data ...]            LZ block, or raw when stored_size == chunk
+//   [ReplaySlotChunk x stored]  sparse index, ascending chunk_index
+//
+// Chunks missing from the index are all zeros. Saves write "<slot>.tmp" and
+// rename() it over the slot, so a crashed writer never leaves a torn file.
+// Nothing here touches stdio: saves also run on the fork()ed writer.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define REPLAY_SLOT_MAGIC 0x544C5344u // "DSLT"
+#define REPLAY_SLOT_VERSION 1u
+#define REPLAY_SLOT_NO_CHUNK 0xFFFFFFFFu
+
+typedef struct {
+  u32 magic;
+  u32 version;
+  u64 saved_size; // Game memory bytes the snapshot covers
+  u32 chunk_size;
+  u32 stored_count;
+  u64 index_offset;
+} ReplaySlotFileHeader;
+
+typedef struct {
+  u32 chunk_index;
+  u32 stored_size; // < chunk bytes: LZ block, == chunk bytes: raw
+  u64 file_offset;
+} ReplaySlotChunk;
+
+/** Scratch layout: index[max_chunks] | lookup[max_chunks] | chunk buffer */
+typedef struct {
+  ReplaySlotChunk *index;
+  u32 *lookup; // chunk_index -> index entry (REPLAY_SLOT_NO_CHUNK = zeros)
+  u8 *chunk;
+  u64 chunk_capacity;
+  u64 max_chunks;
+} ReplaySlotScratch;
+
+de100_file_scoped_fn inline u64 slot_chunk_count(u64 size) {
+  return (size + REPLAY_SLOT_CHUNK_SIZE - 1) / REPLAY_SLOT_CHUNK_SIZE;
+}
+
+de100_file_scoped_fn inline u64 slot_scratch_size(u64 total_size) {
+  u64 max_chunks = slot_chunk_count(total_size);
+  return max_chunks * (sizeof(ReplaySlotChunk) + sizeof(u32)) +
+         de100_lz_compress_bound(REPLAY_SLOT_CHUNK_SIZE);
+}
+
+de100_file_scoped_fn inline ReplaySlotScratch
+slot_scratch(const ReplayBuffer *buffer) {
+  ReplaySlotScratch scratch = {0};
+  scratch.max_chunks = slot_chunk_count(buffer->mapped_size);
+  scratch.index = (ReplaySlotChunk *)buffer->compress_scratch.base;
+  scratch.lookup = (u32 *)(scratch.index + scratch.max_chunks);
+  scratch.chunk = (u8 *)(scratch.lookup + scratch.max_chunks);
+  scratch.chunk_capacity = de100_lz_compress_bound(REPLAY_SLOT_CHUNK_SIZE);
+  return scratch;
+}
+
+de100_file_scoped_fn inline bool slot_is_zero(const u8 *data, u64 size) {
+  const u64 *words = (const u64 *)data;
+  u64 word_count = size / sizeof(u64);
+  for (u64 i = 0; i < word_count; ++i) {
+    if (words[i]) {
+      return false;
+    }
+  }
+  for (u64 i = word_count * sizeof(u64); i < size; ++i) {
+    if (data[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+de100_file_scoped_fn bool slot_replace_file(const char *from, const char *to) {
+#if defined(_WIN32)
+  return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from, to) == 0;
+#endif
+}
+
+/**
+ * Write game_memory[0, total_size) as a compressed slot file.
+ *
+ * @param out_file_size  Bytes written (may be NULL)
+ */
+de100_file_scoped_fn ReplayBufferErrorCode slot_write_compressed(
+    const ReplayBuffer *buffer, const void *game_memory, u64 total_size,
+    u64 *out_file_size) {
+  ReplaySlotScratch scratch = slot_scratch(buffer);
+  if (slot_chunk_count(total_size) > scratch.max_chunks) {
+    return REPLAY_BUFFER_ERROR_SAVE_FAILED;
+  }
+
+  const char *tmp_filename = buffer->tmp_filename;
+  De100FileOpenResult open_result =
+      de100_file_open(tmp_filename, DE100_FILE_WRITE | DE100_FILE_CREATE |
+                                        DE100_FILE_TRUNCATE);
+  if (!open_result.success) {
+    return REPLAY_BUFFER_ERROR_FILE_CREATE_FAILED;
+  }
+  i32 fd = open_result.fd;
+
+  ReplaySlotFileHeader header = {
+      .magic = REPLAY_SLOT_MAGIC,
+      .version = REPLAY_SLOT_VERSION,
+      .saved_size = total_size,
+      .chunk_size = REPLAY_SLOT_CHUNK_SIZE,
+  };
+  bool ok = de100_file_write_all(fd, &header, sizeof(header)).success;
+  u64 file_offset = sizeof(header);
+
+  const u8 *memory = (const u8 *)game_memory;
+  u64 chunk_count = slot_chunk_count(total_size);
+
+  for (u64 c = 0; ok && c < chunk_count; ++c) {
+    u64 start = c * REPLAY_SLOT_CHUNK_SIZE;
+    u64 bytes = total_size - start < REPLAY_SLOT_CHUNK_SIZE
+                    ? total_size - start
+                    : REPLAY_SLOT_CHUNK_SIZE;
+    if (slot_is_zero(memory + start, bytes)) {
+      continue;
+    }
+
+    size_t compressed = de100_lz_compress(memory + start, (size_t)bytes,
+                                          scratch.chunk,
+                                          (size_t)scratch.chunk_capacity);
+    bool raw = compressed == 0 || compressed >= bytes;
+    u64 stored = raw ? bytes : compressed;
+
+    ok = de100_file_write_all(fd, raw ? memory + start : scratch.chunk,
+                              (size_t)stored)
+             .success;
+
+    scratch.index[header.stored_count++] = (ReplaySlotChunk){
+        .chunk_index = (u32)c,
+        .stored_size = (u32)stored,
+        .file_offset = file_offset,
+    };
+    file_offset += stored;
+  }
+
+  header.index_offset = file_offset;
+  u64 index_bytes = (u64)header.stored_count * sizeof(ReplaySlotChunk);
+  ok = ok &&
+       de100_file_write_all(fd, scratch.index, (size_t)index_bytes).success &&
+       de100_file_seek(fd, 0, DE100_SEEK_SET).success &&
+       de100_file_write_all(fd, &header, sizeof(header)).success;
+
+  de100_file_close(fd);
+
+  if (!ok || !slot_replace_file(tmp_filename, buffer->filename)) {
+    de100_file_delete(tmp_filename);
+    return REPLAY_BUFFER_ERROR_SAVE_FAILED;
+  }
+
+  if (out_file_size) {
+    *out_file_size = file_offset + index_bytes;
+  }
+  return REPLAY_BUFFER_SUCCESS;
+}
+
+/**
+ * A compressed slot a previous run left behind, if its header says it fits
+ * this configuration (same format version and chunk size, no bigger than
+ * `total_size`).
+ *
+ * @return false when there's no such file (missing, mapped, other build)
+ */
+de100_file_scoped_fn bool slot_probe_compressed(const ReplayBuffer *buffer,
+                                                u64 total_size,
+                                                u64 *out_saved_size,
+                                                u64 *out_file_size) {
+  De100FileSizeResult size_result = de100_file_get_size(buffer->filename);
+  if (!size_result.success ||
+      (u64)size_result.value < sizeof(ReplaySlotFileHeader)) {
+    return false;
+  }
+
+  De100FileOpenResult open_result =
+      de100_file_open(buffer->filename, DE100_FILE_READ);
+  if (!open_result.success) {
+    return false;
+  }
+  ReplaySlotFileHeader header;
+  u64 file_size = (u64)size_result.value;
+  bool ok = de100_file_read_all(open_result.fd, &header, sizeof(header))
+                .success &&
+            header.magic == REPLAY_SLOT_MAGIC &&
+            header.version == REPLAY_SLOT_VERSION &&
+            header.chunk_size == REPLAY_SLOT_CHUNK_SIZE &&
+            header.saved_size <= total_size &&
+            header.stored_count <= slot_chunk_count(header.saved_size) &&
+            header.index_offset +
+                    (u64)header.stored_count * sizeof(ReplaySlotChunk) <=
+                file_size;
+  de100_file_close(open_result.fd);
+
+  if (ok) {
+    *out_saved_size = header.saved_size;
+    *out_file_size = file_size;
+  }
+  return ok;
+}
+
+de100_file_scoped_fn bool slot_read_chunk(i32 fd,
+                                          const ReplaySlotScratch *scratch,
+                                          const ReplaySlotChunk *entry,
+                                          u8 *dst, u64 bytes) {
+  if (!de100_file_seek(fd, (i64)entry->file_offset, DE100_SEEK_SET).success) {
+    return false;
+  }
+  // Always through scratch: with write-fault dirty tracking, read(2)
+  // straight into protected game memory fails with EFAULT.
+  if (entry->stored_size > bytes ||
+      !de100_file_read_all(fd, scratch->chunk, entry->stored_size).success) {
+    return false;
+  }
+  if (entry->stored_size == bytes) {
+    de100_mem_copy(dst, scratch->chunk, (size_t)bytes);
+    return true;
+  }
+  return de100_lz_decompress(scratch->chunk, entry->stored_size, dst,
+                             (size_t)bytes) == bytes;
+}
+
+/**
+ * Load a compressed slot into game memory.
+ *
+ * With a tracker channel only the chunks overlapping its dirty runs are
+ * decompressed (the rest already match the slot). Memory past the snapshot
+ * is zeroed like the mapped restore does.
+ *
+ * @param out_restored  Bytes of chunks actually written back (may be NULL)
+ */
+de100_file_scoped_fn ReplayBufferErrorCode slot_read_compressed(
+    const ReplayBuffer *buffer, void *game_memory, u64 total_size,
+    const DirtyPageTracker *tracker, u64 *out_restored) {
+  ReplaySlotScratch scratch = slot_scratch(buffer);
+
+  De100FileOpenResult open_result =
+      de100_file_open(buffer->filename, DE100_FILE_READ);
+  if (!open_result.success) {
+    return REPLAY_BUFFER_ERROR_RESTORE_FAILED;
+  }
+  i32 fd = open_result.fd;
+
+  ReplaySlotFileHeader header;
+  bool ok = de100_file_read_all(fd, &header, sizeof(header)).success &&
+            header.magic == REPLAY_SLOT_MAGIC &&
+            header.version == REPLAY_SLOT_VERSION &&
+            header.chunk_size == REPLAY_SLOT_CHUNK_SIZE &&
+            slot_chunk_count(header.saved_size) <= scratch.max_chunks &&
+            header.stored_count <= slot_chunk_count(header.saved_size);
+
+  ok = ok &&
+       de100_file_seek(fd, (i64)header.index_offset, DE100_SEEK_SET).success &&
+       de100_file_read_all(fd, scratch.index,
+                           header.stored_count * sizeof(ReplaySlotChunk))
+           .success;
+  if (!ok) {
+    de100_file_close(fd);
+    return REPLAY_BUFFER_ERROR_RESTORE_FAILED;
+  }
+
+  u64 copy_size = header.saved_size < total_size ? header.saved_size
+                                                 : total_size;
+  u64 chunk_count = slot_chunk_count(copy_size);
+  for (u64 c = 0; c < chunk_count; ++c) {
+    scratch.lookup[c] = REPLAY_SLOT_NO_CHUNK;
+  }
+  for (u32 i = 0; i < header.stored_count; ++i) {
+    if (scratch.index[i].chunk_index < chunk_count) {
+      scratch.lookup[scratch.index[i].chunk_index] = i;
+    }
+  }
+
+  u8 *memory = (u8 *)game_memory;
+  u64 restored = 0;
+  bool lazy = replay_buffer_can_increment(buffer, tracker);
+
+  // Walk dirty runs (or one run covering everything) chunk by chunk
+  u64 cursor = 0, run_offset = 0, run_size = copy_size;
+  u64 next_chunk = 0;
+  bool have_run = lazy ? dirty_pages_next_run(tracker, buffer->dirty_channel,
+                                              copy_size, &cursor, &run_offset,
+                                              &run_size)
+                       : copy_size > 0;
+
+  while (ok && have_run) {
+    u64 first = run_offset / REPLAY_SLOT_CHUNK_SIZE;
+    u64 last = (run_offset + run_size - 1) / REPLAY_SLOT_CHUNK_SIZE;
+    if (first < next_chunk) {
+      first = next_chunk;
+    }
+
+    for (u64 c = first; ok && c <= last; ++c) {
+      u64 start = c * REPLAY_SLOT_CHUNK_SIZE;
+      u64 bytes = copy_size - start < REPLAY_SLOT_CHUNK_SIZE
+                      ? copy_size - start
+                      : REPLAY_SLOT_CHUNK_SIZE;
+      u32 entry = scratch.lookup[c];
+      if (entry == REPLAY_SLOT_NO_CHUNK) {
+        de100_mem_set(memory + start, 0, (size_t)bytes);
+      } else {
+        ok = slot_read_chunk(fd, &scratch, &scratch.index[entry],
+                             memory + start, bytes);
+      }
+      restored += bytes;
+    }
+    next_chunk = last + 1;
+
+    have_run = lazy && dirty_pages_next_run(tracker, buffer->dirty_channel,
+                                            copy_size, &cursor, &run_offset,
+                                            &run_size);
+  }
+
+  de100_file_close(fd);
+  if (!ok) {
+    return REPLAY_BUFFER_ERROR_RESTORE_FAILED;
+  }
+
+  if (copy_size < total_size) {
+    de100_mem_set(memory + copy_size, 0, (size_t)(total_size - copy_size));
+  }
+
+  if (out_restored) {
+    *out_restored = restored;
+  }
+  return REPLAY_BUFFER_SUCCESS;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // INITIALIZATION
 // ═══════════════════════════════════════════════════════════════════════════
 
 ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
                                            void *game_memory, u64 total_size,
+                                           ReplayBufferFormat format,
                                            ReplayBuffer *out_buffers) {
   ReplayBufferInitResult result = {0};
 
@@ -218,8 +570,14 @@ ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
   }
 
 #if DE100_INTERNAL
-  printf("[REPLAY BUFFER] Initializing %d buffers (%.2f MB each)\n",
-         MAX_REPLAY_BUFFERS, (double)total_size / (1024.0 * 1024.0));
+  if (format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+    printf("[REPLAY BUFFER] Initializing %d compressed buffers (up to %.2f MB "
+           "each)\n",
+           MAX_REPLAY_BUFFERS, (double)total_size / (1024.0 * 1024.0));
+  } else {
+    printf("[REPLAY BUFFER] Initializing %d buffers (%.2f MB each)\n",
+           MAX_REPLAY_BUFFERS, (double)total_size / (1024.0 * 1024.0));
+  }
 #endif
 
   // ─────────────────────────────────────────────────────────────────────
@@ -231,16 +589,77 @@ ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
     ReplayBuffer *buffer = &out_buffers[slot];
 
     // Initialize to invalid state
+    buffer->format = format;
     buffer->file_fd = -1;
     buffer->memory_block = NULL;
     buffer->mapped_size = 0;
+    buffer->saved_size = 0;
+    buffer->compress_scratch = (De100MemoryBlock){0};
+    buffer->stored_size = 0;
+    buffer->dirty_channel = DIRTY_PAGES_NO_CHANNEL;
+    buffer->pending_save_pid = 0;
+    buffer->pending_save_tracker = NULL;
     buffer->is_valid = false;
     buffer->last_error = REPLAY_BUFFER_SUCCESS;
     buffer->filename[0] = '\0';
+    buffer->tmp_filename[0] = '\0';
 
     // Generate filename
     get_state_filename(exe_directory, slot, buffer->filename,
                        sizeof(buffer->filename));
+    snprintf(buffer->tmp_filename, sizeof(buffer->tmp_filename), "%s.tmp",
+             buffer->filename);
+
+    // ─────────────────────────────────────────────────────────────────
+    // Compressed slots: scratch for the chunk index + an empty snapshot
+    // ─────────────────────────────────────────────────────────────────
+
+    if (format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+      buffer->mapped_size = (size_t)total_size;
+      buffer->compress_scratch = de100_memory_alloc(
+          NULL, (size_t)slot_scratch_size(total_size), De100_MEMORY_FLAG_RW);
+      if (!de100_memory_is_valid(buffer->compress_scratch)) {
+        buffer->mapped_size = 0;
+        buffer->last_error = REPLAY_BUFFER_ERROR_MMAP_FAILED;
+        continue;
+      }
+
+      // Keep a slot a previous run recorded in this format; anything else
+      // (mapped image, other version) is replaced with "everything zero"
+      // like a fresh mapped file.
+      u64 kept_saved_size = 0;
+      bool had_file = de100_file_exists(buffer->filename).exists;
+      ReplayBufferErrorCode write_error = REPLAY_BUFFER_SUCCESS;
+      if (had_file && slot_probe_compressed(buffer, total_size,
+                                            &kept_saved_size,
+                                            &buffer->stored_size)) {
+        buffer->saved_size = (size_t)kept_saved_size;
+      } else {
+        if (had_file) {
+          fprintf(stderr,
+                  "[REPLAY BUFFER] ⚠️  Slot %d: '%s' isn't a compressed slot "
+                  "for this build, starting it empty\n",
+                  slot, buffer->filename);
+        }
+        write_error = slot_write_compressed(buffer, game_memory, 0,
+                                            &buffer->stored_size);
+      }
+      if (write_error != REPLAY_BUFFER_SUCCESS) {
+        de100_memory_free(&buffer->compress_scratch);
+        buffer->mapped_size = 0;
+        buffer->last_error = write_error;
+        continue;
+      }
+
+      buffer->is_valid = true;
+      buffer->last_error = REPLAY_BUFFER_SUCCESS;
+      result.buffers_initialized++;
+#if DE100_INTERNAL
+      printf("[REPLAY BUFFER] ✅ Slot %d ready: %s (compressed)\n", slot,
+             buffer->filename);
+#endif
+      continue;
+    }
 
     // ─────────────────────────────────────────────────────────────────
     // Step 1: Create/open file using de100_file_open
@@ -294,6 +713,8 @@ ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
     // ─────────────────────────────────────────────────────────────────
 
     buffer->mapped_size = (size_t)total_size;
+    // Whatever a previous run left in the file counts as a full snapshot
+    buffer->saved_size = (size_t)total_size;
     buffer->is_valid = true;
     buffer->last_error = REPLAY_BUFFER_SUCCESS;
     result.buffers_initialized++;
@@ -343,6 +764,9 @@ void replay_buffers_shutdown(ReplayBuffer *buffers, u64 total_size) {
        ++slot) {
     ReplayBuffer *buffer = &buffers[slot];
 
+    // Let an in-flight async save finish (and reap it)
+    replay_buffer_wait_save(buffer);
+
     // Unmap memory
     if (buffer->memory_block) {
       de100_munmap_file(buffer->memory_block, total_size);
@@ -355,7 +779,12 @@ void replay_buffers_shutdown(ReplayBuffer *buffers, u64 total_size) {
       buffer->file_fd = -1;
     }
 
+    if (de100_memory_is_valid(buffer->compress_scratch)) {
+      de100_memory_free(&buffer->compress_scratch);
+    }
+
     buffer->mapped_size = 0;
+    buffer->saved_size = 0;
     buffer->is_valid = false;
   }
 
@@ -396,7 +825,7 @@ ReplayBufferResult replay_buffer_save_state(ReplayBuffer *buffer,
     return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
   }
 
-  if (!buffer->is_valid || !buffer->memory_block) {
+  if (!replay_buffer_is_valid(buffer)) {
     buffer->last_error = REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID;
     return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
   }
@@ -406,14 +835,44 @@ ReplayBufferResult replay_buffer_save_state(ReplayBuffer *buffer,
     return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
   }
 
+  if (buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+    if (total_size > buffer->mapped_size) {
+      buffer->last_error = REPLAY_BUFFER_ERROR_SAVE_FAILED;
+      return make_result(false, REPLAY_BUFFER_ERROR_SAVE_FAILED);
+    }
+
+    ReplayBufferErrorCode error = slot_write_compressed(
+        buffer, game_memory, total_size, &buffer->stored_size);
+    buffer->last_error = error;
+    if (error != REPLAY_BUFFER_SUCCESS) {
+      buffer->saved_size = 0;
+      return make_result(false, error);
+    }
+    buffer->saved_size = (size_t)total_size;
+
+#if DE100_INTERNAL
+    printf("[REPLAY BUFFER] 📸 Saved state (%.2f MB → %.2f MB on disk)\n",
+           (double)total_size / (1024.0 * 1024.0),
+           (double)buffer->stored_size / (1024.0 * 1024.0));
+#endif
+    return make_result(true, REPLAY_BUFFER_SUCCESS);
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // THE MAGIC: Just a memcpy!
   // ─────────────────────────────────────────────────────────────────────
   // This copies from game memory to the memory-mapped region.
-  // ~50-100ms for 1GB vs 2-5 seconds with file I/O.
+  // ~50-100ms for 1GB vs 2-5 seconds with file I/O, split across the
+  // parallel copy pool when there is one.
   // ─────────────────────────────────────────────────────────────────────
 
-  de100_mem_copy(buffer->memory_block, game_memory, (size_t)total_size);
+  if (total_size > buffer->mapped_size) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_SAVE_FAILED;
+    return make_result(false, REPLAY_BUFFER_ERROR_SAVE_FAILED);
+  }
+
+  parallel_copy(buffer->memory_block, game_memory, total_size);
+  buffer->saved_size = (size_t)total_size;
 
 #if DE100_INTERNAL
   printf("[REPLAY BUFFER] 📸 Saved state (%.2f MB)\n",
@@ -435,7 +894,7 @@ ReplayBufferResult replay_buffer_restore_state(const ReplayBuffer *buffer,
     return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
   }
 
-  if (!buffer->is_valid || !buffer->memory_block) {
+  if (!replay_buffer_is_valid(buffer)) {
     return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
   }
 
@@ -443,11 +902,35 @@ ReplayBufferResult replay_buffer_restore_state(const ReplayBuffer *buffer,
     return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
   }
 
+  if (buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+    ReplayBufferErrorCode error =
+        slot_read_compressed(buffer, game_memory, total_size, NULL, NULL);
+#if DE100_INTERNAL
+    if (error == REPLAY_BUFFER_SUCCESS) {
+      printf("[REPLAY BUFFER] 🔄 Restored state (%.2f MB, compressed)\n",
+             (double)total_size / (1024.0 * 1024.0));
+    }
+#endif
+    return make_result(error == REPLAY_BUFFER_SUCCESS, error);
+  }
+
   // ─────────────────────────────────────────────────────────────────────
   // THE MAGIC: Just a memcpy!
   // ─────────────────────────────────────────────────────────────────────
+  // Only the prefix that was committed at save time holds data. Memory
+  // committed since then gets zeroed so playback sees the same fresh pages
+  // the recording did.
+  // ─────────────────────────────────────────────────────────────────────
 
-  de100_mem_copy(game_memory, buffer->memory_block, (size_t)total_size);
+  size_t copy_size = buffer->saved_size < (size_t)total_size
+                         ? buffer->saved_size
+                         : (size_t)total_size;
+
+  parallel_copy(game_memory, buffer->memory_block, copy_size);
+  if (copy_size < (size_t)total_size) {
+    de100_mem_set((u8 *)game_memory + copy_size, 0,
+                  (size_t)total_size - copy_size);
+  }
 
 #if DE100_INTERNAL
   printf("[REPLAY BUFFER] 🔄 Restored state (%.2f MB)\n",
@@ -457,11 +940,489 @@ ReplayBufferResult replay_buffer_restore_state(const ReplayBuffer *buffer,
   return make_result(true, REPLAY_BUFFER_SUCCESS);
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// LOAD FROM A STANDALONE SLOT FILE
+// ═══════════════════════════════════════════════════════════════════════════
+
+ReplayBufferResult replay_buffer_load_file(const char *filename,
+                                           void *game_memory,
+                                           u64 total_size) {
+  if (!filename) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
+  }
+
+  if (!game_memory || total_size == 0) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+  }
+
+  De100FileSizeResult size_result = de100_file_get_size(filename);
+  if (!size_result.success) {
+    return make_result(false, REPLAY_BUFFER_ERROR_RESTORE_FAILED);
+  }
+  u64 file_size = (u64)size_result.value;
+
+  De100FileOpenResult open_result = de100_file_open(filename, DE100_FILE_READ);
+  if (!open_result.success) {
+    return make_result(false, REPLAY_BUFFER_ERROR_RESTORE_FAILED);
+  }
+  i32 fd = open_result.fd;
+
+  u32 magic = 0;
+  bool is_compressed =
+      file_size >= sizeof(ReplaySlotFileHeader) &&
+      de100_file_read_all(fd, &magic, sizeof(magic)).success &&
+      magic == REPLAY_SLOT_MAGIC;
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Compressed: a throwaway buffer so slot_read_compressed does the work
+  // ─────────────────────────────────────────────────────────────────────
+
+  if (is_compressed) {
+    de100_file_close(fd);
+
+    ReplayBuffer buffer = {0};
+    buffer.format = REPLAY_BUFFER_FORMAT_COMPRESSED;
+    buffer.file_fd = -1;
+    buffer.mapped_size = (size_t)total_size;
+    buffer.dirty_channel = DIRTY_PAGES_NO_CHANNEL;
+    snprintf(buffer.filename, sizeof(buffer.filename), "%s", filename);
+    buffer.compress_scratch = de100_memory_alloc(
+        NULL, (size_t)slot_scratch_size(total_size), De100_MEMORY_FLAG_RW);
+    if (!de100_memory_is_valid(buffer.compress_scratch)) {
+      return make_result(false, REPLAY_BUFFER_ERROR_RESTORE_FAILED);
+    }
+
+    ReplayBufferErrorCode error =
+        slot_read_compressed(&buffer, game_memory, total_size, NULL, NULL);
+    de100_memory_free(&buffer.compress_scratch);
+    return make_result(error == REPLAY_BUFFER_SUCCESS, error);
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Mapped: the file is a raw memory image. Staged through a chunk buffer
+  // for the same EFAULT reason as slot_read_chunk.
+  // ─────────────────────────────────────────────────────────────────────
+
+  De100MemoryBlock staging =
+      de100_memory_alloc(NULL, REPLAY_SLOT_CHUNK_SIZE, De100_MEMORY_FLAG_RW);
+  if (!de100_memory_is_valid(staging)) {
+    de100_file_close(fd);
+    return make_result(false, REPLAY_BUFFER_ERROR_RESTORE_FAILED);
+  }
+
+  u8 *memory = (u8 *)game_memory;
+  u64 copy_size = file_size < total_size ? file_size : total_size;
+  bool ok = de100_file_seek(fd, 0, DE100_SEEK_SET).success;
+  for (u64 offset = 0; ok && offset < copy_size;
+       offset += REPLAY_SLOT_CHUNK_SIZE) {
+    u64 bytes = copy_size - offset < REPLAY_SLOT_CHUNK_SIZE
+                    ? copy_size - offset
+                    : REPLAY_SLOT_CHUNK_SIZE;
+    ok = de100_file_read_all(fd, staging.base, (size_t)bytes).success;
+    if (ok) {
+      de100_mem_copy(memory + offset, staging.base, (size_t)bytes);
+    }
+  }
+
+  de100_memory_free(&staging);
+  de100_file_close(fd);
+  if (!ok) {
+    return make_result(false, REPLAY_BUFFER_ERROR_RESTORE_FAILED);
+  }
+
+  if (copy_size < total_size) {
+    de100_mem_set(memory + copy_size, 0, (size_t)(total_size - copy_size));
+  }
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INCREMENTAL SAVE / RESTORE (Dirty pages only)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// The buffer's channel answers "which pages may differ between game memory
+// and this slot?". Both directions copy exactly those, then mark the slot
+// in sync. Restore writes game memory itself, so it harvests again
+// afterwards: the pages it just wrote now differ from the OTHER slots.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Copy the dirty runs of `channel` below `limit`; returns bytes copied.
+ * Single-threaded: used by the fork()ed writer, where the pool's threads
+ * don't exist.
+ */
+de100_file_scoped_fn u64 copy_dirty_runs(void *dst, const void *src, u64 limit,
+                                         const DirtyPageTracker *tracker,
+                                         i32 channel) {
+  u64 cursor = 0, offset = 0, size = 0, copied = 0;
+  while (dirty_pages_next_run(tracker, channel, limit, &cursor, &offset,
+                              &size)) {
+    de100_mem_copy((u8 *)dst + offset, (const u8 *)src + offset, (size_t)size);
+    copied += size;
+  }
+  return copied;
+}
+
+ReplayBufferResult replay_buffer_save_state_incremental(
+    ReplayBuffer *buffer, const void *game_memory, u64 total_size,
+    DirtyPageTracker *tracker) {
+  // Compressed slots are rewritten whole (zero chunks cost nothing), but
+  // still harvest so the slot's channel starts a fresh epoch.
+  if (!replay_buffer_can_increment(buffer, tracker) ||
+      !dirty_pages_harvest(tracker, total_size) ||
+      buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+    ReplayBufferResult result =
+        replay_buffer_save_state(buffer, game_memory, total_size);
+    if (result.success && replay_buffer_can_increment(buffer, tracker)) {
+      dirty_pages_mark_synced(tracker, buffer->dirty_channel, total_size);
+    }
+    return result;
+  }
+
+  if (!buffer->is_valid || !buffer->memory_block) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID;
+    return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
+  }
+
+  if (!game_memory || total_size == 0) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_NO_GAME_MEMORY;
+    return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+  }
+
+  if (total_size > buffer->mapped_size) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_SAVE_FAILED;
+    return make_result(false, REPLAY_BUFFER_ERROR_SAVE_FAILED);
+  }
+
+  u64 copied =
+      parallel_copy_dirty_runs(buffer->memory_block, game_memory, total_size,
+                               tracker, buffer->dirty_channel);
+  (void)copied;
+
+  buffer->saved_size = (size_t)total_size;
+  dirty_pages_mark_synced(tracker, buffer->dirty_channel, total_size);
+
+#if DE100_INTERNAL
+  printf("[REPLAY BUFFER] 📸 Saved state (%.2f MB dirty of %.2f MB, %s)\n",
+         (double)copied / (1024.0 * 1024.0),
+         (double)total_size / (1024.0 * 1024.0),
+         dirty_pages_mode_str(tracker->mode));
+#endif
+
+  buffer->last_error = REPLAY_BUFFER_SUCCESS;
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+/**
+ * Compressed restore that only decompresses the chunks overlapping this
+ * slot's dirty runs; everything else in game memory already matches it.
+ */
+de100_file_scoped_fn ReplayBufferResult replay_buffer_restore_compressed_lazy(
+    const ReplayBuffer *buffer, void *game_memory, u64 total_size,
+    DirtyPageTracker *tracker) {
+  if (!replay_buffer_is_valid(buffer)) {
+    return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
+  }
+
+  if (!game_memory || total_size == 0) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+  }
+
+  bool can_increment = replay_buffer_can_increment(buffer, tracker);
+  bool lazy = can_increment && dirty_pages_harvest(tracker, total_size);
+
+  u64 restored = 0;
+  ReplayBufferErrorCode error = slot_read_compressed(
+      buffer, game_memory, total_size, lazy ? tracker : NULL, &restored);
+  if (error != REPLAY_BUFFER_SUCCESS) {
+    return make_result(false, error);
+  }
+
+  if (can_increment) {
+    u64 copy_size =
+        buffer->saved_size < total_size ? buffer->saved_size : total_size;
+    dirty_pages_harvest(tracker, total_size);
+    dirty_pages_mark_synced(tracker, buffer->dirty_channel, copy_size);
+  }
+
+#if DE100_INTERNAL
+  printf("[REPLAY BUFFER] 🔄 Restored state (%.2f MB decompressed of %.2f "
+         "MB, %s)\n",
+         (double)restored / (1024.0 * 1024.0),
+         (double)total_size / (1024.0 * 1024.0),
+         lazy ? dirty_pages_mode_str(tracker->mode) : "full");
+#endif
+
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+ReplayBufferResult replay_buffer_restore_state_incremental(
+    const ReplayBuffer *buffer, void *game_memory, u64 total_size,
+    DirtyPageTracker *tracker) {
+  if (buffer && buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+    return replay_buffer_restore_compressed_lazy(buffer, game_memory,
+                                                 total_size, tracker);
+  }
+
+  if (!replay_buffer_can_increment(buffer, tracker) ||
+      !dirty_pages_harvest(tracker, total_size)) {
+    ReplayBufferResult result =
+        replay_buffer_restore_state(buffer, game_memory, total_size);
+    if (result.success && replay_buffer_can_increment(buffer, tracker)) {
+      dirty_pages_harvest(tracker, total_size);
+      dirty_pages_mark_synced(tracker, buffer->dirty_channel,
+                              buffer->saved_size);
+    }
+    return result;
+  }
+
+  if (!buffer->is_valid || !buffer->memory_block) {
+    return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
+  }
+
+  if (!game_memory || total_size == 0) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+  }
+
+  u64 copy_size =
+      buffer->saved_size < total_size ? buffer->saved_size : total_size;
+
+  u64 copied =
+      parallel_copy_dirty_runs(game_memory, buffer->memory_block, copy_size,
+                               tracker, buffer->dirty_channel);
+  (void)copied;
+
+  // Same rule as the full restore: memory committed after the save reads as
+  // fresh zeroed pages again.
+  if (copy_size < total_size) {
+    de100_mem_set((u8 *)game_memory + copy_size, 0,
+                  (size_t)(total_size - copy_size));
+  }
+
+  // What we just wrote is in sync with this slot but not with the others
+  dirty_pages_harvest(tracker, total_size);
+  dirty_pages_mark_synced(tracker, buffer->dirty_channel, copy_size);
+
+#if DE100_INTERNAL
+  printf("[REPLAY BUFFER] 🔄 Restored state (%.2f MB dirty of %.2f MB, %s)\n",
+         (double)copied / (1024.0 * 1024.0),
+         (double)total_size / (1024.0 * 1024.0),
+         dirty_pages_mode_str(tracker->mode));
+#endif
+
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ASYNC SAVE (fork() copy-on-write snapshot)
+// ═══════════════════════════════════════════════════════════════════════════
+//
+//   game thread                      child (COW view of game memory)
+//   ───────────                      ───────────────────────────────
+//   harvest dirty pages
+//   fork() ─────────────────────────> copy dirty runs → MAP_SHARED slot
+//   mark slot in sync, keep running   _exit(0)
+//   ... frames ...
+//   poll: waitpid(WNOHANG) <───────── exit status
+//
+// The slot mapping is MAP_SHARED, so the child's writes land in the same
+// page cache the parent maps. The parent records the slot as in sync at
+// fork time (that IS the snapshot instant) and undoes that if the child
+// fails.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+ReplayBufferResult replay_buffer_save_state_async(ReplayBuffer *buffer,
+                                                  const void *game_memory,
+                                                  u64 total_size,
+                                                  DirtyPageTracker *tracker) {
+#if defined(_WIN32)
+  return replay_buffer_save_state_incremental(buffer, game_memory, total_size,
+                                              tracker);
+#else
+  if (!buffer) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
+  }
+
+  // One writer per slot
+  replay_buffer_wait_save(buffer);
+
+  if (!replay_buffer_is_valid(buffer)) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID;
+    return make_result(false, REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID);
+  }
+
+  if (!game_memory || total_size == 0) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_NO_GAME_MEMORY;
+    return make_result(false, REPLAY_BUFFER_ERROR_NO_GAME_MEMORY);
+  }
+
+  if (total_size > buffer->mapped_size) {
+    buffer->last_error = REPLAY_BUFFER_ERROR_SAVE_FAILED;
+    return make_result(false, REPLAY_BUFFER_ERROR_SAVE_FAILED);
+  }
+
+  bool compressed = buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED;
+  bool incremental = replay_buffer_can_increment(buffer, tracker) &&
+                     dirty_pages_harvest(tracker, total_size) && !compressed;
+  u64 copy_bytes =
+      incremental
+          ? dirty_pages_dirty_bytes(tracker, buffer->dirty_channel, total_size)
+          : total_size;
+
+  f64 start = de100_get_wall_clock();
+  pid_t pid = fork();
+
+  if (pid < 0) {
+#if DE100_INTERNAL
+    fprintf(stderr, "[REPLAY BUFFER] fork() failed (%s), saving inline\n",
+            strerror(errno));
+#endif
+    return replay_buffer_save_state_incremental(buffer, game_memory,
+                                                total_size, tracker);
+  }
+
+  if (pid == 0) {
+    // ─────────────────────────────────────────────────────────────────
+    // CHILD: only memcpy/file I/O + _exit (no stdio, no locks, no atexit)
+    // ─────────────────────────────────────────────────────────────────
+    if (compressed) {
+      _exit(slot_write_compressed(buffer, game_memory, total_size, NULL) ==
+                    REPLAY_BUFFER_SUCCESS
+                ? 0
+                : 1);
+    }
+    if (incremental) {
+      copy_dirty_runs(buffer->memory_block, game_memory, total_size, tracker,
+                      buffer->dirty_channel);
+    } else {
+      de100_mem_copy(buffer->memory_block, game_memory, (size_t)total_size);
+    }
+    _exit(0);
+  }
+
+  // ─────────────────────────────────────────────────────────────────────
+  // PARENT
+  // ─────────────────────────────────────────────────────────────────────
+  buffer->saved_size = (size_t)total_size;
+  if (replay_buffer_can_increment(buffer, tracker)) {
+    dirty_pages_mark_synced(tracker, buffer->dirty_channel, total_size);
+  }
+
+  buffer->pending_save_pid = (i32)pid;
+  buffer->pending_save_start = start;
+  buffer->pending_save_size = copy_bytes;
+  buffer->pending_save_tracker = tracker;
+
+#if DE100_INTERNAL
+  printf("[REPLAY BUFFER] 📸 Async save started (%.2f MB, fork %.2f ms, %s)\n",
+         (double)copy_bytes / (1024.0 * 1024.0),
+         (de100_get_wall_clock() - start) * 1000.0,
+         compressed    ? "compressed"
+         : incremental ? dirty_pages_mode_str(tracker->mode)
+                       : "full copy");
+#endif
+
+  buffer->last_error = REPLAY_BUFFER_SUCCESS;
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+#endif
+}
+
+#if !defined(_WIN32)
+/** Reap the writer with `waitpid_flags`; false if it's still running. */
+de100_file_scoped_fn bool replay_buffer_reap_save(ReplayBuffer *buffer,
+                                                  int waitpid_flags,
+                                                  ReplayBufferResult *out) {
+  int status = 0;
+  pid_t reaped;
+  do {
+    reaped = waitpid((pid_t)buffer->pending_save_pid, &status, waitpid_flags);
+  } while (reaped < 0 && errno == EINTR);
+
+  if (reaped == 0) {
+    return false;
+  }
+
+  // ECHILD means someone else reaped it (SIGCHLD = SIG_IGN); the child has
+  // exited and there's no status left to check, so trust it.
+  bool ok = (reaped < 0) || (WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  if (ok) {
+    if (buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+      De100FileSizeResult size = de100_file_get_size(buffer->filename);
+      buffer->stored_size = size.success ? (u64)size.value : 0;
+    }
+#if DE100_INTERNAL
+    printf("[REPLAY BUFFER] ✅ Async save finished (%.2f MB in %.2f ms)\n",
+           (double)buffer->pending_save_size / (1024.0 * 1024.0),
+           (de100_get_wall_clock() - buffer->pending_save_start) * 1000.0);
+    if (buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+      printf("[REPLAY BUFFER]    %.2f MB on disk\n",
+             (double)buffer->stored_size / (1024.0 * 1024.0));
+    }
+#endif
+    buffer->last_error = REPLAY_BUFFER_SUCCESS;
+    *out = make_result(true, REPLAY_BUFFER_SUCCESS);
+  } else {
+    fprintf(stderr, "[REPLAY BUFFER] ❌ Async save failed (status %d)\n",
+            status);
+    // The slot is half-written: never trust it again until a full save
+    buffer->saved_size = 0;
+    if (buffer->pending_save_tracker) {
+      dirty_pages_mark_synced(buffer->pending_save_tracker,
+                              buffer->dirty_channel, 0);
+    }
+    buffer->last_error = REPLAY_BUFFER_ERROR_SAVE_FAILED;
+    *out = make_result(false, REPLAY_BUFFER_ERROR_SAVE_FAILED);
+  }
+
+  buffer->pending_save_pid = 0;
+  buffer->pending_save_tracker = NULL;
+  return true;
+}
+#endif
+
+ReplayBufferResult replay_buffer_poll_save(ReplayBuffer *buffer) {
+  if (!buffer) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
+  }
+#if !defined(_WIN32)
+  if (buffer->pending_save_pid > 0) {
+    ReplayBufferResult result;
+    if (!replay_buffer_reap_save(buffer, WNOHANG, &result)) {
+      return make_result(false, REPLAY_BUFFER_ERROR_SAVE_PENDING);
+    }
+    return result;
+  }
+#endif
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
+ReplayBufferResult replay_buffer_wait_save(ReplayBuffer *buffer) {
+  if (!buffer) {
+    return make_result(false, REPLAY_BUFFER_ERROR_NULL_STATE);
+  }
+#if !defined(_WIN32)
+  if (buffer->pending_save_pid > 0) {
+    ReplayBufferResult result;
+    replay_buffer_reap_save(buffer, 0, &result);
+    return result;
+  }
+#endif
+  return make_result(true, REPLAY_BUFFER_SUCCESS);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // VALIDITY CHECK
 // ═══════════════════════════════════════════════════════════════════════════
 
 bool replay_buffer_is_valid(const ReplayBuffer *buffer) {
-  return buffer && buffer->is_valid && buffer->memory_block != NULL &&
-         buffer->file_fd >= 0 && buffer->mapped_size > 0;
+  if (!buffer || !buffer->is_valid || buffer->mapped_size == 0) {
+    return false;
+  }
+  if (buffer->format == REPLAY_BUFFER_FORMAT_COMPRESSED) {
+    return de100_memory_is_valid(buffer->compress_scratch);
+  }
+  return buffer->memory_block != NULL && buffer->file_fd >= 0;
 }
@@ -2,6 +2,7 @@
 #define DE100_REPLAY_BUFFER_H
 
 #include "../../_common/base.h"
+#include "./dirty-pages.h"
 #include "./memory.h"
 #include <stdbool.h>
 
@@ -20,6 +21,30 @@
 #define VALID_REPLAY_BUFFERS_START_INDEX 1
 #define REPLAY_BUFFER_FILENAME_MAX 256
 
+// Compressed slots split game memory into chunks of this size. All-zero
+// chunks aren't stored; the rest are LZ-compressed (or raw when that
+// doesn't help). Matches the write-fault dirty tracking unit.
+#define REPLAY_SLOT_CHUNK_SIZE KILOBYTES(64)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SLOT FORMATS
+// ═══════════════════════════════════════════════════════════════════════════
+//
+// MAPPED      The slot file is ftruncate'd to the full game memory size and
+//             mmap'd MAP_SHARED; save/restore are memcpys. Fastest, but each
+//             slot costs total_size on disk and in the page cache.
+// COMPRESSED  The slot file holds only the non-zero chunks, LZ-compressed,
+//             behind a sparse chunk index. Saves rewrite the file (on the
+//             fork()ed writer when async); restores only decompress the
+//             chunks the dirty tracker says may differ from the slot.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef enum {
+  REPLAY_BUFFER_FORMAT_MAPPED = 0,
+  REPLAY_BUFFER_FORMAT_COMPRESSED,
+} ReplayBufferFormat;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ERROR CODES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -35,6 +60,7 @@ typedef enum {
   REPLAY_BUFFER_ERROR_BUFFER_NOT_VALID,
   REPLAY_BUFFER_ERROR_SAVE_FAILED,
   REPLAY_BUFFER_ERROR_RESTORE_FAILED,
+  REPLAY_BUFFER_ERROR_SAVE_PENDING,
 
   REPLAY_BUFFER_ERROR_COUNT
 } ReplayBufferErrorCode;
@@ -44,10 +70,26 @@ typedef enum {
 // ═══════════════════════════════════════════════════════════════════════════
 
 typedef struct {
-  i32 file_fd;        // File descriptor
+  ReplayBufferFormat format;
+  i32 file_fd;        // File descriptor (MAPPED only)
   void *memory_block; // mmap'd region (or allocated block on Windows)
-  size_t mapped_size; // Size of the mapped region
+  size_t mapped_size; // Game memory bytes the slot can hold
+  size_t saved_size;  // Bytes written by the last save (<= mapped_size)
+  // COMPRESSED: chunk index + one compressed chunk, sized for mapped_size
+  De100MemoryBlock compress_scratch;
+  u64 stored_size; // COMPRESSED: file size after the last synchronous save
+  i32 dirty_channel;  // DirtyPageTracker channel (DIRTY_PAGES_NO_CHANNEL =
+                      // always copy everything)
+
+  // Async save in flight (replay_buffer_save_state_async)
+  i32 pending_save_pid;  // Snapshot writer process, 0 = none
+  f64 pending_save_start; // Wall clock when it was forked
+  u64 pending_save_size;
+  DirtyPageTracker *pending_save_tracker; // To re-dirty the slot on failure
   char filename[REPLAY_BUFFER_FILENAME_MAX]; // Path to backing file
+  // COMPRESSED: "<filename>.tmp", built at init so the fork()ed writer
+  // never formats strings
+  char tmp_filename[REPLAY_BUFFER_FILENAME_MAX + 8];
   bool is_valid;                             // Ready for use?
   ReplayBufferErrorCode last_error;          // Last error for this buffer
 } ReplayBuffer;
@@ -74,18 +116,20 @@ typedef struct {
 /**
  * Initialize all replay buffers.
  *
- * Creates memory-mapped files for fast state snapshots.
+ * Creates memory-mapped (or compressed) files for state snapshots.
  * Must be called AFTER game memory is allocated.
  *
  * @param exe_directory  Directory where replay files will be created
  * @param game_memory    Pointer to the game memory block
  * @param total_size     Total size of game memory (permanent + transient)
+ * @param format         On-disk slot layout (see SLOT FORMATS)
  * @param out_buffers    Array of MAX_REPLAY_BUFFERS to initialize
  * @return               Result with success status and count of initialized
  * buffers
  */
 ReplayBufferInitResult replay_buffers_init(const char *exe_directory,
                                            void *game_memory, u64 total_size,
+                                           ReplayBufferFormat format,
                                            ReplayBuffer *out_buffers);
 
 /**
@@ -116,7 +160,8 @@ ReplayBuffer *replay_buffer_get(ReplayBuffer *buffers, i32 slot_index);
  *
  * @param buffer       Target replay buffer
  * @param game_memory  Source game memory
- * @param total_size   Size to copy
+ * @param total_size   Size to copy (the committed prefix when game memory is
+ *                     committed on demand)
  * @return             Result with success status
  */
 ReplayBufferResult replay_buffer_save_state(ReplayBuffer *buffer,
@@ -131,13 +176,79 @@ ReplayBufferResult replay_buffer_save_state(ReplayBuffer *buffer,
  *
  * @param buffer       Source replay buffer
  * @param game_memory  Target game memory
- * @param total_size   Size to copy
+ * @param total_size   Bytes of game memory currently committed. Anything past
+ *                     the snapshot's saved_size is zeroed, so memory committed
+ *                     after the save reads like freshly committed pages again.
  * @return             Result with success status
  */
 ReplayBufferResult replay_buffer_restore_state(const ReplayBuffer *buffer,
                                                void *game_memory,
                                                u64 total_size);
 
+/**
+ * Restore game memory from a slot file on disk, outside any ReplayBuffer.
+ *
+ * Accepts either format (detected by the compressed header's magic), so a
+ * copied-away loop_edit_N_state.hmi can be replayed later: slots in the exe
+ * directory are recreated on every start. Reads are serial (fork()-safe).
+ *
+ * @param filename     Slot file (mapped image or compressed)
+ * @param game_memory  Target game memory
+ * @param total_size   Bytes of game memory committed; the rest past the
+ *                     snapshot is zeroed like replay_buffer_restore_state
+ */
+ReplayBufferResult replay_buffer_load_file(const char *filename,
+                                           void *game_memory,
+                                           u64 total_size);
+
+/**
+ * Incremental versions of save/restore.
+ *
+ * Only copies the parts of game memory written since this slot and game
+ * memory were last in sync (last save or restore of THIS slot), so the cost
+ * follows what the game touched instead of total_size. Falls back to the
+ * full copy when `tracker` is inactive or the buffer has no channel.
+ *
+ * @param tracker  Dirty page tracker over game_memory (may be NULL)
+ */
+ReplayBufferResult replay_buffer_save_state_incremental(
+    ReplayBuffer *buffer, const void *game_memory, u64 total_size,
+    DirtyPageTracker *tracker);
+
+ReplayBufferResult replay_buffer_restore_state_incremental(
+    const ReplayBuffer *buffer, void *game_memory, u64 total_size,
+    DirtyPageTracker *tracker);
+
+/**
+ * Save without stalling the frame.
+ *
+ * fork()s: the child gets a copy-on-write image of game memory frozen at
+ * this instant, copies it (or just the dirty runs) into the MAP_SHARED slot
+ * (or compresses it into the slot file) and exits. The game thread only
+ * pays for the fork (page-table copy) and the first write to each page
+ * afterwards (COW fault).
+ *
+ * The slot must not be read until replay_buffer_poll_save() stops returning
+ * REPLAY_BUFFER_ERROR_SAVE_PENDING (or replay_buffer_wait_save() returns).
+ * Falls back to the synchronous incremental save where fork() isn't
+ * available or fails.
+ */
+ReplayBufferResult replay_buffer_save_state_async(ReplayBuffer *buffer,
+                                                  const void *game_memory,
+                                                  u64 total_size,
+                                                  DirtyPageTracker *tracker);
+
+/**
+ * Non-blocking check on an async save.
+ *
+ * @return  error_code SAVE_PENDING while it's still running, SAVE_FAILED if
+ *          the writer died, success when done (or nothing was in flight).
+ */
+ReplayBufferResult replay_buffer_poll_save(ReplayBuffer *buffer);
+
+/** Block until any async save on `buffer` has finished. */
+ReplayBufferResult replay_buffer_wait_save(ReplayBuffer *buffer);
+
 /**
  * Check if a replay buffer is valid and ready for use.
  *
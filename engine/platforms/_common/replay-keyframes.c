@@ -0,0 +1,455 @@
+#include "./replay-keyframes.h"
+#include "../../_common/compress.h"
+#include "../../_common/file.h"
+#include "../../_common/hash.h"
+#include "../../_common/profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u64 chunk_bytes(u64 chunk_index, u64 limit) {
+  u64 start = chunk_index * REPLAY_KEYFRAMES_CHUNK_SIZE;
+  if (start >= limit) {
+    return 0;
+  }
+  return limit - start < REPLAY_KEYFRAMES_CHUNK_SIZE
+             ? limit - start
+             : REPLAY_KEYFRAMES_CHUNK_SIZE;
+}
+
+/** Hash of chunk c as committed right now (0 past active_size). */
+de100_file_scoped_fn inline u64 chunk_hash(const ReplayKeyframes *keyframes,
+                                           u64 chunk_index, u64 active_size) {
+  u64 bytes = chunk_bytes(chunk_index, active_size);
+  if (bytes == 0) {
+    return 0;
+  }
+  return de100_hash64(keyframes->region +
+                          chunk_index * REPLAY_KEYFRAMES_CHUNK_SIZE,
+                      (size_t)bytes, REPLAY_KEYFRAMES_MAGIC);
+}
+
+de100_file_scoped_fn inline u64 clamp_active(const ReplayKeyframes *keyframes,
+                                             u64 active_size) {
+  return active_size < keyframes->region_size ? active_size
+                                              : keyframes->region_size;
+}
+
+/**
+ * Fill keyframes->changed with the chunks that differ from the last
+ * keyframe (or from frame 0) and bring the baseline up to date.
+ */
+de100_file_scoped_fn u32 collect_changed_chunks(ReplayKeyframes *keyframes,
+                                                u64 active_size) {
+  u32 count = 0;
+
+  if (keyframes->dirty_channel != DIRTY_PAGES_NO_CHANNEL) {
+    DirtyPageTracker *tracker = keyframes->tracker;
+    dirty_pages_harvest(tracker, active_size);
+
+    u64 cursor = 0, offset, size;
+    i64 last_marked = -1;
+    while (dirty_pages_next_run(tracker, keyframes->dirty_channel,
+                                active_size, &cursor, &offset, &size)) {
+      u64 first = offset / REPLAY_KEYFRAMES_CHUNK_SIZE;
+      u64 last = (offset + size - 1) / REPLAY_KEYFRAMES_CHUNK_SIZE;
+      for (u64 c = first; c <= last; ++c) {
+        // Runs come in order; neighbouring runs can share a chunk
+        if ((i64)c > last_marked) {
+          keyframes->changed[count++] = (u32)c;
+          last_marked = (i64)c;
+        }
+      }
+    }
+    dirty_pages_mark_synced(tracker, keyframes->dirty_channel, active_size);
+    return count;
+  }
+
+  for (u32 c = 0; c < keyframes->chunk_count; ++c) {
+    u64 hash = chunk_hash(keyframes, c, active_size);
+    if (hash != keyframes->chunk_hashes[c]) {
+      keyframes->chunk_hashes[c] = hash;
+      keyframes->changed[count++] = c;
+    }
+  }
+  return count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INIT / SHUTDOWN
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool replay_keyframes_init(ReplayKeyframes *keyframes, void *region,
+                           u64 region_size, u32 interval_frames,
+                           DirtyPageTracker *tracker) {
+  *keyframes = (ReplayKeyframes){0};
+  keyframes->dirty_channel = DIRTY_PAGES_NO_CHANNEL;
+  keyframes->write_fd = -1;
+  keyframes->read_fd = -1;
+
+  if (!region || region_size == 0 || interval_frames == 0) {
+    return false;
+  }
+
+  u64 chunk_count =
+      (region_size + REPLAY_KEYFRAMES_CHUNK_SIZE - 1) /
+      REPLAY_KEYFRAMES_CHUNK_SIZE;
+  u64 scratch_capacity =
+      de100_lz_compress_bound(REPLAY_KEYFRAMES_CHUNK_SIZE);
+
+  u64 hashes_bytes = chunk_count * sizeof(u64);
+  u64 changed_bytes = chunk_count * sizeof(u32);
+  u64 sources_bytes = chunk_count * sizeof(ReplayKeyframeSource);
+  u64 index_bytes = REPLAY_KEYFRAMES_MAX_COUNT * 2 * sizeof(u64);
+  u64 total = hashes_bytes + sources_bytes + index_bytes + changed_bytes +
+              scratch_capacity;
+
+  keyframes->storage =
+      de100_memory_alloc(NULL, (size_t)total, De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(keyframes->storage)) {
+    fprintf(stderr, "⚠️  Replay keyframes: failed to allocate %.1f KB: %s\n",
+            (f64)total / 1024.0,
+            de100_memory_error_str(keyframes->storage.error_code));
+    return false;
+  }
+
+  // 8-byte members first, so every array stays aligned
+  u8 *cursor = (u8 *)keyframes->storage.base;
+  keyframes->chunk_hashes = (u64 *)cursor;
+  cursor += hashes_bytes;
+  keyframes->sources = (ReplayKeyframeSource *)cursor;
+  cursor += sources_bytes;
+  keyframes->keyframe_frames = (u64 *)cursor;
+  cursor += REPLAY_KEYFRAMES_MAX_COUNT * sizeof(u64);
+  keyframes->keyframe_offsets = (u64 *)cursor;
+  cursor += REPLAY_KEYFRAMES_MAX_COUNT * sizeof(u64);
+  keyframes->changed = (u32 *)cursor;
+  cursor += changed_bytes;
+  keyframes->scratch = cursor;
+  keyframes->scratch_capacity = scratch_capacity;
+
+  keyframes->region = (u8 *)region;
+  keyframes->region_size = region_size;
+  keyframes->chunk_count = (u32)chunk_count;
+  keyframes->interval_frames = interval_frames;
+
+  keyframes->tracker = tracker;
+  if (dirty_pages_is_active(tracker)) {
+    keyframes->dirty_channel = dirty_pages_add_channel(tracker);
+  }
+
+  keyframes->is_enabled = true;
+  return true;
+}
+
+void replay_keyframes_shutdown(ReplayKeyframes *keyframes) {
+  if (!keyframes || !keyframes->is_enabled) {
+    return;
+  }
+  replay_keyframes_end_write(keyframes);
+  replay_keyframes_close_read(keyframes);
+  de100_memory_free(&keyframes->storage);
+  keyframes->is_enabled = false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WRITING
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool replay_keyframes_begin_write(ReplayKeyframes *keyframes,
+                                  const char *filename, u64 active_size) {
+  if (!keyframes->is_enabled || keyframes->is_writing) {
+    return false;
+  }
+  active_size = clamp_active(keyframes, active_size);
+
+  De100FileOpenResult open_result = de100_file_open(
+      filename, DE100_FILE_WRITE | DE100_FILE_CREATE | DE100_FILE_TRUNCATE);
+  if (!open_result.success) {
+    return false;
+  }
+
+  ReplayKeyframesHeader header = {
+      .magic = REPLAY_KEYFRAMES_MAGIC,
+      .version = REPLAY_KEYFRAMES_VERSION,
+      .chunk_size = REPLAY_KEYFRAMES_CHUNK_SIZE,
+      .interval_frames = keyframes->interval_frames,
+      .region_size = keyframes->region_size,
+  };
+  if (!de100_file_write_all(open_result.fd, &header, sizeof(header))
+           .success ||
+      !async_writer_open(&keyframes->writer, open_result.fd,
+                         REPLAY_KEYFRAMES_WRITE_RING_SIZE)) {
+    de100_file_close(open_result.fd);
+    return false;
+  }
+
+  // Baseline = frame 0: everything up to here is in the slot snapshot
+  if (keyframes->dirty_channel != DIRTY_PAGES_NO_CHANNEL) {
+    dirty_pages_harvest(keyframes->tracker, active_size);
+    dirty_pages_mark_synced(keyframes->tracker, keyframes->dirty_channel,
+                            active_size);
+  } else {
+    for (u32 c = 0; c < keyframes->chunk_count; ++c) {
+      keyframes->chunk_hashes[c] = chunk_hash(keyframes, c, active_size);
+    }
+  }
+
+  keyframes->write_fd = open_result.fd;
+  keyframes->keyframes_written = 0;
+  keyframes->bytes_written = sizeof(header);
+  keyframes->is_writing = true;
+  return true;
+}
+
+void replay_keyframes_maybe_capture(ReplayKeyframes *keyframes,
+                                    u64 frame_index, u64 active_size) {
+  if (!keyframes->is_writing || frame_index == 0 ||
+      frame_index % keyframes->interval_frames != 0) {
+    return;
+  }
+  TIMED_FUNCTION();
+  active_size = clamp_active(keyframes, active_size);
+
+  u32 changed_count = collect_changed_chunks(keyframes, active_size);
+
+  ReplayKeyframeRecord record = {
+      .magic = REPLAY_KEYFRAMES_RECORD_MAGIC,
+      .chunk_count = changed_count,
+      .frame_index = frame_index,
+  };
+  bool ok = async_writer_append(&keyframes->writer, &record, sizeof(record));
+  u64 bytes = sizeof(record);
+
+  for (u32 i = 0; ok && i < changed_count; ++i) {
+    u32 c = keyframes->changed[i];
+    u64 raw_size = chunk_bytes(c, active_size);
+    const u8 *source = keyframes->region + (u64)c * REPLAY_KEYFRAMES_CHUNK_SIZE;
+
+    size_t compressed =
+        de100_lz_compress(source, (size_t)raw_size, keyframes->scratch,
+                          (size_t)keyframes->scratch_capacity);
+    bool is_compressed = compressed > 0 && compressed < raw_size;
+
+    ReplayKeyframeChunk chunk = {
+        .chunk_index = c,
+        .stored_size = (u32)(is_compressed ? compressed : raw_size),
+        .raw_size = (u32)raw_size,
+        .is_compressed = is_compressed,
+    };
+    ok = async_writer_append(&keyframes->writer, &chunk, sizeof(chunk)) &&
+         async_writer_append(&keyframes->writer,
+                             is_compressed ? keyframes->scratch : source,
+                             chunk.stored_size);
+    bytes += sizeof(chunk) + chunk.stored_size;
+  }
+
+  if (!ok) {
+    // Earlier keyframes stay usable; the torn record is ignored on read
+    fprintf(stderr, "[KEYFRAMES] ❌ Failed to write keyframe at frame %llu, "
+                    "no more keyframes for this recording\n",
+            (unsigned long long)frame_index);
+    replay_keyframes_end_write(keyframes);
+    return;
+  }
+
+  keyframes->keyframes_written++;
+  keyframes->bytes_written += bytes;
+}
+
+void replay_keyframes_end_write(ReplayKeyframes *keyframes) {
+  if (!keyframes->is_writing) {
+    return;
+  }
+  async_writer_close(&keyframes->writer);
+  de100_file_close(keyframes->write_fd);
+  keyframes->write_fd = -1;
+  keyframes->is_writing = false;
+
+  if (keyframes->keyframes_written > 0) {
+    printf("[KEYFRAMES] 🎯 %llu keyframes, %.1f KB\n",
+           (unsigned long long)keyframes->keyframes_written,
+           (f64)keyframes->bytes_written / 1024.0);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// READING
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool replay_keyframes_open_read(ReplayKeyframes *keyframes,
+                                const char *filename) {
+  replay_keyframes_close_read(keyframes);
+  if (!keyframes->is_enabled) {
+    return false;
+  }
+
+  De100FileOpenResult open_result = de100_file_open(filename, DE100_FILE_READ);
+  if (!open_result.success) {
+    return false;
+  }
+  i32 fd = open_result.fd;
+
+  ReplayKeyframesHeader header;
+  bool ok = de100_file_read_all(fd, &header, sizeof(header)).success &&
+            header.magic == REPLAY_KEYFRAMES_MAGIC &&
+            header.version == REPLAY_KEYFRAMES_VERSION &&
+            header.chunk_size == REPLAY_KEYFRAMES_CHUNK_SIZE &&
+            header.region_size == keyframes->region_size;
+  if (!ok) {
+    de100_file_close(fd);
+    return false;
+  }
+
+  // Walk the records; stop at the first incomplete one (crash)
+  De100FileSizeResult size_result = de100_file_get_size(filename);
+  u64 file_size = size_result.success ? (u64)size_result.value : 0;
+  u64 offset = sizeof(header);
+  u32 count = 0;
+
+  while (count < REPLAY_KEYFRAMES_MAX_COUNT &&
+         offset + sizeof(ReplayKeyframeRecord) <= file_size) {
+    ReplayKeyframeRecord record;
+    if (!de100_file_seek(fd, (i64)offset, DE100_SEEK_SET).success ||
+        !de100_file_read_all(fd, &record, sizeof(record)).success ||
+        record.magic != REPLAY_KEYFRAMES_RECORD_MAGIC ||
+        record.chunk_count > keyframes->chunk_count) {
+      break;
+    }
+
+    u64 cursor = offset + sizeof(record);
+    bool complete = true;
+    for (u32 i = 0; complete && i < record.chunk_count; ++i) {
+      ReplayKeyframeChunk chunk;
+      complete = cursor + sizeof(chunk) <= file_size &&
+                 de100_file_seek(fd, (i64)cursor, DE100_SEEK_SET).success &&
+                 de100_file_read_all(fd, &chunk, sizeof(chunk)).success &&
+                 chunk.chunk_index < keyframes->chunk_count &&
+                 chunk.stored_size <= keyframes->scratch_capacity &&
+                 chunk.raw_size <= REPLAY_KEYFRAMES_CHUNK_SIZE;
+      cursor += sizeof(chunk) + (complete ? chunk.stored_size : 0);
+      complete = complete && cursor <= file_size;
+    }
+    if (!complete) {
+      break;
+    }
+
+    keyframes->keyframe_frames[count] = record.frame_index;
+    keyframes->keyframe_offsets[count] = offset;
+    count++;
+    offset = cursor;
+  }
+
+  if (count == 0) {
+    de100_file_close(fd);
+    return false;
+  }
+
+  keyframes->read_fd = fd;
+  keyframes->keyframe_count = count;
+  keyframes->is_reading = true;
+  return true;
+}
+
+u32 replay_keyframes_find(const ReplayKeyframes *keyframes, u64 frame_index) {
+  if (!keyframes->is_reading) {
+    return 0;
+  }
+  // Frame indices ascend: binary search for the last one <= frame_index
+  u32 low = 0;
+  u32 high = keyframes->keyframe_count;
+  while (low < high) {
+    u32 mid = low + (high - low) / 2;
+    if (keyframes->keyframe_frames[mid] <= frame_index) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low; // 1-based: keyframes 1..low are at or before frame_index
+}
+
+i64 replay_keyframes_restore(ReplayKeyframes *keyframes, u32 keyframe,
+                             u64 active_size) {
+  if (!keyframes->is_reading || keyframe > keyframes->keyframe_count) {
+    return -1;
+  }
+  active_size = clamp_active(keyframes, active_size);
+  i32 fd = keyframes->read_fd;
+
+  // Newest version of every chunk in keyframes 1..keyframe
+  memset(keyframes->sources, 0,
+         keyframes->chunk_count * sizeof(ReplayKeyframeSource));
+  for (u32 k = 0; k < keyframe; ++k) {
+    ReplayKeyframeRecord record;
+    u64 cursor = keyframes->keyframe_offsets[k];
+    if (!de100_file_seek(fd, (i64)cursor, DE100_SEEK_SET).success ||
+        !de100_file_read_all(fd, &record, sizeof(record)).success) {
+      return -1;
+    }
+    cursor += sizeof(record);
+
+    for (u32 i = 0; i < record.chunk_count; ++i) {
+      ReplayKeyframeChunk chunk;
+      if (!de100_file_read_all(fd, &chunk, sizeof(chunk)).success ||
+          !de100_file_seek(fd, (i64)chunk.stored_size, DE100_SEEK_CUR)
+               .success) {
+        return -1;
+      }
+      keyframes->sources[chunk.chunk_index] = (ReplayKeyframeSource){
+          .data_offset = cursor + sizeof(chunk),
+          .chunk = chunk,
+      };
+      cursor += sizeof(chunk) + chunk.stored_size;
+    }
+  }
+
+  i64 restored = 0;
+  for (u32 c = 0; c < keyframes->chunk_count; ++c) {
+    const ReplayKeyframeSource *source = &keyframes->sources[c];
+    if (source->data_offset == 0) {
+      continue;
+    }
+    // Committed memory only grows while the engine runs, so a recorded
+    // chunk always fits unless the file belongs to another configuration
+    u64 bytes = source->chunk.raw_size;
+    if (bytes > chunk_bytes(c, active_size)) {
+      return -1;
+    }
+
+    // Always through scratch: with write-fault dirty tracking, read(2)
+    // straight into protected game memory fails with EFAULT.
+    u8 *dst = keyframes->region + (u64)c * REPLAY_KEYFRAMES_CHUNK_SIZE;
+    if (!de100_file_seek(fd, (i64)source->data_offset, DE100_SEEK_SET)
+             .success ||
+        !de100_file_read_all(fd, keyframes->scratch,
+                             source->chunk.stored_size)
+             .success) {
+      return -1;
+    }
+    if (source->chunk.is_compressed) {
+      if (de100_lz_decompress(keyframes->scratch, source->chunk.stored_size,
+                              dst, (size_t)bytes) != bytes) {
+        return -1;
+      }
+    } else {
+      de100_mem_copy(dst, keyframes->scratch, (size_t)bytes);
+    }
+    restored += (i64)bytes;
+  }
+  return restored;
+}
+
+void replay_keyframes_close_read(ReplayKeyframes *keyframes) {
+  if (!keyframes->is_reading) {
+    return;
+  }
+  de100_file_close(keyframes->read_fd);
+  keyframes->read_fd = -1;
+  keyframes->keyframe_count = 0;
+  keyframes->is_reading = false;
+}
@@ -0,0 +1,171 @@
+#ifndef DE100_PLATFORMS__COMMON_REPLAY_KEYFRAMES_H
+#define DE100_PLATFORMS__COMMON_REPLAY_KEYFRAMES_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "./async-writer.h"
+#include "./dirty-pages.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🎯 REPLAY KEYFRAMES (Periodic game memory snapshots for seeking)
+// ═══════════════════════════════════════════════════════════════════════════
+// A recording starts from one replay slot snapshot (frame 0). To jump into
+// the middle of a long recording without simulating everything before it,
+// recording also appends a keyframe every interval_frames frames to
+// loop_edit_N_keys.hmi. A keyframe only holds the chunks that changed since
+// the previous one, LZ-compressed:
+//
+// FILE:
+//   [ReplayKeyframesHeader]
+//   [ReplayKeyframeRecord][chunk][chunk]...      keyframe 1
+//   [ReplayKeyframeRecord][chunk][chunk]...      keyframe 2 ...
+//
+//   chunk = [ReplayKeyframeChunk][stored_size bytes]
+//
+// Seeking to keyframe k = restore the slot, then for every chunk write its
+// newest version from keyframes 1..k. Each chunk is decompressed once, so
+// the cost is bounded by memory size, not by how far in k is.
+//
+// "Changed since the previous keyframe" comes from a dirty page channel
+// when tracking is active, else from comparing per-chunk hashes: one hash
+// pass over the region per keyframe, ~0.2 ms per MB on the game thread. The
+// engine therefore only keyframes all of game memory with a tracker;
+// without one the region is permanent storage (where game state lives, as
+// for rewind and the determinism hash), and a seek leaves transient storage
+// as the slot restored it.
+//
+// Records are queued on an AsyncWriter; compression still runs on the game
+// thread, once per interval, at ~2.3 ms per MB of chunks written since the
+// previous keyframe. With a tracker that includes transient storage, so a
+// scratch arena reused every frame is paid for in full at every keyframe.
+// Measured per keyframe (WRITE_FAULT tracker over 256 MB): 1 MB written in
+// the interval ≈ 3 ms, 8 MB ≈ 20 ms, 32 MB ≈ 50 ms. Without a tracker, 64 MB
+// of permanent storage with 8 MB written ≈ 23 ms. A record cut short by a
+// crash is ignored.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define REPLAY_KEYFRAMES_MAGIC 0x59454B44u // "DKEY"
+#define REPLAY_KEYFRAMES_RECORD_MAGIC 0x4D52464Bu // "KFRM"
+#define REPLAY_KEYFRAMES_VERSION 1u
+#define REPLAY_KEYFRAMES_CHUNK_SIZE KILOBYTES(64)
+// Seeking past the last indexed keyframe simulates from it (~5.7 h of
+// keyframes at the default 5 s interval)
+#define REPLAY_KEYFRAMES_MAX_COUNT 4096
+// Big enough that a typical keyframe never waits on the disk
+#define REPLAY_KEYFRAMES_WRITE_RING_SIZE MEGABYTES(8)
+
+typedef struct {
+  u32 magic;
+  u32 version;
+  u32 chunk_size;
+  u32 interval_frames;
+  u64 region_size;
+} ReplayKeyframesHeader;
+
+typedef struct {
+  u32 magic;
+  u32 chunk_count;
+  u64 frame_index;
+} ReplayKeyframeRecord;
+
+typedef struct {
+  u32 chunk_index;
+  u32 stored_size;
+  u32 raw_size;
+  u32 is_compressed;
+} ReplayKeyframeChunk;
+
+typedef struct {
+  u64 data_offset; // 0 = chunk not in any keyframe up to the target
+  ReplayKeyframeChunk chunk;
+} ReplayKeyframeSource;
+
+typedef struct {
+  bool is_enabled;
+  u32 interval_frames;
+
+  u8 *region;
+  u64 region_size;
+  u32 chunk_count;
+
+  DirtyPageTracker *tracker;
+  i32 dirty_channel;
+  u64 *chunk_hashes; // No tracker: chunk contents as of the last keyframe
+  u32 *changed;      // Chunk indices of the keyframe being written
+
+  u8 *scratch; // One compressed chunk
+  u64 scratch_capacity;
+
+  // Writing
+  bool is_writing;
+  i32 write_fd;
+  AsyncWriter writer;
+  u64 keyframes_written;
+  u64 bytes_written;
+
+  // Reading
+  bool is_reading;
+  i32 read_fd;
+  u64 *keyframe_frames;  // Frame index of each complete keyframe
+  u64 *keyframe_offsets; // File offset of its record
+  u32 keyframe_count;
+  ReplayKeyframeSource *sources; // Per chunk, filled by restore
+
+  De100MemoryBlock storage;
+} ReplayKeyframes;
+
+/**
+ * @param region           Game memory: everything a replay slot restores,
+ *                         or a prefix of it (permanent storage)
+ * @param interval_frames  Frames between keyframes
+ * @param tracker          Dirty tracking over `region` (may be NULL)
+ */
+bool replay_keyframes_init(ReplayKeyframes *keyframes, void *region,
+                           u64 region_size, u32 interval_frames,
+                           DirtyPageTracker *tracker);
+
+void replay_keyframes_shutdown(ReplayKeyframes *keyframes);
+
+/**
+ * Start a keyframe file. Memory right now is frame 0 (the state the replay
+ * slot is saving), which the first keyframe is a delta against.
+ */
+bool replay_keyframes_begin_write(ReplayKeyframes *keyframes,
+                                  const char *filename, u64 active_size);
+
+/** Append a keyframe if `frame_index` is on the interval. */
+void replay_keyframes_maybe_capture(ReplayKeyframes *keyframes,
+                                    u64 frame_index, u64 active_size);
+
+void replay_keyframes_end_write(ReplayKeyframes *keyframes);
+
+/** Index a keyframe file for seeking (false = no usable keyframes). */
+bool replay_keyframes_open_read(ReplayKeyframes *keyframes,
+                                const char *filename);
+
+/**
+ * Nearest keyframe at or before `frame_index`.
+ *
+ * @return Keyframe number (1-based), 0 = none (start from the slot)
+ */
+u32 replay_keyframes_find(const ReplayKeyframes *keyframes, u64 frame_index);
+
+static inline u64 replay_keyframes_frame(const ReplayKeyframes *keyframes,
+                                         u32 keyframe) {
+  return keyframe ? keyframes->keyframe_frames[keyframe - 1] : 0;
+}
+
+/**
+ * Turn memory holding the slot's frame 0 into keyframe `keyframe`'s state.
+ *
+ * @return Bytes written to memory, or -1 on a read/decompress error (memory
+ *         is then partially updated; restore the slot again)
+ */
+i64 replay_keyframes_restore(ReplayKeyframes *keyframes, u32 keyframe,
+                             u64 active_size);
+
+void replay_keyframes_close_read(ReplayKeyframes *keyframes);
+
+#endif // DE100_PLATFORMS__COMMON_REPLAY_KEYFRAMES_H
@@ -0,0 +1,485 @@
+#include "./rewind.h"
+#include "../../_common/memory.h"
+#include "../../_common/profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ENCODING
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u32 chunk_count;
+  u32 frame_index;
+} RewindFrameHeader;
+
+typedef struct {
+  u32 word_index;
+  u32 word_count;
+} RewindChunkHeader;
+
+// A lone zero word inside a changed span costs 8 bytes to store as a literal
+// but 8 bytes of chunk header to skip, so only gaps longer than this split a
+// chunk.
+#define REWIND_MAX_MERGE_GAP_WORDS 1
+
+// Sizes the entry index. Small deltas are common (a few words per frame), so
+// this leans low; when the index fills up the oldest entry is dropped just
+// like when the byte budget runs out.
+#define REWIND_BYTES_PER_ENTRY_ESTIMATE 256
+
+typedef struct {
+  u8 *out;
+  u64 capacity;
+  u64 used;
+  u32 chunk_count;
+  bool overflowed;
+
+  // Open chunk (word_count == 0 means none)
+  u64 chunk_header_pos;
+  u32 chunk_word_index;
+  u32 chunk_word_count;
+} RewindEncoder;
+
+de100_file_scoped_fn inline void encoder_close_chunk(RewindEncoder *enc) {
+  if (enc->chunk_word_count == 0 || enc->overflowed) {
+    enc->chunk_word_count = 0;
+    return;
+  }
+  RewindChunkHeader header = {enc->chunk_word_index, enc->chunk_word_count};
+  de100_mem_copy(enc->out + enc->chunk_header_pos, &header, sizeof(header));
+  enc->chunk_count++;
+  enc->chunk_word_count = 0;
+}
+
+de100_file_scoped_fn inline void encoder_push_word(RewindEncoder *enc,
+                                                   u32 word_index, u64 xor) {
+  if (enc->overflowed) {
+    return;
+  }
+
+  bool extends = enc->chunk_word_count > 0 &&
+                 word_index - (enc->chunk_word_index + enc->chunk_word_count) <=
+                     REWIND_MAX_MERGE_GAP_WORDS;
+
+  u32 gap = extends ? word_index - (enc->chunk_word_index +
+                                    enc->chunk_word_count)
+                    : 0;
+  u64 needed = (u64)(gap + 1) * sizeof(u64) +
+               (extends ? 0 : sizeof(RewindChunkHeader));
+  if (enc->used + needed > enc->capacity) {
+    enc->overflowed = true;
+    return;
+  }
+
+  if (!extends) {
+    encoder_close_chunk(enc);
+    enc->chunk_header_pos = enc->used;
+    enc->used += sizeof(RewindChunkHeader);
+    enc->chunk_word_index = word_index;
+  }
+
+  // Gap words are unchanged: their XOR is zero
+  for (u32 i = 0; i < gap; ++i) {
+    u64 zero = 0;
+    de100_mem_copy(enc->out + enc->used, &zero, sizeof(zero));
+    enc->used += sizeof(zero);
+  }
+  de100_mem_copy(enc->out + enc->used, &xor, sizeof(xor));
+  enc->used += sizeof(xor);
+  enc->chunk_word_count += gap + 1;
+}
+
+/**
+ * XOR [offset, offset + size) of the region against the shadow, emit the
+ * non-zero words and bring the shadow up to date.
+ */
+de100_file_scoped_fn void encode_range(RewindBuffer *rewind,
+                                       RewindEncoder *enc, u64 offset,
+                                       u64 size) {
+  const u64 *current = (const u64 *)(rewind->region + offset);
+  u64 *shadow = (u64 *)(rewind->shadow + offset);
+  u64 word_count = size / sizeof(u64);
+  u32 base_word = (u32)(offset / sizeof(u64));
+
+  for (u64 i = 0; i < word_count; ++i) {
+    u64 xor = current[i] ^ shadow[i];
+    if (xor) {
+      encoder_push_word(enc, base_word + (u32)i, xor);
+      shadow[i] = current[i];
+    }
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RING
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline RewindEntry *entry_at(RewindBuffer *rewind,
+                                                  u32 age_index) {
+  return &rewind->entries[(rewind->entry_head + age_index) %
+                          rewind->entry_capacity];
+}
+
+de100_file_scoped_fn inline void drop_oldest(RewindBuffer *rewind) {
+  RewindEntry *oldest = entry_at(rewind, 0);
+  rewind->bytes_used -= oldest->size;
+  rewind->entry_head = (rewind->entry_head + 1) % rewind->entry_capacity;
+  rewind->entry_count--;
+}
+
+de100_file_scoped_fn inline bool ranges_overlap(u64 a, u64 a_size, u64 b,
+                                                u64 b_size) {
+  return a < b + b_size && b < a + a_size;
+}
+
+/**
+ * Reserve `size` contiguous ring bytes after the newest entry, evicting the
+ * oldest entries that are in the way. Entries are laid out in capture order,
+ * so whatever sits ahead of write_pos is always the oldest.
+ */
+de100_file_scoped_fn u64 ring_reserve(RewindBuffer *rewind, u64 size) {
+  u64 pos = rewind->write_pos;
+  if (pos + size > rewind->ring_capacity) {
+    // Wrapping: the tail past write_pos holds the oldest entries, and the
+    // next lap will overwrite it before reaching them in age order. Drop
+    // them all now, not just the ones [0, size) happens to overlap.
+    while (rewind->entry_count > 0 &&
+           entry_at(rewind, 0)->offset >= rewind->write_pos) {
+      drop_oldest(rewind);
+    }
+    pos = 0;
+  }
+
+  while (rewind->entry_count > 0) {
+    RewindEntry *oldest = entry_at(rewind, 0);
+    bool index_full = rewind->entry_count == rewind->entry_capacity;
+    if (!index_full &&
+        !ranges_overlap(pos, size, oldest->offset, oldest->size)) {
+      break;
+    }
+    drop_oldest(rewind);
+  }
+
+  return pos;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LIFECYCLE
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool rewind_init(RewindBuffer *rewind, void *region, u64 region_size,
+                 u64 budget, DirtyPageTracker *tracker) {
+  *rewind = (RewindBuffer){0};
+  rewind->dirty_channel = DIRTY_PAGES_NO_CHANNEL;
+
+  region_size &= ~(u64)(sizeof(u64) - 1);
+  if (!region || region_size == 0 || budget < sizeof(u64)) {
+    return false;
+  }
+
+  if (region_size / sizeof(u64) > (u64)UINT32_MAX) {
+    fprintf(stderr, "⚠️  Rewind: region too large (%.2f GB), disabled\n",
+            (double)region_size / (1024.0 * 1024.0 * 1024.0));
+    return false;
+  }
+
+  u64 ring_capacity = budget & ~(u64)(sizeof(u64) - 1);
+  u64 scratch_capacity = (ring_capacity / 4) & ~(u64)(sizeof(u64) - 1);
+  if (scratch_capacity < KILOBYTES(64)) {
+    scratch_capacity = KILOBYTES(64);
+  }
+  u64 entry_capacity = ring_capacity / REWIND_BYTES_PER_ENTRY_ESTIMATE;
+  if (entry_capacity < 64) {
+    entry_capacity = 64;
+  }
+  if (entry_capacity > UINT32_MAX) {
+    entry_capacity = UINT32_MAX;
+  }
+
+  u64 shadow_size = region_size;
+  u64 total = shadow_size + ring_capacity + scratch_capacity +
+              entry_capacity * sizeof(RewindEntry);
+
+  rewind->storage = de100_memory_alloc(
+      NULL, (size_t)total,
+      De100_MEMORY_FLAG_RW | De100_MEMORY_FLAG_ZEROED);
+  if (!de100_memory_is_valid(rewind->storage)) {
+    fprintf(stderr, "⚠️  Rewind: failed to allocate %.2f MB: %s\n",
+            (double)total / (1024.0 * 1024.0),
+            de100_memory_error_str(rewind->storage.error_code));
+    return false;
+  }
+
+  u8 *cursor = (u8 *)rewind->storage.base;
+  rewind->shadow = cursor;
+  cursor += shadow_size;
+  rewind->ring = cursor;
+  cursor += ring_capacity;
+  rewind->scratch = cursor;
+  cursor += scratch_capacity;
+  rewind->entries = (RewindEntry *)cursor;
+
+  rewind->region = (u8 *)region;
+  rewind->region_size = region_size;
+  rewind->ring_capacity = ring_capacity;
+  rewind->scratch_capacity = scratch_capacity;
+  rewind->entry_capacity = (u32)entry_capacity;
+  rewind->tracker = tracker;
+  if (dirty_pages_is_active(tracker)) {
+    rewind->dirty_channel = dirty_pages_add_channel(tracker);
+  }
+
+  rewind_reset(rewind);
+  rewind->is_enabled = true;
+  return true;
+}
+
+void rewind_shutdown(RewindBuffer *rewind) {
+  if (!rewind) {
+    return;
+  }
+  if (de100_memory_is_valid(rewind->storage)) {
+    de100_memory_free(&rewind->storage);
+  }
+  *rewind = (RewindBuffer){0};
+  rewind->dirty_channel = DIRTY_PAGES_NO_CHANNEL;
+}
+
+void rewind_reset(RewindBuffer *rewind) {
+  if (!rewind || !rewind->shadow) {
+    return;
+  }
+
+  de100_mem_copy(rewind->shadow, rewind->region, (size_t)rewind->region_size);
+  rewind->write_pos = 0;
+  rewind->entry_head = 0;
+  rewind->entry_count = 0;
+  rewind->bytes_used = 0;
+  rewind->skip_next_capture = false;
+
+  if (rewind->dirty_channel != DIRTY_PAGES_NO_CHANNEL) {
+    // Memory written before this point is already in the shadow; anything
+    // still pending in the tracker will just compare equal next capture.
+    dirty_pages_mark_synced(rewind->tracker, rewind->dirty_channel,
+                            rewind->region_size);
+  }
+}
+
+void rewind_set_scrubbing(RewindBuffer *rewind, bool is_scrubbing) {
+  if (rewind && rewind->is_enabled) {
+    rewind->is_scrubbing = is_scrubbing;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CAPTURE
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline bool rewind_uses_tracker(RewindBuffer *rewind,
+                                                     u64 active_size) {
+  // The whole committed range is harvested (see dirty_pages_harvest); only
+  // runs below region_size are read back
+  return rewind->dirty_channel != DIRTY_PAGES_NO_CHANNEL &&
+         dirty_pages_harvest(rewind->tracker, active_size);
+}
+
+void rewind_capture(RewindBuffer *rewind, u32 frame_index, u64 active_size) {
+  if (!rewind || !rewind->is_enabled) {
+    return;
+  }
+  if (rewind->skip_next_capture) {
+    rewind->skip_next_capture = false;
+    return;
+  }
+  TIMED_FUNCTION();
+
+  RewindEncoder enc = {
+      .out = rewind->scratch,
+      .capacity = rewind->scratch_capacity,
+      .used = sizeof(RewindFrameHeader),
+  };
+
+  if (rewind_uses_tracker(rewind, active_size)) {
+    u64 cursor = 0, offset = 0, size = 0;
+    while (dirty_pages_next_run(rewind->tracker, rewind->dirty_channel,
+                                rewind->region_size, &cursor, &offset,
+                                &size)) {
+      encode_range(rewind, &enc, offset, size);
+    }
+    dirty_pages_mark_synced(rewind->tracker, rewind->dirty_channel,
+                            rewind->region_size);
+  } else {
+    encode_range(rewind, &enc, 0, rewind->region_size);
+  }
+  encoder_close_chunk(&enc);
+
+  rewind->frames_captured++;
+
+  if (enc.overflowed || enc.used > rewind->ring_capacity) {
+    // The shadow is current (encode_range keeps going), but the chain back
+    // to older entries is broken by the frame we couldn't store.
+    rewind->frames_dropped_too_big++;
+    rewind->write_pos = 0;
+    rewind->entry_head = 0;
+    rewind->entry_count = 0;
+    rewind->bytes_used = 0;
+    rewind->last_delta_size = 0;
+#if DE100_INTERNAL
+    printf("[REWIND] ⚠️  Frame %u delta doesn't fit the budget, history "
+           "dropped\n",
+           frame_index);
+#endif
+    return;
+  }
+
+  // Frames where nothing changed still get an (8-byte) entry so one step
+  // back is always one frame back.
+  RewindFrameHeader header = {enc.chunk_count, frame_index};
+  de100_mem_copy(rewind->scratch, &header, sizeof(header));
+
+  u64 pos = ring_reserve(rewind, enc.used);
+  de100_mem_copy(rewind->ring + pos, rewind->scratch, (size_t)enc.used);
+
+  RewindEntry *entry = entry_at(rewind, rewind->entry_count);
+  entry->offset = pos;
+  entry->size = (u32)enc.used;
+  entry->frame_index = frame_index;
+  rewind->entry_count++;
+  rewind->bytes_used += enc.used;
+  rewind->write_pos = pos + enc.used;
+  rewind->last_delta_size = enc.used;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STEP BACK
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool rewind_step_back(RewindBuffer *rewind, u64 active_size) {
+  if (!rewind || !rewind->is_enabled || rewind->entry_count == 0) {
+    return false;
+  }
+
+  // 1. Throw away whatever the game wrote since the newest entry: memory
+  //    goes back to the shadow.
+  if (rewind_uses_tracker(rewind, active_size)) {
+    u64 cursor = 0, offset = 0, size = 0;
+    while (dirty_pages_next_run(rewind->tracker, rewind->dirty_channel,
+                                rewind->region_size, &cursor, &offset,
+                                &size)) {
+      de100_mem_copy(rewind->region + offset, rewind->shadow + offset,
+                     (size_t)size);
+    }
+  } else {
+    de100_mem_copy(rewind->region, rewind->shadow,
+                   (size_t)rewind->region_size);
+  }
+
+  // 2. Undo the newest delta in both shadow and memory
+  RewindEntry *entry = entry_at(rewind, rewind->entry_count - 1);
+  const u8 *read = rewind->ring + entry->offset;
+
+  RewindFrameHeader header;
+  de100_mem_copy(&header, read, sizeof(header));
+  read += sizeof(header);
+
+  u64 *shadow = (u64 *)rewind->shadow;
+  u64 *region = (u64 *)rewind->region;
+  for (u32 c = 0; c < header.chunk_count; ++c) {
+    RewindChunkHeader chunk;
+    de100_mem_copy(&chunk, read, sizeof(chunk));
+    read += sizeof(chunk);
+
+    for (u32 i = 0; i < chunk.word_count; ++i) {
+      u64 xor;
+      de100_mem_copy(&xor, read, sizeof(xor));
+      read += sizeof(xor);
+
+      u64 w = (u64)chunk.word_index + i;
+      shadow[w] ^= xor;
+      region[w] = shadow[w];
+    }
+  }
+
+  // 3. Pop it; its bytes are free again
+  rewind->bytes_used -= entry->size;
+  rewind->write_pos = entry->offset;
+  rewind->entry_count--;
+
+  // Memory now equals the shadow. The pages we just wrote will show up as
+  // dirty next harvest and compare equal, but the next capture would record
+  // an empty frame for a frame that never ran, so skip it.
+  if (rewind->dirty_channel != DIRTY_PAGES_NO_CHANNEL) {
+    dirty_pages_mark_synced(rewind->tracker, rewind->dirty_channel,
+                            rewind->region_size);
+  }
+  rewind->skip_next_capture = true;
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SELF TEST
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if DE100_INTERNAL
+
+bool rewind_self_test(void) {
+  const u64 region_size = KILOBYTES(4);
+  const u64 budget = KILOBYTES(16);
+  const u32 frame_count = 4000; // Deltas fill the ring many times over
+
+  De100MemoryBlock block = de100_memory_alloc(
+      NULL, (size_t)(region_size * (frame_count + 2)),
+      De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(block)) {
+    return false;
+  }
+  u64 *region = (u64 *)block.base;
+  u8 *snapshots = (u8 *)block.base + region_size; // State after each frame
+
+  RewindBuffer rewind;
+  if (!rewind_init(&rewind, region, region_size, budget, NULL)) {
+    de100_memory_free(&block);
+    return false;
+  }
+
+  // Uneven delta sizes so wraps leave tails of every length behind
+  u64 rng = 0x9E3779B97F4A7C15ull;
+  u32 word_count = (u32)(region_size / sizeof(u64));
+  de100_mem_copy(snapshots, region, (size_t)region_size);
+  for (u32 frame = 1; frame <= frame_count; ++frame) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    u32 writes = 1 + (u32)(rng % 96);
+    for (u32 i = 0; i < writes; ++i) {
+      rng ^= rng << 13;
+      rng ^= rng >> 7;
+      rng ^= rng << 17;
+      region[rng % word_count] = rng;
+    }
+    rewind_capture(&rewind, frame, region_size);
+    de100_mem_copy(snapshots + (u64)frame * region_size, region,
+                   (size_t)region_size);
+  }
+
+  bool ok = rewind.entry_count > 0;
+  u32 steps = 0;
+  while (ok && rewind.entry_count > 0) {
+    u32 frame = entry_at(&rewind, rewind.entry_count - 1)->frame_index;
+    ok = frame > 0 && rewind_step_back(&rewind, region_size) &&
+         memcmp(region, snapshots + (u64)(frame - 1) * region_size,
+                (size_t)region_size) == 0;
+    steps++;
+  }
+
+  printf("[REWIND] Self test: %u frames captured, %u stepped back: %s\n",
+         frame_count, steps, ok ? "OK" : "FAILED");
+
+  rewind_shutdown(&rewind);
+  de100_memory_free(&block);
+  return ok;
+}
+
+#endif
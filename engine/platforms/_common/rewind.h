@@ -0,0 +1,116 @@
+#ifndef DE100_PLATFORMS__COMMON_REWIND_H
+#define DE100_PLATFORMS__COMMON_REWIND_H
+
+#include "../../_common/base.h"
+#include "../../_common/memory.h"
+#include "./dirty-pages.h"
+#include <stdbool.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ⏪ REWIND RING (Per-frame XOR deltas, fixed memory budget)
+// ═══════════════════════════════════════════════════════════════════════════
+// Keeps the last N frames of a memory region (permanent storage by default)
+// so the game can be scrubbed backwards one frame at a time.
+//
+// Every capture XORs the region against a shadow copy of the previous
+// capture. The XOR is almost all zeros, so only the non-zero 8-byte words
+// are stored, grouped into chunks (zero runs are implicit):
+//
+//   Frame entry:  [RewindFrameHeader][chunk][chunk]...
+//   Chunk:        [u32 word_index][u32 word_count][word_count x u64 XOR]
+//
+// Stepping back XORs the newest entry into the shadow (and memory), which
+// turns "frame N" back into "frame N-1". The chain undoes itself one step
+// at a time, so no keyframes are needed: the shadow IS the keyframe for the
+// newest entry, and the oldest entries can be dropped freely when the ring
+// runs out of budget.
+//
+// Which pages to compare comes from a DirtyPageTracker channel when one is
+// active; otherwise the whole region is compared every capture (fine for a
+// few MB of permanent storage, expensive for more).
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  u64 offset; // Byte offset in the ring
+  u32 size;   // Encoded bytes
+  u32 frame_index;
+} RewindEntry;
+
+typedef struct {
+  bool is_enabled;
+  // Set by game adapters (e.g. while a key is held). The engine steps back
+  // one frame per frame instead of calling update_and_render.
+  bool is_scrubbing;
+  // The frame after a step back already matches the shadow; don't record it
+  bool skip_next_capture;
+
+  u8 *region;
+  u64 region_size; // Multiple of 8
+  u8 *shadow;      // Region as of the newest entry
+
+  u8 *ring;
+  u64 ring_capacity;
+  u64 write_pos;
+
+  u8 *scratch; // One frame's encoding before it goes into the ring
+  u64 scratch_capacity;
+
+  RewindEntry *entries; // Oldest at entry_head
+  u32 entry_capacity;
+  u32 entry_head;
+  u32 entry_count;
+  u64 bytes_used;
+
+  DirtyPageTracker *tracker;
+  i32 dirty_channel;
+
+  De100MemoryBlock storage;
+
+  // Stats
+  u64 last_delta_size;
+  u64 frames_captured;
+  u64 frames_dropped_too_big;
+} RewindBuffer;
+
+/**
+ * @param region       Memory to track (usually permanent storage)
+ * @param region_size  Bytes of it to track
+ * @param budget       Ring bytes. Total cost is budget + region_size (shadow)
+ *                     + budget / 4 (encode scratch).
+ * @param tracker      Dirty page tracker covering `region` (may be NULL)
+ */
+bool rewind_init(RewindBuffer *rewind, void *region, u64 region_size,
+                 u64 budget, DirtyPageTracker *tracker);
+
+void rewind_shutdown(RewindBuffer *rewind);
+
+/**
+ * Record the region's current state as a new frame.
+ *
+ * @param active_size  Committed bytes of the tracker's range (harvests must
+ *                     always cover all of it; see dirty_pages_harvest)
+ */
+void rewind_capture(RewindBuffer *rewind, u32 frame_index, u64 active_size);
+
+/** Undo the newest frame. Returns false when there is nothing left. */
+bool rewind_step_back(RewindBuffer *rewind, u64 active_size);
+
+/** Drop all history (e.g. after a replay restore rewrote memory). */
+void rewind_reset(RewindBuffer *rewind);
+
+void rewind_set_scrubbing(RewindBuffer *rewind, bool is_scrubbing);
+
+#if DE100_INTERNAL
+/**
+ * Capture thousands of uneven frames into a small ring (wrapping it many
+ * times over), then step all the way back, checking every restored frame.
+ */
+bool rewind_self_test(void);
+#endif
+
+static inline u32 rewind_frame_count(const RewindBuffer *rewind) {
+  return rewind->entry_count;
+}
+
+#endif // DE100_PLATFORMS__COMMON_REWIND_H
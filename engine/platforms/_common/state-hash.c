@@ -0,0 +1,127 @@
+#include "./state-hash.h"
+#include "../../_common/hash.h"
+
+#include <stdio.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTERNAL HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define STATE_HASH_SEED 0x44453130304853ull // "DE100HS"
+
+de100_file_scoped_fn inline u64 block_term(u64 block_hash, u64 block_index) {
+  return de100_hash64_mix(block_hash ^ (block_index * 0x9E3779B97F4A7C15ull));
+}
+
+/** Rehash blocks [first, last] and swap their terms in `combined`. */
+de100_file_scoped_fn void rehash_blocks(StateHash *hash, u64 first,
+                                        u64 last) {
+  for (u64 block = first; block <= last; ++block) {
+    u64 offset = block * STATE_HASH_BLOCK_SIZE;
+    u64 bytes = hash->region_size - offset < STATE_HASH_BLOCK_SIZE
+                    ? hash->region_size - offset
+                    : STATE_HASH_BLOCK_SIZE;
+
+    u64 block_hash =
+        de100_hash64(hash->region + offset, (size_t)bytes, STATE_HASH_SEED);
+    if (block_hash != hash->block_hashes[block]) {
+      hash->combined ^= block_term(hash->block_hashes[block], block);
+      hash->combined ^= block_term(block_hash, block);
+      hash->block_hashes[block] = block_hash;
+    }
+    hash->last_rehashed_bytes += bytes;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INIT / SHUTDOWN
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool state_hash_init(StateHash *hash, const void *region, u64 region_size,
+                     DirtyPageTracker *tracker) {
+  *hash = (StateHash){0};
+  hash->dirty_channel = DIRTY_PAGES_NO_CHANNEL;
+
+  if (!region || region_size == 0) {
+    return false;
+  }
+
+  u64 block_count =
+      (region_size + STATE_HASH_BLOCK_SIZE - 1) / STATE_HASH_BLOCK_SIZE;
+  hash->storage = de100_memory_alloc(NULL, (size_t)(block_count * sizeof(u64)),
+                                     De100_MEMORY_FLAG_RW_ZEROED);
+  if (!de100_memory_is_valid(hash->storage)) {
+    fprintf(stderr, "⚠️  State hash: failed to allocate block table: %s\n",
+            de100_memory_error_str(hash->storage.error_code));
+    return false;
+  }
+
+  hash->region = (const u8 *)region;
+  hash->region_size = region_size;
+  hash->block_hashes = (u64 *)hash->storage.base;
+  hash->block_count = block_count;
+
+  // Terms of the zeroed table, so the first rehash swaps them out cleanly
+  for (u64 block = 0; block < block_count; ++block) {
+    hash->combined ^= block_term(0, block);
+  }
+
+  hash->tracker = tracker;
+  if (dirty_pages_is_active(tracker)) {
+    // Starts all-dirty: the first update hashes everything
+    hash->dirty_channel = dirty_pages_add_channel(tracker);
+  }
+
+  hash->is_enabled = true;
+  return true;
+}
+
+void state_hash_shutdown(StateHash *hash) {
+  if (!hash) {
+    return;
+  }
+  if (de100_memory_is_valid(hash->storage)) {
+    de100_memory_free(&hash->storage);
+  }
+  *hash = (StateHash){0};
+  hash->dirty_channel = DIRTY_PAGES_NO_CHANNEL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// UPDATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+u64 state_hash_update(StateHash *hash, u64 active_size) {
+  if (!hash || !hash->is_enabled) {
+    return 0;
+  }
+
+  hash->last_rehashed_bytes = 0;
+  hash->updates++;
+
+  // Harvest everything committed (see dirty_pages_harvest) but only rehash
+  // the dirty blocks inside the hashed region
+  if (hash->dirty_channel != DIRTY_PAGES_NO_CHANNEL &&
+      dirty_pages_harvest(hash->tracker, active_size)) {
+    u64 cursor = 0, offset = 0, size = 0;
+    u64 next_block = 0;
+    while (dirty_pages_next_run(hash->tracker, hash->dirty_channel,
+                                hash->region_size, &cursor, &offset, &size)) {
+      u64 first = offset / STATE_HASH_BLOCK_SIZE;
+      u64 last = (offset + size - 1) / STATE_HASH_BLOCK_SIZE;
+      if (first < next_block) {
+        first = next_block;
+      }
+      if (first <= last) {
+        rehash_blocks(hash, first, last);
+      }
+      next_block = last + 1;
+    }
+    dirty_pages_mark_synced(hash->tracker, hash->dirty_channel,
+                            hash->region_size);
+  } else {
+    rehash_blocks(hash, 0, hash->block_count - 1);
+  }
+
+  return hash->combined;
+}
@@ -0,0 +1,22 @@
+#include "./audio.h"
+
+u32 null_generate_audio(EngineState *engine) {
+  GameAudioOutputBuffer *audio = &engine->game.audio;
+  u32 update_hz = engine->game.config.audio_game_update_hz;
+  if (!audio->samples || update_hz == 0) {
+    return 0;
+  }
+
+  i32 sample_count = audio->samples_per_second / (i32)update_hz;
+  if (sample_count > audio->max_sample_count) {
+    sample_count = audio->max_sample_count;
+  }
+  if (sample_count <= 0) {
+    return 0;
+  }
+
+  audio->sample_count = sample_count;
+  engine->platform.game_main_code.functions.get_audio_samples(
+      &engine->game.memory, audio);
+  return (u32)sample_count;
+}
@@ -0,0 +1,21 @@
+#ifndef DE100_PLATFORMS_NULL_AUDIO_H
+#define DE100_PLATFORMS_NULL_AUDIO_H
+
+#include "../../_common/base.h"
+#include "../../engine.h"
+
+// ═══════════════════════════════════════════════════════════════
+// 🔇 NULL AUDIO
+// ═══════════════════════════════════════════════════════════════
+// No device: the game still fills one tick worth of samples per
+// frame (so its mixer cost is measured), and they're dropped.
+
+/**
+ * Call get_audio_samples for samples_per_second / audio_game_update_hz
+ * samples.
+ *
+ * @return Samples generated (0 if the game has no audio buffer)
+ */
+u32 null_generate_audio(EngineState *engine);
+
+#endif // DE100_PLATFORMS_NULL_AUDIO_H
@@ -0,0 +1,329 @@
+#include "../_common/backend.h"
+#include "../../engine.h"
+
+#include "../../_common/base.h"
+#include "../../_common/time.h"
+#include "../../game/base.h"
+#include "../../game/config.h"
+#include "../../game/game-loader.h"
+#include "../../game/inputs.h"
+#include "../_common/inputs-recording.h"
+#include "../_common/parallel-copy.h"
+#include "../_common/rewind.h"
+#include "./audio.h"
+#include "./batch.h"
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 🧪 NULL (HEADLESS) BACKEND
+// ═══════════════════════════════════════════════════════════════════════════
+// No window, no audio device, no frame cap. Loads the game through the same
+// engine_init / game-loader path as the other backends, then drives
+// update_and_render + get_audio_samples back to back and reports frames/sec.
+// Games exporting game_update / game_render only update (nothing is shown).
+// Meant for measuring simulation/render throughput on a bare Linux box.
+//
+// Configured through the environment (there is no window to press keys in):
+//
+//   DE100_NULL_FRAMES         Frames to run (default 10000, 0 = until SIGINT)
+//   DE100_NULL_PLAYBACK_SLOT  Replay slot to play back (recorded input,
+//                             loops like the in-game playback)
+//   DE100_NULL_SCRIPT_SEED    Scripted input: seeded pseudo-random presses on
+//                             the keyboard controller (ignored with playback)
+//   DE100_NULL_RECORD_SLOT    Record the run into a replay slot (state +
+//                             input files in the exe directory), e.g. to
+//                             build a batch corpus without a window
+//   DE100_NULL_BENCH_SNAPSHOT_COPY
+//                             Time serial vs parallel copies of game memory
+//                             (GameConfig.snapshot_copy_threads) and exit
+//   DE100_NULL_SELF_TEST      Run the engine's self tests (internal builds:
+//                             rewind ring wrap-around) and exit, 1 on failure
+//
+// Without either input source every frame gets neutral input.
+//
+// BATCH MODE (see batch.h) replays a corpus of recordings instead:
+//
+//   DE100_NULL_BATCH          Manifest of "<state> <input> [hash]" lines
+//   DE100_NULL_JOBS           Parallel workers (default: one per core)
+//   DE100_NULL_BATCH_TIMINGS  Directory for per-run frame time CSVs
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define NULL_BACKEND_DEFAULT_FRAMES 10000
+// How often the running frames/sec line is printed
+#define NULL_BACKEND_REPORT_INTERVAL_SECONDS 1.0
+
+typedef struct {
+  u64 frame_limit;
+  i32 playback_slot; // -1 = none
+  i32 record_slot;   // -1 = none
+  bool bench_snapshot_copy;
+  bool self_test;
+  bool has_script;
+  u64 script_state; // xorshift64
+  NullBatchConfig batch; // manifest_path == NULL = interactive-style run
+} NullBackendConfig;
+
+typedef struct {
+  u64 frames;
+  f64 start_seconds;
+  f64 min_frame_seconds;
+  f64 max_frame_seconds;
+  u64 audio_samples;
+
+  u64 interval_frames;
+  f64 interval_start_seconds;
+} NullBackendStats;
+
+de100_file_scoped_fn void null_handle_sigint(int signal_number) {
+  (void)signal_number;
+  is_game_running = false;
+}
+
+de100_file_scoped_fn inline u64 null_env_u64(const char *name, u64 fallback) {
+  const char *value = getenv(name);
+  if (!value || !*value) {
+    return fallback;
+  }
+  return strtoull(value, NULL, 10);
+}
+
+de100_file_scoped_fn void null_read_config(NullBackendConfig *config) {
+  config->frame_limit =
+      null_env_u64("DE100_NULL_FRAMES", NULL_BACKEND_DEFAULT_FRAMES);
+
+  const char *slot = getenv("DE100_NULL_PLAYBACK_SLOT");
+  config->playback_slot = (slot && *slot) ? atoi(slot) : -1;
+
+  const char *record_slot = getenv("DE100_NULL_RECORD_SLOT");
+  config->record_slot =
+      (record_slot && *record_slot) ? atoi(record_slot) : -1;
+
+  const char *seed = getenv("DE100_NULL_SCRIPT_SEED");
+  config->has_script = seed && *seed;
+  config->script_state = config->has_script ? strtoull(seed, NULL, 10) : 0;
+  if (config->script_state == 0) {
+    config->script_state = 0x9E3779B97F4A7C15ull; // xorshift can't hold 0
+  }
+
+  config->bench_snapshot_copy =
+      null_env_u64("DE100_NULL_BENCH_SNAPSHOT_COPY", 0) != 0;
+  config->self_test = null_env_u64("DE100_NULL_SELF_TEST", 0) != 0;
+
+  const char *manifest = getenv("DE100_NULL_BATCH");
+  config->batch.manifest_path = (manifest && *manifest) ? manifest : NULL;
+  config->batch.jobs = (u32)null_env_u64("DE100_NULL_JOBS", 0);
+  const char *timings = getenv("DE100_NULL_BATCH_TIMINGS");
+  config->batch.timings_directory = (timings && *timings) ? timings : NULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Scripted Input
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn inline u64 null_script_next(u64 *state) {
+  u64 x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+/**
+ * Deterministic "player" on the keyboard controller: each frame every
+ * button has a small chance to flip, so holds last a few dozen frames.
+ * Same seed, same input stream.
+ */
+de100_file_scoped_fn void null_script_frame(NullBackendConfig *config,
+                                            GameInput *input) {
+  GameControllerInput *keyboard =
+      &input->controllers[KEYBOARD_CONTROLLER_INDEX];
+  keyboard->is_connected = true;
+  keyboard->is_analog = false;
+
+  int button_count = (int)ArraySize(keyboard->buttons);
+  for (int i = 0; i < button_count; ++i) {
+    GameButtonState *button = &keyboard->buttons[i];
+    bool is_down = button->ended_down;
+    if ((null_script_next(&config->script_state) & 31) == 0) {
+      is_down = !is_down;
+    }
+    process_game_button_state(is_down, button);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Reporting
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void null_stats_print(const NullBackendStats *stats,
+                                           f64 now) {
+  f64 elapsed = now - stats->start_seconds;
+  f64 fps = elapsed > 0.0 ? (f64)stats->frames / elapsed : 0.0;
+
+  printf("═══════════════════════════════════════════════════════════\n");
+  printf("🧪 NULL BACKEND THROUGHPUT\n");
+  printf("═══════════════════════════════════════════════════════════\n");
+  printf("Frames:          %llu\n", (unsigned long long)stats->frames);
+  printf("Wall time:       %.3fs\n", elapsed);
+  printf("Frames/sec:      %.1f\n", fps);
+  if (stats->frames > 0) {
+    printf("Frame time:      avg %.4fms, min %.4fms, max %.4fms\n",
+           elapsed * 1000.0 / (f64)stats->frames,
+           stats->min_frame_seconds * 1000.0,
+           stats->max_frame_seconds * 1000.0);
+  }
+  printf("Audio samples:   %llu\n", (unsigned long long)stats->audio_samples);
+  printf("═══════════════════════════════════════════════════════════\n");
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Main Platform Entry Point
+// ═══════════════════════════════════════════════════════════════════════════
+
+int platform_main(void) {
+  EngineState engine = {0};
+  engine.platform.game_main_code = (GameMainCode){0};
+
+  NullBackendConfig config = {0};
+  null_read_config(&config);
+
+  // Self tests bring their own memory; no game needed
+  if (config.self_test) {
+#if DE100_INTERNAL
+    return rewind_self_test() ? 0 : 1;
+#else
+    fprintf(stderr, "❌ Self tests need an internal build\n");
+    return 1;
+#endif
+  }
+
+  if (engine_init(&engine)) {
+    return 1;
+  }
+
+  if (config.bench_snapshot_copy) {
+    parallel_copy_benchmark(engine.platform.memory_state.total_size);
+    engine_shutdown(&engine);
+    return 0;
+  }
+
+  // Nothing drains the buffer, but games may check it before writing
+  engine.game.audio.is_initialized = true;
+
+  signal(SIGINT, null_handle_sigint);
+
+  engine.platform.game_bootstrap_code.functions.init(
+      &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
+      &engine.game.backbuffer);
+
+  if (config.batch.manifest_path) {
+    int batch_status = null_batch_run(&engine, &config.batch);
+    engine_shutdown(&engine);
+    return batch_status;
+  }
+
+  if (config.playback_slot >= 0) {
+    if (!input_recording_playback_begin(
+            engine.platform.paths.exe_directory.path,
+            &engine.platform.memory_state, config.playback_slot)) {
+      fprintf(stderr, "❌ Failed to start playback from slot %d\n",
+              config.playback_slot);
+      engine_shutdown(&engine);
+      return 1;
+    }
+  }
+
+  if (config.record_slot >= 0 && config.playback_slot < 0) {
+    if (!input_recording_begin(engine.platform.paths.exe_directory.path,
+                               &engine.platform.memory_state,
+                               config.record_slot)) {
+      fprintf(stderr, "❌ Failed to start recording into slot %d\n",
+              config.record_slot);
+      engine_shutdown(&engine);
+      return 1;
+    }
+  }
+
+  printf("✅ Null platform initialized (frames: %llu, input: %s)\n",
+         (unsigned long long)config.frame_limit,
+         config.playback_slot >= 0 ? "playback"
+         : config.has_script       ? "scripted"
+                                   : "none");
+
+  NullBackendStats stats = {0};
+  stats.start_seconds = de100_get_wall_clock();
+  stats.interval_start_seconds = stats.start_seconds;
+  stats.min_frame_seconds = 1e9;
+
+  f64 frame_start = stats.start_seconds;
+  while (is_game_running &&
+         (config.frame_limit == 0 || stats.frames < config.frame_limit)) {
+    // Headless frames are updates: one each, as fast as they go
+    engine_begin_frame(&engine);
+    engine_begin_update(&engine, 0);
+
+    prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
+
+    if (input_recording_is_playing(&engine.platform.memory_state)) {
+      input_recording_playback_frame(&engine.platform.memory_state,
+                                     engine.game.inputs);
+    } else if (config.has_script) {
+      null_script_frame(&config, engine.game.inputs);
+    }
+
+    if (input_recording_is_recording(&engine.platform.memory_state)) {
+      input_recording_record_frame(&engine.platform.memory_state,
+                                   engine.game.inputs);
+    }
+
+    if (!engine_rewind_frame(&engine)) {
+      engine_update(&engine);
+    }
+
+    stats.audio_samples += null_generate_audio(&engine);
+
+    engine_swap_inputs(&engine);
+    g_frame_counter++;
+    stats.frames++;
+    stats.interval_frames++;
+
+    f64 frame_end = de100_get_wall_clock();
+    f64 frame_seconds = frame_end - frame_start;
+    if (frame_seconds < stats.min_frame_seconds) {
+      stats.min_frame_seconds = frame_seconds;
+    }
+    if (frame_seconds > stats.max_frame_seconds) {
+      stats.max_frame_seconds = frame_seconds;
+    }
+    frame_start = frame_end;
+
+    f64 interval = frame_end - stats.interval_start_seconds;
+    if (interval >= NULL_BACKEND_REPORT_INTERVAL_SECONDS) {
+      printf("[NULL] frame=%llu, %.1ff/s, %.4fms/f\n",
+             (unsigned long long)stats.frames,
+             (f64)stats.interval_frames / interval,
+             interval * 1000.0 / (f64)stats.interval_frames);
+      stats.interval_frames = 0;
+      stats.interval_start_seconds = frame_end;
+    }
+  }
+
+  null_stats_print(&stats, de100_get_wall_clock());
+
+  if (input_recording_is_recording(&engine.platform.memory_state)) {
+    input_recording_end(&engine.platform.memory_state);
+  }
+  if (input_recording_is_playing(&engine.platform.memory_state)) {
+    input_recording_playback_end(&engine.platform.memory_state);
+  }
+  engine_shutdown(&engine);
+
+  printf("Goodbye!\n");
+  return 0;
+}
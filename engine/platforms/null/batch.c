@@ -0,0 +1,383 @@
+#include "./batch.h"
+
+#include "../../_common/hash.h"
+#include "../../_common/time.h"
+#include "../../game/base.h"
+#include "../../game/inputs.h"
+#include "../../game/memory.h"
+#include "../_common/input-stream.h"
+#include "../_common/replay-buffer.h"
+#include "./audio.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Types
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  char state_path[NULL_BATCH_PATH_MAX];
+  char input_path[NULL_BATCH_PATH_MAX];
+  u64 expected_hash;
+  bool has_expected_hash;
+} NullBatchEntry;
+
+/** What a worker sends back (one write, well under PIPE_BUF). */
+typedef struct {
+  u32 run_index;
+  bool32 success;
+  u64 frames;
+  u64 state_hash;
+  f64 total_seconds;
+  f64 min_ms;
+  f64 max_ms;
+  f64 p50_ms;
+  f64 p99_ms;
+} NullBatchRunResult;
+
+typedef struct {
+  pid_t pid; // 0 = not running
+  bool32 reported;
+  NullBatchRunResult result;
+} NullBatchRunState;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Manifest
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn u32 batch_read_manifest(const char *path,
+                                             NullBatchEntry *entries,
+                                             u32 max_entries) {
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    fprintf(stderr, "❌ [BATCH] Cannot open manifest '%s': %s\n", path,
+            strerror(errno));
+    return 0;
+  }
+
+  u32 count = 0;
+  char line[2 * NULL_BATCH_PATH_MAX + 64];
+  u32 line_number = 0;
+  while (fgets(line, sizeof(line), file)) {
+    ++line_number;
+    char *comment = strchr(line, '#');
+    if (comment) {
+      *comment = '\0';
+    }
+
+    NullBatchEntry entry = {0};
+    char hash_text[32] = {0};
+    int fields = sscanf(line, "%511s %511s %31s", entry.state_path,
+                        entry.input_path, hash_text);
+    if (fields <= 0) {
+      continue; // Blank / comment-only
+    }
+    if (fields < 2) {
+      fprintf(stderr, "⚠️  [BATCH] %s:%u: expected '<state> <input>'\n",
+              path, line_number);
+      continue;
+    }
+    if (fields == 3) {
+      entry.expected_hash = strtoull(hash_text, NULL, 16);
+      entry.has_expected_hash = true;
+    }
+
+    if (count == max_entries) {
+      fprintf(stderr, "⚠️  [BATCH] Only the first %u runs are used\n",
+              max_entries);
+      break;
+    }
+    entries[count++] = entry;
+  }
+
+  fclose(file);
+  return count;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Worker
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn int batch_compare_f32(const void *a, const void *b) {
+  f32 x = *(const f32 *)a;
+  f32 y = *(const f32 *)b;
+  return (x > y) - (x < y);
+}
+
+de100_file_scoped_fn void batch_write_timings(const char *directory,
+                                              u32 run_index,
+                                              const f32 *frame_ms,
+                                              u64 frames) {
+  char path[NULL_BATCH_PATH_MAX + 32];
+  snprintf(path, sizeof(path), "%s/run_%u.csv", directory, run_index);
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    return;
+  }
+  fprintf(file, "frame,ms\n");
+  for (u64 i = 0; i < frames; ++i) {
+    fprintf(file, "%llu,%.4f\n", (unsigned long long)i, (f64)frame_ms[i]);
+  }
+  fclose(file);
+}
+
+/** Play every frame of `input` once; fills frames/timings/hash. */
+de100_file_scoped_fn bool batch_play(EngineState *engine, InputStream *input,
+                                     u64 frame_count, f32 *frame_ms,
+                                     NullBatchRunResult *result) {
+  f64 run_start = de100_get_wall_clock();
+  f64 frame_start = run_start;
+
+  u64 frame = 0;
+  for (; frame < frame_count; ++frame) {
+    engine_begin_frame(engine);
+    engine_begin_update(engine, 0);
+
+    if (!input_stream_read(input, engine->game.inputs).success) {
+      break;
+    }
+
+    engine_update(engine);
+    null_generate_audio(engine);
+
+    engine_swap_inputs(engine);
+    g_frame_counter++;
+
+    f64 frame_end = de100_get_wall_clock();
+    frame_ms[frame] = (f32)((frame_end - frame_start) * 1000.0);
+    frame_start = frame_end;
+  }
+
+  // Permanent storage only, like the determinism hash (state-hash.h):
+  // transient storage is scratch the game may leave in any state
+  result->state_hash =
+      de100_hash64(engine->game.memory.permanent_storage,
+                   (size_t)engine->game.memory.permanent_storage_size, 0);
+  result->total_seconds = frame_start - run_start;
+  result->frames = frame;
+  return frame == frame_count;
+}
+
+/**
+ * Body of a forked worker: restore the snapshot, play every input frame
+ * once, hash, report. Never returns.
+ */
+de100_file_scoped_fn void batch_worker(EngineState *engine,
+                                       const NullBatchEntry *entry,
+                                       u32 run_index, i32 result_fd,
+                                       const char *timings_directory) {
+  NullBatchRunResult result = {0};
+  result.run_index = run_index;
+
+  GameMemoryState *memory_state = &engine->platform.memory_state;
+  ReplayBufferResult load_result = replay_buffer_load_file(
+      entry->state_path, memory_state->game_memory,
+      game_memory_state_committed_size(memory_state));
+
+  InputStream input = {0};
+  InputStreamResult open_result = input_stream_open_read(
+      &input, entry->input_path, &memory_state->stream_info);
+
+  u64 frame_count = open_result.success ? input_stream_frame_count(&input) : 0;
+  f32 *frame_ms = (f32 *)malloc((frame_count ? frame_count : 1) * sizeof(f32));
+
+  if (!load_result.success) {
+    fprintf(stderr, "❌ [BATCH] Run %u: cannot load '%s': %s\n", run_index,
+            entry->state_path, replay_buffer_strerror(load_result.error_code));
+  } else if (!open_result.success) {
+    fprintf(stderr, "❌ [BATCH] Run %u: cannot open '%s': %s\n", run_index,
+            entry->input_path, input_stream_strerror(open_result.error_code));
+  } else if (frame_ms) {
+    result.success =
+        batch_play(engine, &input, frame_count, frame_ms, &result);
+
+    if (result.frames > 0) {
+      if (timings_directory) {
+        batch_write_timings(timings_directory, run_index, frame_ms,
+                            result.frames);
+      }
+      qsort(frame_ms, result.frames, sizeof(f32), batch_compare_f32);
+      result.min_ms = frame_ms[0];
+      result.max_ms = frame_ms[result.frames - 1];
+      result.p50_ms = frame_ms[result.frames / 2];
+      result.p99_ms = frame_ms[(result.frames * 99) / 100];
+    }
+  }
+
+  input_stream_close(&input);
+  free(frame_ms);
+
+  // Atomic: sizeof(result) < PIPE_BUF
+  ssize_t written = write(result_fd, &result, sizeof(result));
+  fflush(stdout);
+  fflush(stderr);
+  _exit(written == (ssize_t)sizeof(result) && result.success ? 0 : 1);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Scheduler
+// ═══════════════════════════════════════════════════════════════════════════
+
+de100_file_scoped_fn void batch_drain_results(i32 result_fd,
+                                              NullBatchRunState *runs,
+                                              u32 run_count) {
+  NullBatchRunResult result;
+  while (read(result_fd, &result, sizeof(result)) == (ssize_t)sizeof(result)) {
+    if (result.run_index < run_count) {
+      runs[result.run_index].result = result;
+      runs[result.run_index].reported = true;
+    }
+  }
+}
+
+de100_file_scoped_fn void batch_print_run(const NullBatchEntry *entry,
+                                          const NullBatchRunState *run,
+                                          u32 run_index, bool hash_matches) {
+  const NullBatchRunResult *r = &run->result;
+  if (!run->reported || !r->success) {
+    printf("[BATCH] #%-3u ❌ FAILED       %s\n", run_index, entry->input_path);
+    return;
+  }
+
+  f64 fps = r->total_seconds > 0.0 ? (f64)r->frames / r->total_seconds : 0.0;
+  printf("[BATCH] #%-3u %s %6llu frames %9.1ff/s  ms p50 %.3f p99 %.3f max "
+         "%.3f  hash %016llx  %s\n",
+         run_index, hash_matches ? "✅" : "❌ HASH",
+         (unsigned long long)r->frames, fps, r->p50_ms, r->p99_ms, r->max_ms,
+         (unsigned long long)r->state_hash, entry->input_path);
+  if (!hash_matches) {
+    printf("[BATCH]      expected %016llx\n",
+           (unsigned long long)entry->expected_hash);
+  }
+}
+
+int null_batch_run(EngineState *engine, const NullBatchConfig *config) {
+  NullBatchEntry *entries =
+      (NullBatchEntry *)calloc(NULL_BATCH_MAX_RUNS, sizeof(NullBatchEntry));
+  NullBatchRunState *runs =
+      (NullBatchRunState *)calloc(NULL_BATCH_MAX_RUNS, sizeof(*runs));
+  if (!entries || !runs) {
+    free(entries);
+    free(runs);
+    return 1;
+  }
+
+  u32 run_count =
+      batch_read_manifest(config->manifest_path, entries, NULL_BATCH_MAX_RUNS);
+  if (run_count == 0) {
+    fprintf(stderr, "❌ [BATCH] No runs in '%s'\n", config->manifest_path);
+    free(entries);
+    free(runs);
+    return 1;
+  }
+
+  u32 jobs = config->jobs;
+  if (jobs == 0) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    jobs = cores > 0 ? (u32)cores : 1;
+  }
+  if (jobs > run_count) {
+    jobs = run_count;
+  }
+
+  // Workers write their result here; the parent drains it without blocking
+  int result_pipe[2];
+  if (pipe(result_pipe) != 0) {
+    fprintf(stderr, "❌ [BATCH] pipe failed: %s\n", strerror(errno));
+    free(entries);
+    free(runs);
+    return 1;
+  }
+  fcntl(result_pipe[0], F_SETFL, fcntl(result_pipe[0], F_GETFL) | O_NONBLOCK);
+
+  printf("[BATCH] %u runs from '%s', %u workers\n", run_count,
+         config->manifest_path, jobs);
+
+  f64 batch_start = de100_get_wall_clock();
+  u32 next_run = 0;
+  u32 active = 0;
+
+  while (next_run < run_count || active > 0) {
+    if (next_run < run_count && active < jobs) {
+      // Don't let the child inherit (and re-flush) buffered output
+      fflush(stdout);
+      fflush(stderr);
+
+      pid_t pid = fork();
+      if (pid == 0) {
+        close(result_pipe[0]);
+        batch_worker(engine, &entries[next_run], next_run, result_pipe[1],
+                     config->timings_directory);
+      }
+      if (pid < 0) {
+        // Reported as failed (no result ever arrives)
+        fprintf(stderr, "❌ [BATCH] fork failed for run %u: %s\n", next_run,
+                strerror(errno));
+        ++next_run;
+        continue;
+      }
+      runs[next_run].pid = pid;
+      ++next_run;
+      ++active;
+      continue;
+    }
+
+    int status = 0;
+    pid_t done = waitpid(-1, &status, 0);
+    if (done < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (u32 i = 0; i < next_run; ++i) {
+      if (runs[i].pid == done) {
+        runs[i].pid = 0;
+        --active;
+        break;
+      }
+    }
+    batch_drain_results(result_pipe[0], runs, run_count);
+  }
+
+  batch_drain_results(result_pipe[0], runs, run_count);
+  close(result_pipe[0]);
+  close(result_pipe[1]);
+  f64 batch_seconds = de100_get_wall_clock() - batch_start;
+
+  // ─────────────────────────────────────────────────────────────────────
+  // Report (manifest order)
+  // ─────────────────────────────────────────────────────────────────────
+
+  u32 failed = 0;
+  u64 total_frames = 0;
+  for (u32 i = 0; i < run_count; ++i) {
+    const NullBatchRunResult *r = &runs[i].result;
+    bool ok = runs[i].reported && r->success;
+    bool hash_matches = !ok || !entries[i].has_expected_hash ||
+                        entries[i].expected_hash == r->state_hash;
+    batch_print_run(&entries[i], &runs[i], i, hash_matches);
+    if (!ok || !hash_matches) {
+      ++failed;
+    }
+    total_frames += ok ? r->frames : 0;
+  }
+
+  printf("═══════════════════════════════════════════════════════════\n");
+  printf("📦 BATCH REPLAY: %u/%u passed, %llu frames in %.3fs (%.1f f/s "
+         "aggregate)\n",
+         run_count - failed, run_count, (unsigned long long)total_frames,
+         batch_seconds,
+         batch_seconds > 0.0 ? (f64)total_frames / batch_seconds : 0.0);
+  printf("═══════════════════════════════════════════════════════════\n");
+
+  free(entries);
+  free(runs);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+#ifndef DE100_PLATFORMS_NULL_BATCH_H
+#define DE100_PLATFORMS_NULL_BATCH_H
+
+#include "../../_common/base.h"
+#include "../../engine.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 📦 BATCH REPLAY RUNNER
+// ═══════════════════════════════════════════════════════════════════════════
+// Replays a corpus of recorded sessions (starting snapshot + input file)
+// headless and in parallel, one fork()ed worker per run. Every worker gets a
+// copy-on-write image of the initialized engine, so each run has its own
+// GameMemory without re-loading the game.
+//
+// MANIFEST (one run per line, '#' starts a comment):
+//
+//   <state file> <input file> [expected hash, hex]
+//
+//   state file  A slot file copied out of the exe directory
+//               (loop_edit_N_state.hmi, mapped or compressed)
+//   input file  The matching loop_edit_N_input.hmi (an input stream,
+//               see input-stream.h)
+//
+// Slots can come from any backend; headless, DE100_NULL_RECORD_SLOT with
+// DE100_NULL_SCRIPT_SEED records a scripted run into one.
+//
+// Each run plays its input file once, start to end, then hashes permanent
+// storage (transient storage is scratch, as for the determinism hash). A run
+// whose hash differs from the expected one fails, so the corpus doubles as a
+// regression suite.
+//
+// The expected hash is whatever a trusted build printed for that run: leave
+// it out, run the batch, and copy each result line's "hash" column into the
+// manifest. It changes whenever the game's simulation (or permanent storage
+// layout) changes on purpose; re-baseline the manifest then.
+//
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define NULL_BATCH_MAX_RUNS 1024
+#define NULL_BATCH_PATH_MAX 512
+
+typedef struct {
+  const char *manifest_path;
+  u32 jobs; // Concurrent workers, 0 = one per online core
+  // Per-frame timings go to "<dir>/run_<index>.csv" (NULL = don't write)
+  const char *timings_directory;
+} NullBatchConfig;
+
+/**
+ * Run every entry of the manifest and print one result line per run plus a
+ * summary.
+ *
+ * @param engine  Initialized engine (game bootstrapped); workers fork from it
+ * @return        0 when every run finished (and matched its expected hash)
+ */
+int null_batch_run(EngineState *engine, const NullBatchConfig *config);
+
+#endif // DE100_PLATFORMS_NULL_BATCH_H
@@ -0,0 +1,16 @@
+#include "../../_common/hooks/utils.h"
+#include "../../../game/base.h"
+
+// Headless frames run as fast as they go, so the game sees simulated time
+// (frames at the target rate) instead of the wall clock. That keeps batch
+// runs of the same inputs identical however fast the machine is.
+
+void de100_set_target_fps(u32 fps) { g_fps = fps; }
+
+f32 de100_get_frame_time(void) { return g_fps ? 1.0f / (f32)g_fps : 0.0f; }
+
+f64 de100_get_time(void) {
+  return g_fps ? (f64)g_frame_counter / (f64)g_fps : 0.0;
+}
+
+u32 de100_get_fps(void) { return g_fps; }
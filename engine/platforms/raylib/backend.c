@@ -6,6 +6,8 @@
 #include "../../game/game-loader.h"
 #include "../../game/inputs.h"
 #include "../_common/adaptive-fps.h"
+#include "../_common/frame-stats.h"
+#include "../_common/hooks/utils.h"
 #include "../_common/inputs-recording.h"
 #include "./audio.h"
 #include "./hooks/inputs/joystick.h"
@@ -17,10 +19,6 @@
 #include <stdint.h>
 #include <stdio.h>
 
-#if DE100_INTERNAL
-#include "../_common/frame-stats.h"
-#endif
-
 // ═══════════════════════════════════════════════════════════════════════════
 // State
 // ═══════════════════════════════════════════════════════════════════════════
@@ -139,7 +137,7 @@ de100_file_scoped_fn inline int raylib_init(EngineState *engine) {
              engine->game.config.window_title);
   SetWindowState(FLAG_WINDOW_RESIZABLE);
   SetExitKey(KEY_NULL);
-  SetTargetFPS(engine->game.config.target_refresh_rate_hz);
+  de100_set_target_fps(engine->game.config.target_refresh_rate_hz);
 
   printf("✅ Window created\n");
 
@@ -185,7 +183,28 @@ int platform_main(void) {
 
   printf("✅ Entering main loop...\n");
 
+  // raylib sleeps inside EndDrawing, so playback speed changes its target.
+  // EndDrawing also polls input, so every frame is still presented.
+  // Realtime frames go back to g_fps, the rate de100_set_target_fps last
+  // applied (adaptive FPS included); speed modes bypass the hook.
+  i32 paced_fps = (i32)g_fps;
+
   while (!WindowShouldClose() && is_game_running) {
+    PlaybackPacing pacing = engine_pace_frame(&engine);
+    i32 pacing_fps =
+        pacing.target_seconds_per_frame ==
+                engine.game.config.target_seconds_per_frame
+            ? (i32)g_fps
+        : pacing.target_seconds_per_frame > 0.0f
+            ? (i32)(1.0f / pacing.target_seconds_per_frame + 0.5f)
+            : 0;
+    if (pacing_fps != paced_fps) {
+      SetTargetFPS(pacing_fps);
+      paced_fps = pacing_fps;
+    }
+
+    engine_begin_frame(&engine);
+
     handle_game_reload_check(&engine.platform.game_main_code,
                              &engine.platform.paths);
     prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
@@ -195,24 +214,42 @@ int platform_main(void) {
     //                      GetScreenHeight());
     // }
 
+#if DE100_INTERNAL
+    // Engine debug keys
+    if (IsKeyPressed(KEY_F9)) {
+      engine_toggle_profiler_trace(&engine.platform);
+    }
+#endif
     handle_keyboard_inputs(&engine.platform, &engine.game);
     raylib_poll_gamepad(engine.game.inputs);
     raylib_poll_mouse(engine.game.inputs);
 
-    if (input_recording_is_recording(&engine.platform.memory_state)) {
-      input_recording_record_frame(&engine.platform.memory_state,
-                                   engine.game.inputs);
+    // While scrubbing (or holding a stepped playback frame, or between
+    // fixed updates) nothing updates: split games redraw the held state
+    // below, fused games leave the last rendered frame on screen
+    if (!engine_rewind_frame(&engine)) {
+      for (u32 update = 0; update < pacing.update_count; ++update) {
+        engine_begin_update(&engine, update);
+
+        if (input_recording_is_recording(&engine.platform.memory_state)) {
+          input_recording_record_frame(&engine.platform.memory_state,
+                                       engine.game.inputs);
+        }
+
+        if (input_recording_is_playing(&engine.platform.memory_state)) {
+          input_recording_playback_frame(&engine.platform.memory_state,
+                                         engine.game.inputs);
+        }
+
+        engine_update(&engine);
+      }
     }
 
-    if (input_recording_is_playing(&engine.platform.memory_state)) {
-      input_recording_playback_frame(&engine.platform.memory_state,
-                                     engine.game.inputs);
+    // Split games draw once per shown frame, between updates included
+    if (pacing.present) {
+      engine_render(&engine);
     }
 
-    engine.platform.game_main_code.functions.update_and_render(
-        &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
-        &engine.game.backbuffer);
-
     audio_generate_and_send(&engine.game, &engine.platform.game_main_code);
 
     BeginDrawing();
@@ -224,16 +261,18 @@ int platform_main(void) {
     f32 target_frame_time_ms =
         engine.game.config.target_seconds_per_frame * 1000.0f;
 
-    if (frame_time_ms > (target_frame_time_ms + 5.0f)) {
+    if (pacing.is_realtime &&
+        frame_time_ms > (target_frame_time_ms + 5.0f)) {
       printf("⚠️  MISSED FRAME! %.2fms (target: %.2fms, over by: %.2fms)\n",
              frame_time_ms, target_frame_time_ms,
              frame_time_ms - target_frame_time_ms);
     }
 
-#if DE100_INTERNAL
-    frame_stats_record(frame_time_ms,
-                       engine.game.config.target_seconds_per_frame);
-#endif
+    // Raylib waits inside EndDrawing(): no work / sleep split
+    if (pacing.is_realtime) {
+      frame_stats_record(frame_time_ms, -1.0f, -1.0f,
+                         engine.game.config.target_seconds_per_frame);
+    }
 
     g_frame_counter++;
 
@@ -244,8 +283,9 @@ int platform_main(void) {
     }
 #endif
 
-    if (engine.game.config.prefer_adaptive_fps) {
+    if (engine.game.config.prefer_adaptive_fps && pacing.is_realtime) {
       adaptive_fps_update(&engine.game.config, frame_time_ms);
+      paced_fps = (i32)g_fps; // Applied through the hook if it changed
     }
 
     engine_swap_inputs(&engine);
@@ -278,9 +318,7 @@ int platform_main(void) {
   printf("[%.3fs] Memory freed\n",
          de100_get_wall_clock() - g_initial_game_time_ms);
 
-#if DE100_INTERNAL
   frame_stats_print();
-#endif
 
   printf("Goodbye!\n");
   return 0;
@@ -9,6 +9,7 @@
 #include "../../game/inputs.h"
 #include "../_common/adaptive-fps.h"
 #include "../_common/config.h"
+#include "../_common/frame-stats.h"
 #include "../_common/frame-timing.h"
 #include "../_common/inputs-recording.h"
 #include "./audio.h"
@@ -22,7 +23,9 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/extensions/Xrandr.h>
+#include <X11/keysym.h>
 #include <linux/joystick.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -30,9 +33,6 @@
 #include <string.h>
 #include <unistd.h>
 
-#if DE100_INTERNAL
-#include "../_common/frame-stats.h"
-#endif
 
 typedef struct {
   Display *display;
@@ -143,6 +143,7 @@ opengl_display_buffer(GameBackBuffer *backbuffer, int window_width,
   // int offset_x = 10;
   // int offset_y = 10;
 
+  TIMED_FUNCTION();
   glClear(GL_COLOR_BUFFER_BIT);
 
   glBindTexture(GL_TEXTURE_2D, g_gl.texture_id);
@@ -174,6 +175,189 @@ de100_file_scoped_fn inline void opengl_cleanup(void) {
 }
 #endif
 
+// ═══════════════════════════════════════════════════════════════════════════
+// Pipelined Present (GameConfig.prefer_pipelined_present)
+// ═══════════════════════════════════════════════════════════════════════════
+// A render thread owns the GL context and does the texture upload, the swap
+// and XSync. The game thread hands it a finished backbuffer and carries on
+// in the other one:
+//
+//   game thread:   [update+render N][submit][update+render N+1][submit]
+//   render thread:                          [upload+swap N    ]
+//
+// submit is the fence: it waits until the previous frame is fully presented,
+// since that frame's memory becomes the game's next canvas. Both threads use
+// Xlib, so XInitThreads() runs before XOpenDisplay.
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+  bool is_enabled;
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+
+  // Guarded by mutex
+  GameBackBuffer frame; // Handed over; owned by the render thread until
+                        // has_frame clears
+  bool has_frame;
+  int window_width;
+  int window_height;
+  bool quit;
+  u64 frames_presented;
+
+  // Game thread only
+  De100MemoryBlock second_block; // The engine owns the first one
+  De100MemoryBlock spare_block;  // The game's canvas after the next submit
+  u64 fence_waits;               // Submits that waited on the previous frame
+  bool has_submitted;            // spare_block holds a real frame
+} X11PresentPipeline;
+
+de100_file_scoped_global_var X11PresentPipeline g_present = {0};
+
+de100_file_scoped_fn void *present_thread_main(void *arg) {
+  (void)arg;
+  glXMakeCurrent(g_gl.display, g_gl.window, g_gl.gl_context);
+  int projection_width = g_gl.width;
+  int projection_height = g_gl.height;
+
+  pthread_mutex_lock(&g_present.mutex);
+  for (;;) {
+    while (!g_present.has_frame && !g_present.quit) {
+      pthread_cond_wait(&g_present.cond, &g_present.mutex);
+    }
+    if (!g_present.has_frame) {
+      break; // Quit, nothing left to show
+    }
+    GameBackBuffer frame = g_present.frame;
+    int window_width = g_present.window_width;
+    int window_height = g_present.window_height;
+    pthread_mutex_unlock(&g_present.mutex);
+
+    // Resizes arrive with the frame (the game thread can't touch GL)
+    if (window_width != projection_width ||
+        window_height != projection_height) {
+      opengl_update_projection(window_width, window_height);
+      projection_width = window_width;
+      projection_height = window_height;
+    }
+    opengl_display_buffer(&frame, window_width, window_height);
+    {
+      TIMED_BLOCK("XSync");
+      XSync(g_gl.display, False);
+    }
+
+    pthread_mutex_lock(&g_present.mutex);
+    g_present.has_frame = false;
+    g_present.frames_presented++;
+    pthread_cond_signal(&g_present.cond);
+  }
+  pthread_mutex_unlock(&g_present.mutex);
+
+  glXMakeCurrent(g_gl.display, None, NULL);
+  return NULL;
+}
+
+de100_file_scoped_fn bool
+x11_present_pipeline_start(const GameBackBuffer *backbuffer) {
+  g_present.second_block = de100_memory_alloc(
+      NULL, backbuffer->memory.size,
+      De100_MEMORY_FLAG_RW_ZEROED | De100_MEMORY_FLAG_LARGE_PAGES);
+  if (!de100_memory_is_valid(g_present.second_block)) {
+    return false;
+  }
+  g_present.spare_block = g_present.second_block;
+
+  pthread_mutex_init(&g_present.mutex, NULL);
+  pthread_cond_init(&g_present.cond, NULL);
+
+  // A GL context is current on one thread at a time: hand it over
+  glXMakeCurrent(g_gl.display, None, NULL);
+  if (pthread_create(&g_present.thread, NULL, present_thread_main, NULL) !=
+      0) {
+    glXMakeCurrent(g_gl.display, g_gl.window, g_gl.gl_context);
+    pthread_cond_destroy(&g_present.cond);
+    pthread_mutex_destroy(&g_present.mutex);
+    de100_memory_free(&g_present.second_block);
+    return false;
+  }
+
+  g_present.is_enabled = true;
+  return true;
+}
+
+/**
+ * Hand the finished backbuffer to the render thread and point `backbuffer`
+ * at the other block (whose frame is done presenting once this returns).
+ */
+de100_file_scoped_fn void x11_present_pipeline_submit(GameBackBuffer *backbuffer,
+                                                      int window_width,
+                                                      int window_height) {
+  TIMED_FUNCTION();
+  pthread_mutex_lock(&g_present.mutex);
+  if (g_present.has_frame) {
+    g_present.fence_waits++;
+    while (g_present.has_frame) {
+      pthread_cond_wait(&g_present.cond, &g_present.mutex);
+    }
+  }
+  g_present.frame = *backbuffer;
+  g_present.window_width = window_width;
+  g_present.window_height = window_height;
+  g_present.has_frame = true;
+  pthread_cond_signal(&g_present.cond);
+  pthread_mutex_unlock(&g_present.mutex);
+
+  De100MemoryBlock next_canvas = g_present.spare_block;
+  g_present.spare_block = backbuffer->memory;
+  backbuffer->memory = next_canvas;
+  g_present.has_submitted = true;
+}
+
+/**
+ * Copy the last submitted frame into the current canvas, for frames that
+ * present without drawing (the canvas still holds the frame before it).
+ * The render thread only reads that frame, so no need to wait on it.
+ */
+de100_file_scoped_fn void
+x11_present_pipeline_restore_canvas(GameBackBuffer *backbuffer) {
+  if (!g_present.has_submitted) {
+    return;
+  }
+  TIMED_FUNCTION();
+  de100_mem_copy(backbuffer->memory.base, g_present.spare_block.base,
+                 (size_t)backbuffer->memory.size);
+}
+
+/** Present what's pending, join, and give the engine its own block back. */
+de100_file_scoped_fn void
+x11_present_pipeline_stop(GameBackBuffer *backbuffer) {
+  if (!g_present.is_enabled) {
+    return;
+  }
+
+  pthread_mutex_lock(&g_present.mutex);
+  g_present.quit = true;
+  pthread_cond_signal(&g_present.cond);
+  pthread_mutex_unlock(&g_present.mutex);
+  pthread_join(g_present.thread, NULL);
+
+  pthread_cond_destroy(&g_present.cond);
+  pthread_mutex_destroy(&g_present.mutex);
+  glXMakeCurrent(g_gl.display, g_gl.window, g_gl.gl_context);
+
+  if (backbuffer->memory.base == g_present.second_block.base) {
+    backbuffer->memory = g_present.spare_block;
+  }
+  de100_memory_free(&g_present.second_block);
+  g_present.is_enabled = false;
+
+#if DE100_INTERNAL
+  printf("[PRESENT] %llu frames presented, game waited on %llu\n",
+         (unsigned long long)g_present.frames_presented,
+         (unsigned long long)g_present.fence_waits);
+#endif
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // X11 Functions
 // ═══════════════════════════════════════════════════════════════════════════
@@ -194,8 +378,11 @@ de100_file_scoped_fn inline void x11_handle_event(Display *display,
       g_last_window_width = new_width;
       g_last_window_height = new_height;
 
-      // Update OpenGL projection to match new window size
-      opengl_update_projection(new_width, new_height);
+      // Update OpenGL projection to match new window size (pipelined: the
+      // render thread does, with the next frame)
+      if (!g_present.is_enabled) {
+        opengl_update_projection(new_width, new_height);
+      }
     }
     break;
   }
@@ -211,7 +398,9 @@ de100_file_scoped_fn inline void x11_handle_event(Display *display,
 
   // In Expose handler:
   case Expose: {
-    if (event->xexpose.count != 0)
+    // Pipelined, the next frame repaints (the game is drawing into the
+    // other buffer right now)
+    if (event->xexpose.count != 0 || g_present.is_enabled)
       break;
     printf("Repainting window\n");
     opengl_display_buffer(&game->backbuffer, g_last_window_width,
@@ -239,6 +428,13 @@ de100_file_scoped_fn inline void x11_handle_event(Display *display,
   }
 
   case KeyPress: {
+#if DE100_INTERNAL
+    // Engine debug keys come before the game's bindings
+    if (XLookupKeysym(&event->xkey, 0) == XK_F9) {
+      engine_toggle_profiler_trace(platform);
+      break;
+    }
+#endif
     handleEventKeyPress(event, game, platform);
     break;
   }
@@ -266,6 +462,7 @@ de100_file_scoped_fn inline void x11_handle_event(Display *display,
 de100_file_scoped_fn inline void
 x11_process_pending_events(Display *display, EnginePlatformState *platform,
                            EngineGameState *game) {
+  TIMED_FUNCTION();
   XEvent event;
   while (XPending(display) > 0) {
     XNextEvent(display, &event);
@@ -280,6 +477,7 @@ x11_process_pending_events(Display *display, EnginePlatformState *platform,
 de100_file_scoped_fn inline void
 audio_generate_and_send(LinuxAudioConfig *audio_config, EngineGameState *game,
                         GameMainCode *game_main_code) {
+  TIMED_FUNCTION();
   u32 samples_to_generate =
       linux_get_samples_to_write(audio_config, &game->audio);
 
@@ -317,6 +515,11 @@ de100_file_scoped_fn inline int x11_init(EngineState *engine) {
   }
   engine->platform.backend = x11;
 
+  // Must precede every other Xlib call
+  if (engine->game.config.prefer_pipelined_present) {
+    XInitThreads();
+  }
+
   x11->display = XOpenDisplay(NULL);
   if (!x11->display) {
     fprintf(stderr, "❌ Cannot connect to X server\n");
@@ -382,12 +585,21 @@ de100_file_scoped_fn inline int x11_init(EngineState *engine) {
   linux_init_joystick(engine->platform.old_inputs->controllers,
                       engine->game.inputs->controllers);
 
+  if (engine->game.config.prefer_pipelined_present) {
+    if (x11_present_pipeline_start(&engine->game.backbuffer)) {
+      printf("✅ Pipelined present: render thread started\n");
+    } else {
+      fprintf(stderr, "⚠️  Pipelined present unavailable, presenting on the "
+                      "game thread\n");
+    }
+  }
+
   printf("✅ X11 platform initialized\n");
 
   adaptive_fps_init();
+  frame_stats_init();
 
 #if DE100_INTERNAL
-  frame_stats_init();
 
   printf("═══════════════════════════════════════════════════════════\n");
   printf("🎮 ADAPTIVE FRAME RATE CONTROL\n");
@@ -457,31 +669,62 @@ int platform_main(void) {
     }
 #endif
 
+    // Playback speed: held / unpresented / unslept frames (realtime
+    // outside of input playback)
+    PlaybackPacing pacing = engine_pace_frame(&engine);
+
     frame_timing_begin();
+    engine_begin_frame(&engine);
 
-    handle_game_reload_check(&engine.platform.game_main_code,
-                             &engine.platform.paths);
+    {
+      TIMED_BLOCK("reload check");
+      handle_game_reload_check(&engine.platform.game_main_code,
+                               &engine.platform.paths);
+    }
 
-    prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
-    x11_poll_mouse(x11->display, x11->window, engine.game.inputs);
-    ;
-    linux_poll_joystick(engine.game.inputs);
+    {
+      TIMED_BLOCK("input poll");
+      prepare_input_frame(engine.platform.old_inputs, engine.game.inputs);
+      x11_poll_mouse(x11->display, x11->window, engine.game.inputs);
+      linux_poll_joystick(engine.game.inputs);
+    }
 
-    // Input recording/playback: record after getting real inputs, playback
-    // overwrites it
-    if (input_recording_is_recording(&engine.platform.memory_state)) {
-      input_recording_record_frame(&engine.platform.memory_state,
-                                   engine.game.inputs);
+    // While scrubbing (or holding a stepped playback frame, or between
+    // fixed updates) nothing updates: split games redraw the held state
+    // below, fused games leave the last rendered frame on screen
+    bool did_update = false;
+    if (!engine_rewind_frame(&engine)) {
+      for (u32 update = 0; update < pacing.update_count; ++update) {
+        engine_begin_update(&engine, update);
+
+        // Input recording/playback: record after getting real inputs,
+        // playback overwrites it
+        if (input_recording_is_recording(&engine.platform.memory_state)) {
+          input_recording_record_frame(&engine.platform.memory_state,
+                                       engine.game.inputs);
+        }
+
+        if (input_recording_is_playing(&engine.platform.memory_state)) {
+          input_recording_playback_frame(&engine.platform.memory_state,
+                                         engine.game.inputs);
+        }
+
+        engine_update(&engine);
+        did_update = true;
+      }
     }
 
-    if (input_recording_is_playing(&engine.platform.memory_state)) {
-      input_recording_playback_frame(&engine.platform.memory_state,
-                                     engine.game.inputs);
+    // Split games draw once per shown frame, between updates included
+    if (pacing.present) {
+      engine_render(&engine);
     }
 
-    engine.platform.game_main_code.functions.update_and_render(
-        &engine.game.thread_context, &engine.game.memory, engine.game.inputs,
-        &engine.game.backbuffer);
+    // Under the pipeline the canvas is the block shown two frames ago: when
+    // nothing drew into it, start from the last submitted frame instead
+    if (pacing.present && g_present.is_enabled && !did_update &&
+        !game_main_code_is_split(&engine.platform.game_main_code)) {
+      x11_present_pipeline_restore_canvas(&engine.game.backbuffer);
+    }
 
     audio_generate_and_send(&x11->audio_config, &engine.game,
                             &engine.platform.game_main_code);
@@ -497,53 +740,69 @@ int platform_main(void) {
                              MAX_DEBUG_AUDIO_MARKERS, display_marker_index);
 #endif
 
-    opengl_display_buffer(&engine.game.backbuffer, g_last_window_width,
-                          g_last_window_height);
-    XSync(x11->display, False);
+    if (pacing.present && g_present.is_enabled) {
+      x11_present_pipeline_submit(&engine.game.backbuffer,
+                                  g_last_window_width, g_last_window_height);
+    } else if (pacing.present) {
+      opengl_display_buffer(&engine.game.backbuffer, g_last_window_width,
+                            g_last_window_height);
+      TIMED_BLOCK("XSync");
+      XSync(x11->display, False);
+    }
 
 #if DE100_INTERNAL
     linux_debug_capture_flip_state(&x11->audio_config);
 #endif
 
     frame_timing_mark_work_done();
-    frame_timing_sleep_until_target(
-        engine.game.config.target_seconds_per_frame);
+    if (pacing.target_seconds_per_frame > 0.0f) {
+      TIMED_BLOCK("sleep");
+      frame_timing_sleep_until_target(pacing.target_seconds_per_frame);
+    }
     frame_timing_end();
 
     f32 frame_time_ms = frame_timing_get_ms();
     f32 target_frame_time_ms =
         engine.game.config.target_seconds_per_frame * 1000.0f;
 
-    if (frame_time_ms > (target_frame_time_ms + 5.0f)) {
+    if (pacing.is_realtime &&
+        frame_time_ms > (target_frame_time_ms + 5.0f)) {
       printf("⚠️  MISSED FRAME! %.2fms (target: %.2fms, over by: %.2fms)\n",
              frame_time_ms, target_frame_time_ms,
              frame_time_ms - target_frame_time_ms);
     }
 
-#if DE100_INTERNAL
-    frame_stats_record(frame_time_ms,
-                       engine.game.config.target_seconds_per_frame);
-#endif
+    if (pacing.is_realtime) {
+      frame_stats_record(frame_time_ms, g_frame_timing.work_seconds * 1000.0f,
+                         g_frame_timing.sleep_seconds * 1000.0f,
+                         engine.game.config.target_seconds_per_frame);
+    }
 
     g_frame_counter++;
 
 #if DE100_INTERNAL
     if (FRAME_LOG_EVERY_FIVE_SECONDS_CHECK) {
       printf(
-          "[X11] %.2fms/f, %.2ff/s, %.2fmc/f (work: %.2fms, sleep: %.2fms)\n",
+          "[X11] %.2fms/f, %.2ff/s, %.2fmc/f (work: %.2fms, sleep: %.2fms, "
+          "spin: %.3fms avg, wake latency: %.3fms, late: %llu)\n",
           frame_time_ms, frame_timing_get_fps(), frame_timing_get_mcpf(),
           g_frame_timing.work_seconds * 1000.0f,
-          g_frame_timing.sleep_seconds * 1000.0f);
+          g_frame_timing.sleep_seconds * 1000.0f,
+          frame_timing_get_avg_spin_ms(),
+          g_frame_timing.wake_latency_seconds * 1000.0f,
+          (unsigned long long)g_frame_timing.late_frames);
     }
 #endif
 
-    if (engine.game.config.prefer_adaptive_fps) {
+    if (engine.game.config.prefer_adaptive_fps && pacing.is_realtime) {
       adaptive_fps_update(&engine.game.config, frame_time_ms);
     }
 
     engine_swap_inputs(&engine);
   }
 
+  x11_present_pipeline_stop(&engine.game.backbuffer);
+
   printf("[%.3fs] Exiting, freeing memory...\n",
          de100_get_wall_clock() - g_initial_game_time_ms);
 #if DE100_SANITIZE_WAVE_1_MEMORY
@@ -555,9 +814,7 @@ int platform_main(void) {
   printf("[%.3fs] Memory freed\n",
          de100_get_wall_clock() - g_initial_game_time_ms);
 
-#if DE100_INTERNAL
   frame_stats_print();
-#endif
 
   printf("Goodbye!\n");
   return 0;